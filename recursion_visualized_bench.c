@@ -0,0 +1,924 @@
+/**
+ * @file    recursion_visualized_bench.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the benchmark of the frame pipeline, and its own main() function.
+ * It is built and run by the bench target of the Makefile.
+ *
+ * For every combination of a renderer, an output and a stack depth, it fills the stack view
+ * with a stack that deep, and then plays back one push or pop per frame at the top of it, like
+ * the headless mode does, fitting the whole stack into the window. Each frame goes through the
+ * same phases as drawStack() without a backbuffer, and each phase is timed on its own:
+ *   events   polling the events with handleEvents()
+ *   clear    clearing the background
+ *   fill     drawing the stack frames with stackViewDraw(), or stackViewRaster()
+ *   labels   drawing the labels of the stack frames with stackViewDrawLabels(), or
+ *            stackViewRasterLabels(), which only
+ *            happens while the frames are tall enough to be labeled
+ *   present  presenting the frame
+ *   frame    all of the above, plus playing the step back into the stack view
+ *
+ * The combinations are:
+ *   renderer  software, or accelerated if the machine has a GPU renderer, or the SIMD software
+ *             rasterizer with each of its span-fill kernels the CPU can run: raster-avx2,
+ *             raster-sse2 and raster-scalar
+ *   output    offscreen, into an SDL_Surface for the software renderer and the rasterizer, or into
+ *             a render target texture of a hidden window for the accelerated one, where presenting
+ *             reads a pixel back so that the GPU has to finish the frame; or windowed, into a
+ *             visible window
+ *   depth     10, 100, 1000, 10^4, 10^5 and 10^6 stack frames
+ * Combinations the machine cannot do, like an accelerated renderer without a GPU, are skipped
+ * with a message on stderr. The rasterizer only draws offscreen, and has nothing to present.
+ *
+ * The results are written as CSV, one line per combination and phase:
+ *   renderer,output,depth,phase,frames,steps_per_second,p50_us,p99_us,max_us
+ * steps_per_second is the rate of the whole pipeline, the same on every line of a combination,
+ * and the latencies are percentiles over the frames, in microseconds.
+ * Every kernel of the rasterizer gets one more line per depth, with the phase speedup, which
+ * compares it with the software renderer offscreen on the same frames: steps_per_second is how
+ * many times as many steps per second it made, and p50_us, p99_us and max_us how many times
+ * shorter its frames were. The lowest speedup over the depths of each kernel is also written to
+ * stderr, against the target of RASTER_TARGET_SPEEDUP.
+ *
+ * With --memory, it checks instead that replaying a long recording takes bounded memory.
+ * It records the calls of fibonacci(25) over and over into a trace file, 242785 calls each time,
+ * and replays it through the timeline the way --replay does, with the call tree hidden and
+ * shown. Then it keeps the same calls in the history of a live run, the way a windowed live run
+ * does with a budget of MEMORY_HISTORY_BUDGET, and plays all of them back from the start of it,
+ * again with the call tree hidden and shown. It samples the resident memory of the process from
+ * /proc/self/statm as it goes.
+ * The results are written as CSV, one line per way of playing back:
+ *   path,tree,records,seconds,start_kb,tenth_kb,peak_kb,growth_kb
+ * tenth_kb is the resident memory once a tenth of the records were played back, and growth_kb
+ * how much more the peak over the rest of them was. It fails if that is more than MEMORY_SLACK_KB.
+ * The pages of the trace file mapped in by the two readers of a replay come and go by tens of
+ * megabytes, but memory that grows with the records, like a call tree of 28 bytes per call,
+ * grows by far more than that over a long recording.
+ *
+ * Command-line options:
+ *   --frames N     Time N frames for every combination. The default is 1000.
+ *   --max-depth N  Leave out the depths above N, for a quicker run.
+ *   --memory N     Check the memory of playing back N records instead.
+ *   --out F        Write the CSV into the file F instead of stdout.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for exit(), EXIT_SUCCESS, EXIT_FAILURE, malloc(), qsort()
+#include <stdio.h>   // C standard input/output - for fprintf(), fopen(), fclose()
+#include <string.h>  // C strings - for strcmp(), memset()
+#include <unistd.h>  // POSIX - for sysconf()
+
+#include "recursion_visualized_header.h"
+#include "recursion_visualized_trace.h"  // FUNCTION_BUNNY
+
+
+/* The size of the window, the same as the one of the program. */
+#define BENCH_WIDTH  300
+#define BENCH_HEIGHT 640
+
+/* The number of frames timed for every combination by default,
+   and the number of frames drawn before the timing starts, to warm up the caches. */
+#define BENCH_DEFAULT_FRAMES 1000
+#define BENCH_WARMUP_FRAMES  50
+
+/* The phases of a frame, in the order they are written out. */
+#define PHASE_EVENTS  0
+#define PHASE_CLEAR   1
+#define PHASE_FILL    2
+#define PHASE_LABELS  3
+#define PHASE_PRESENT 4
+#define PHASE_FRAME   5
+#define PHASE_COUNT   6
+
+static const char* PHASE_NAMES[PHASE_COUNT] = { "events", "clear", "fill", "labels", "present", "frame" };
+
+/* How many times as fast as the software renderer offscreen the rasterizer is meant to generate frames. */
+#define RASTER_TARGET_SPEEDUP 5.0
+
+/* The stack depths that are benchmarked. */
+static const Uint32 BENCH_DEPTHS[] = { 10, 100, 1000, 10000, 100000, 1000000 };
+#define BENCH_DEPTH_COUNT ((int) (sizeof(BENCH_DEPTHS) / sizeof(BENCH_DEPTHS[0])))
+
+
+/**
+ * One combination of a renderer and an output.
+ *
+ * @field const char* renderer - "software", "accelerated", or "raster-" and the name of a kernel.
+ *
+ * @field const char* output - "offscreen" or "windowed".
+ *
+ * @field int kernel - The RASTER_KERNEL_* constant of the span-fill kernel of the rasterizer,
+ *                     or -1 for an SDL renderer.
+ */
+typedef struct BenchTarget {
+    const char* renderer;
+    const char* output;
+    int         kernel;
+} BenchTarget;
+
+static const BenchTarget BENCH_TARGETS[] = {
+    { "software",      "offscreen", -1                   },
+    { "software",      "windowed",  -1                   },
+    { "accelerated",   "offscreen", -1                   },
+    { "accelerated",   "windowed",  -1                   },
+    { "raster-avx2",   "offscreen", RASTER_KERNEL_AVX2   },
+    { "raster-sse2",   "offscreen", RASTER_KERNEL_SSE2   },
+    { "raster-scalar", "offscreen", RASTER_KERNEL_SCALAR }
+};
+#define BENCH_TARGET_COUNT ((int) (sizeof(BENCH_TARGETS) / sizeof(BENCH_TARGETS[0])))
+
+
+/**
+ * The rate and the frame latencies of one combination at one depth, in microseconds.
+ *
+ * @field double steps_per_second - The rate of the whole pipeline.
+ *
+ * @field double p50, p99, max - The percentiles of the frame times.
+ */
+typedef struct BenchResult {
+    double steps_per_second;
+    double p50;
+    double p99;
+    double max;
+} BenchResult;
+
+
+/* The recursion whose calls the memory check plays back, over and over, and the trace file
+   they are recorded into. */
+#define MEMORY_FIBONACCI  25
+#define MEMORY_TRACE_PATH "bench_memory.rvt"
+
+/* How often the memory check samples the resident memory, in records,
+   and how much it may grow after the first tenth of the records, in kilobytes. */
+#define MEMORY_SAMPLE_INTERVAL 65536
+#define MEMORY_SLACK_KB        (128 * 1024)
+
+/* The memory the history of the memory check may keep its chunks in. */
+#define MEMORY_HISTORY_BUDGET (16 * 1024 * 1024)
+
+
+/**
+ * The calls of fibonacci(MEMORY_FIBONACCI), made without recursion, one push or pop at a time.
+ *
+ * @field Sint64 n[] - The argument of every call on the stack.
+ *
+ * @field int phase[] - How far every call on the stack got: 0 before it is pushed, 1 and 2
+ *                      before it calls n - 1 and n - 2, and 3 once it can be popped.
+ *
+ * @field Uint32 depth - The number of calls on the stack.
+ *
+ * @field Uint64 ticks - The timestamp of the last record.
+ */
+typedef struct MemoryRecords {
+    Sint64 n[MEMORY_FIBONACCI + 1];
+    int    phase[MEMORY_FIBONACCI + 1];
+    Uint32 depth;
+    Uint64 ticks;
+} MemoryRecords;
+
+
+/**
+ * The resident memory of the process over a memory check.
+ *
+ * @field long start, tenth, peak - The resident memory at the start, once a tenth of the records
+ *                                  were played back, and the most after that, in kilobytes.
+ */
+typedef struct MemorySamples {
+    long start;
+    long tenth;
+    long peak;
+} MemorySamples;
+
+
+/**
+ * This function is the comparison function for qsort(), which sorts the timings ascending.
+ */
+static int compareTicks(const void* a, const void* b)
+{
+    Uint64 x = *(const Uint64*) a;
+    Uint64 y = *(const Uint64*) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/**
+ * This function picks a percentile out of sorted timings, and converts it into microseconds.
+ *
+ * @param const Uint64* sorted - The timings, sorted ascending, in performance counter ticks.
+ *
+ * @param Uint32 count - The number of timings.
+ *
+ * @param int percent - The percentile, 0 to 100.
+ *
+ * @return double - The percentile in microseconds.
+ */
+static double percentile(const Uint64* sorted, Uint32 count, int percent)
+{
+    Uint32 index = (Uint32) (((Uint64) (count - 1) * percent + 50) / 100);
+
+    return sorted[index] * 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+
+/**
+ * This function makes the next record of the calls of fibonacci(MEMORY_FIBONACCI),
+ * starting over once they are done.
+ *
+ * @param MemoryRecords* records - Where the calls are.
+ *
+ * @param StackEvent* event - Receives the record.
+ */
+static void nextRecord(MemoryRecords* records, StackEvent* event)
+{
+    memset(event, 0, sizeof(*event));
+    event->function = FUNCTION_FIBONACCI;
+    event->ticks    = ++records->ticks;
+
+    for (;;) {
+        Uint32 top;
+
+        if (records->depth == 0) {
+            records->n[0]     = MEMORY_FIBONACCI;
+            records->phase[0] = 0;
+            records->depth    = 1;
+        }
+        top = records->depth - 1;
+
+        if (records->phase[top] == 0) {
+            event->type  = EVENT_PUSH;
+            event->color = LIME;
+            ++records->phase[top];
+            break;
+        }
+        if (records->n[top] >= 2 && records->phase[top] < 3) {
+            records->n[top + 1]     = records->n[top] - records->phase[top];
+            records->phase[top + 1] = 0;
+            ++records->phase[top];
+            ++records->depth;
+            continue;
+        }
+
+        event->type  = EVENT_POP;
+        event->color = PINK;
+        break;
+    }
+
+    event->depth   = records->depth;
+    event->args[0] = records->n[records->depth - 1];
+    event->stack   = (Uint64) records->depth * BUNNY_FRAME_BYTES;
+    if (event->type == EVENT_POP) {
+        --records->depth;
+    }
+}
+
+
+/**
+ * This function reads how much memory of the process is resident.
+ *
+ * @return long - The resident memory in kilobytes, or -1 if it cannot be read.
+ */
+static long residentKilobytes(void)
+{
+    FILE* statm = fopen("/proc/self/statm", "r");
+    long  pages = -1;
+    long  resident;
+
+    if (!statm) {
+        return -1;
+    }
+    if (fscanf(statm, "%*s %ld", &resident) == 1) {
+        pages = resident;
+    }
+    fclose(statm);
+
+    return (pages < 0) ? -1 : pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+
+/**
+ * This function samples the resident memory every MEMORY_SAMPLE_INTERVAL records.
+ *
+ * @param MemorySamples* samples - The samples so far.
+ *
+ * @param Uint64 step - How many records were played back.
+ *
+ * @param Uint64 records - How many records there are.
+ */
+static void sampleMemory(MemorySamples* samples, Uint64 step, Uint64 records)
+{
+    long resident;
+
+    if (step % MEMORY_SAMPLE_INTERVAL != 0) {
+        return;
+    }
+    resident = residentKilobytes();
+    if (samples->tenth < 0 && step >= records / 10) {
+        samples->tenth = resident;
+        samples->peak  = resident;
+    } else if (samples->tenth >= 0 && resident > samples->peak) {
+        samples->peak = resident;
+    }
+}
+
+
+/**
+ * This function writes out the results of one way of playing back in the memory check.
+ *
+ * @param const char* path - How the records were played back.
+ *
+ * @param int tree_shown - Nonzero if the call tree was played back into as well.
+ *
+ * @param Uint64 records - How many records were played back.
+ *
+ * @param Uint64 start - The performance counter at the start.
+ *
+ * @param const MemorySamples* samples - The resident memory.
+ *
+ * @param FILE* csv - Where the results are written.
+ *
+ * @return int - 0 if the memory stayed bounded, -1 if it grew by more than MEMORY_SLACK_KB.
+ */
+static int writeMemory(const char* path, int tree_shown, Uint64 records, Uint64 start,
+                       const MemorySamples* samples, FILE* csv)
+{
+    long growth = samples->peak - samples->tenth;
+
+    fprintf(csv, "%s,%s,%llu,%.2f,%ld,%ld,%ld,%ld\n", path, tree_shown ? "shown" : "hidden",
+            (unsigned long long) records,
+            (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency(),
+            samples->start, samples->tenth, samples->peak, growth);
+    fflush(csv);
+
+    if (growth > MEMORY_SLACK_KB) {
+        fprintf(stderr, "error - Playing back %s with the call tree %s grew by %ld kB\n", path,
+                tree_shown ? "shown" : "hidden", growth);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function replays the trace file of the memory check through the timeline, the way
+ * the render loop of --replay does, without drawing, and writes out how much memory it took.
+ *
+ * @param int tree_shown - Nonzero if the call tree is shown, and played back into as well.
+ *
+ * @param FILE* csv - Where the results are written.
+ *
+ * @return int - 0 on success, -1 if the replay failed or its memory grew.
+ */
+static int checkReplay(int tree_shown, FILE* csv)
+{
+    TraceReader   reader;
+    Timeline      timeline;
+    StackView     view;
+    CallTree      tree;
+    StackEvent    event;
+    MemorySamples samples;
+    Uint64        start = SDL_GetPerformanceCounter();
+    Uint64        step  = 0;
+    int           played;
+    int           failed;
+
+    samples.start = residentKilobytes();
+    samples.tenth = -1;
+    samples.peak  = -1;
+
+    if (traceReaderOpen(&reader, MEMORY_TRACE_PATH) != 0) {
+        return -1;
+    }
+    if (timelineInit(&timeline, &reader) != 0) {
+        traceReaderClose(&reader);
+        return -1;
+    }
+    failed = (stackViewInit(&view, BENCH_WIDTH, BENCH_HEIGHT, reader.max_depth) != 0);
+    if (!failed && callTreeInit(&tree, BENCH_WIDTH, BENCH_HEIGHT) != 0) {
+        stackViewDestroy(&view);
+        failed = 1;
+    }
+
+    while (!failed) {
+        played = timelineStep(&timeline, &view, tree_shown ? &tree : NULL, &event);
+        if (played < 0) {
+            failed = 1;
+        }
+        if (played <= 0 || event.type == EVENT_END) {
+            break;
+        }
+        sampleMemory(&samples, ++step, reader.count);
+    }
+
+    if (!failed) {
+        failed = (writeMemory("replay", tree_shown, step, start, &samples, csv) != 0);
+        callTreeDestroy(&tree);
+        stackViewDestroy(&view);
+    }
+    timelineDestroy(&timeline);
+    traceReaderClose(&reader);
+
+    return failed ? -1 : 0;
+}
+
+
+/**
+ * This function keeps the records of the memory check in the history of a live run, the way
+ * the render loop of a windowed live run does, then jumps back to the start of the history and
+ * plays all of it back again, without drawing, and writes out how much memory it took.
+ *
+ * @param int tree_shown - Nonzero if the call tree is shown, and played back into as well.
+ *
+ * @param Uint64 records - How many records to keep.
+ *
+ * @param FILE* csv - Where the results are written.
+ *
+ * @return int - 0 on success, -1 if the history failed or its memory grew.
+ */
+static int checkHistory(int tree_shown, Uint64 records, FILE* csv)
+{
+    MemoryRecords source;
+    History       history;
+    StackView     view;
+    CallTree      tree;
+    StackEvent    event;
+    MemorySamples samples;
+    Uint64        start = SDL_GetPerformanceCounter();
+    Uint64        step  = 0;
+    int           failed;
+
+    samples.start = residentKilobytes();
+    samples.tenth = -1;
+    samples.peak  = -1;
+
+    if (stackViewInit(&view, BENCH_WIDTH, BENCH_HEIGHT, MEMORY_FIBONACCI + 1) != 0) {
+        return -1;
+    }
+    if (callTreeInit(&tree, BENCH_WIDTH, BENCH_HEIGHT) != 0) {
+        stackViewDestroy(&view);
+        return -1;
+    }
+    historyInit(&history, MEMORY_HISTORY_BUDGET);
+
+    memset(&source, 0, sizeof(source));
+    failed = 0;
+    while (!failed && step < records) {
+        nextRecord(&source, &event);
+        failed = (historyRecord(&history, &view, tree_shown ? &tree : NULL, &event) != 0);
+        sampleMemory(&samples, ++step, records * 2);
+    }
+
+    // Everything but the chunks still in memory is read back from the temporary file.
+    if (!failed && historySeek(&history, &view, &tree, 0) != 0) {
+        failed = 1;
+    }
+    while (!failed && history.step < history.count) {
+        failed = (historyStep(&history, &view, tree_shown ? &tree : NULL, &event) < 0);
+        sampleMemory(&samples, ++step, records * 2);
+    }
+
+    if (!failed) {
+        failed = (writeMemory("history", tree_shown, step, start, &samples, csv) != 0);
+    }
+    historyDestroy(&history);
+    callTreeDestroy(&tree);
+    stackViewDestroy(&view);
+
+    return failed ? -1 : 0;
+}
+
+
+/**
+ * This function checks that playing back a long recording takes bounded memory.
+ *
+ * @param Uint64 records - How many records to play back.
+ *
+ * @param FILE* csv - Where the results are written.
+ *
+ * @return int - 0 on success, -1 if a check failed.
+ */
+static int checkMemory(Uint64 records, FILE* csv)
+{
+    MemoryRecords source;
+    TraceWriter   writer;
+    StackEvent    event;
+    Uint64        i;
+    int           failed = 0;
+
+    fprintf(csv, "path,tree,records,seconds,start_kb,tenth_kb,peak_kb,growth_kb\n");
+
+    // Record the calls into a trace file first, which is replayed twice.
+    memset(&source, 0, sizeof(source));
+    if (traceWriterOpen(&writer, MEMORY_TRACE_PATH) != 0) {
+        fprintf(stderr, "error - Creating the file %s failed\n", MEMORY_TRACE_PATH);
+        return -1;
+    }
+    for (i = 0; i < records; ++i) {
+        nextRecord(&source, &event);
+        traceWriterWrite(&writer, &event);
+    }
+    memset(&event, 0, sizeof(event));
+    event.type = EVENT_END;
+    traceWriterWrite(&writer, &event);
+    if (traceWriterClose(&writer) != 0) {
+        fprintf(stderr, "error - Writing the file %s failed\n", MEMORY_TRACE_PATH);
+        remove(MEMORY_TRACE_PATH);
+        return -1;
+    }
+
+    if (checkReplay(0, csv) != 0 || checkReplay(1, csv) != 0) {
+        failed = 1;
+    }
+    remove(MEMORY_TRACE_PATH);
+
+    if (!failed && (checkHistory(0, records, csv) != 0 || checkHistory(1, records, csv) != 0)) {
+        failed = 1;
+    }
+
+    return failed ? -1 : 0;
+}
+
+
+/**
+ * This function sets up the Visualizer for one combination of a renderer and an output.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer, which was zeroed.
+ *
+ * @param const BenchTarget* target - The combination.
+ *
+ * @return int - 0 on success, -1 if the machine cannot do this combination.
+ */
+static int openTarget(Visualizer* vis, const BenchTarget* target)
+{
+    int              accelerated = (strcmp(target->renderer, "accelerated") == 0);
+    int              windowed    = (strcmp(target->output, "windowed") == 0);
+    SDL_RendererInfo info;
+
+    // The rasterizer draws straight into the pixels of a surface in main memory, like the headless mode.
+    if (target->kernel >= 0) {
+        if (!rasterKernelSupported(target->kernel)) {
+            SDL_SetError("the CPU cannot run the %s kernel", rasterKernelName(target->kernel));
+            return -1;
+        }
+        vis->surface = SDL_CreateRGBSurfaceWithFormat(0, BENCH_WIDTH, BENCH_HEIGHT, 32,
+                                                      SDL_PIXELFORMAT_ARGB8888);
+        vis->raster  = (Raster*) malloc(sizeof(Raster));
+        if (!vis->surface || !vis->raster) {
+            return -1;
+        }
+        return rasterWrap(vis->raster, vis->surface->pixels, vis->surface->pitch, BENCH_WIDTH, BENCH_HEIGHT,
+                          target->kernel);
+    }
+
+    // The software renderer draws offscreen into a surface in main memory, like the headless mode.
+    if (!accelerated && !windowed) {
+        vis->surface = SDL_CreateRGBSurfaceWithFormat(0, BENCH_WIDTH, BENCH_HEIGHT, 32,
+                                                      SDL_PIXELFORMAT_ARGB8888);
+        if (!vis->surface) {
+            return -1;
+        }
+        vis->renderer = SDL_CreateSoftwareRenderer(vis->surface);
+        return vis->renderer ? 0 : -1;
+    }
+
+    vis->window = SDL_CreateWindow("Recursion Visualized Bench", SDL_WINDOWPOS_CENTERED,
+                                   SDL_WINDOWPOS_CENTERED, BENCH_WIDTH, BENCH_HEIGHT,
+                                   windowed ? 0 : SDL_WINDOW_HIDDEN);
+    if (!vis->window) {
+        return -1;
+    }
+    vis->renderer = SDL_CreateRenderer(vis->window, -1,
+                                       accelerated ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE);
+    if (!vis->renderer) {
+        return -1;
+    }
+
+    // SDL falls back to the software renderer when there is no GPU, which is not what was asked for.
+    if (accelerated && (SDL_GetRendererInfo(vis->renderer, &info) != 0 ||
+                        !(info.flags & SDL_RENDERER_ACCELERATED))) {
+        return -1;
+    }
+
+    // The accelerated renderer draws offscreen into a render target texture.
+    if (!windowed) {
+        vis->backbuffer = SDL_CreateTexture(vis->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                            SDL_TEXTUREACCESS_TARGET, BENCH_WIDTH, BENCH_HEIGHT);
+        if (!vis->backbuffer || SDL_SetRenderTarget(vis->renderer, vis->backbuffer) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function benchmarks one combination at one stack depth, and writes out its results.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer of the combination.
+ *
+ * @param const BenchTarget* target - The combination.
+ *
+ * @param Uint32 depth - The depth of the stack.
+ *
+ * @param Uint32 frames - How many frames to time.
+ *
+ * @param Uint64* samples[PHASE_COUNT] - Room for the timings of every phase of every frame.
+ *
+ * @param FILE* csv - Where the results are written.
+ *
+ * @param BenchResult* result - Receives the rate and the frame latencies.
+ *
+ * @return int - 0 on success, -1 if the stack view could not be allocated.
+ */
+static int benchDepth(Visualizer* vis, const BenchTarget* target, Uint32 depth, Uint32 frames,
+                      Uint64* samples[PHASE_COUNT], FILE* csv, BenchResult* result)
+{
+    int        offscreen_gpu = (vis->backbuffer != NULL);
+    SDL_Rect   corner        = { 0, 0, 1, 1 };
+    Uint64     total         = 0;
+    StackEvent event;
+    SDL_Event  e;
+    Uint32     pixel;
+    Uint32     frame;
+    int        phase;
+
+    if (stackViewInit(&vis->view, BENCH_WIDTH, BENCH_HEIGHT, depth) != 0) {
+        return -1;
+    }
+    stackViewFit(&vis->view);
+
+    // Push the whole stack, the way bunny() would.
+    memset(&event, 0, sizeof(event));
+    event.type     = EVENT_PUSH;
+    event.function = FUNCTION_BUNNY;
+    for (event.depth = 1; event.depth <= depth; ++event.depth) {
+        event.color   = LIME;
+        event.stack   = (Uint64) event.depth * BUNNY_FRAME_BYTES;
+        event.args[0] = BENCH_HEIGHT - (Sint64) event.depth * FRAME_SIZE;
+        stackViewApply(&vis->view, &event);
+    }
+    event.depth = depth;
+
+    for (frame = 0; frame < BENCH_WARMUP_FRAMES + frames; ++frame) {
+        Uint64 times[PHASE_COUNT + 1];
+
+	// Every step pops the frame on top and pushes it again, so the depth stays the same.
+        event.type  = (frame % 2 == 0) ? EVENT_POP : EVENT_PUSH;
+        event.color = (frame % 2 == 0) ? PINK : LIME;
+
+        times[0] = SDL_GetPerformanceCounter();
+        handleEvents(vis, &e);
+        stackViewApply(&vis->view, &event);
+
+        times[1] = SDL_GetPerformanceCounter();
+        if (vis->raster) {
+            rasterSetColor(vis->raster, 0, 0, 255);
+            rasterClear(vis->raster);
+        } else {
+            SDL_SetRenderDrawColor(vis->renderer, 0, 0, 255, 255);
+            SDL_RenderClear(vis->renderer);
+        }
+
+        times[2] = SDL_GetPerformanceCounter();
+        if (vis->raster) {
+            stackViewRaster(&vis->view, vis->raster);
+        } else {
+            stackViewDraw(&vis->view, vis->renderer);
+        }
+
+        times[3] = SDL_GetPerformanceCounter();
+        if (vis->raster) {
+            stackViewRasterLabels(&vis->view, vis->raster);
+        } else if (vis->labels) {
+            stackViewDrawLabels(&vis->view, vis->renderer, vis->labels);
+        }
+
+        times[4] = SDL_GetPerformanceCounter();
+        if (offscreen_gpu) {
+	    // Reading a pixel back waits until the GPU has really drawn the frame.
+            SDL_RenderReadPixels(vis->renderer, &corner, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+        } else if (!vis->raster) {
+            SDL_RenderPresent(vis->renderer);
+        }
+        times[5] = SDL_GetPerformanceCounter();
+
+        if (frame < BENCH_WARMUP_FRAMES) {
+            continue;
+        }
+        for (phase = 0; phase < PHASE_FRAME; ++phase) {
+            samples[phase][frame - BENCH_WARMUP_FRAMES] = times[phase + 1] - times[phase];
+        }
+        samples[PHASE_FRAME][frame - BENCH_WARMUP_FRAMES] = times[5] - times[0];
+        total += times[5] - times[0];
+    }
+
+    for (phase = 0; phase < PHASE_COUNT; ++phase) {
+        qsort(samples[phase], frames, sizeof(Uint64), compareTicks);
+        fprintf(csv, "%s,%s,%lu,%s,%lu,%.1f,%.2f,%.2f,%.2f\n", target->renderer, target->output,
+                (unsigned long) depth, PHASE_NAMES[phase], (unsigned long) frames,
+                (total > 0) ? (double) frames * SDL_GetPerformanceFrequency() / total : 0.0,
+                percentile(samples[phase], frames, 50), percentile(samples[phase], frames, 99),
+                percentile(samples[phase], frames, 100));
+    }
+    fflush(csv);
+
+    result->steps_per_second = (total > 0) ? (double) frames * SDL_GetPerformanceFrequency() / total : 0.0;
+    result->p50              = percentile(samples[PHASE_FRAME], frames, 50);
+    result->p99              = percentile(samples[PHASE_FRAME], frames, 99);
+    result->max              = percentile(samples[PHASE_FRAME], frames, 100);
+
+    stackViewDestroy(&vis->view);
+
+    return 0;
+}
+
+
+/**
+ * This function writes the line which compares a kernel of the rasterizer at one depth
+ * with the software renderer offscreen.
+ *
+ * @param const BenchTarget* target - The combination of the kernel.
+ *
+ * @param Uint32 depth - The depth of the stack.
+ *
+ * @param Uint32 frames - How many frames were timed.
+ *
+ * @param const BenchResult* raster - The results of the kernel.
+ *
+ * @param const BenchResult* software - The results of the software renderer offscreen.
+ *
+ * @param FILE* csv - Where the line is written.
+ *
+ * @return double - How many times as many steps per second the kernel made.
+ */
+static double writeSpeedup(const BenchTarget* target, Uint32 depth, Uint32 frames,
+                           const BenchResult* raster, const BenchResult* software, FILE* csv)
+{
+    double speedup = (software->steps_per_second > 0) ?
+                     raster->steps_per_second / software->steps_per_second : 0.0;
+
+    fprintf(csv, "%s,%s,%lu,speedup,%lu,%.2f,%.2f,%.2f,%.2f\n", target->renderer, target->output,
+            (unsigned long) depth, (unsigned long) frames, speedup,
+            (raster->p50 > 0) ? software->p50 / raster->p50 : 0.0,
+            (raster->p99 > 0) ? software->p99 / raster->p99 : 0.0,
+            (raster->max > 0) ? software->max / raster->max : 0.0);
+    fflush(csv);
+
+    return speedup;
+}
+
+
+/**
+ * The main() function is the entry point of the benchmark.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ *
+ * @param int argc - The number of command-line arguments (including the name of the executable).
+ *
+ * @param char* argv[] - An array of char*'s which point to the C-strings containing the
+ *                       command-line arguments.
+ *
+ * @return int - EXIT_SUCCESS if every combination the machine can do was benchmarked.
+ *               EXIT_FAILURE if the benchmark encountered a runtime error.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int main(int argc, char* argv[])
+{
+    Uint32      frames    = BENCH_DEFAULT_FRAMES;
+    Uint32      max_depth = BENCH_DEPTHS[BENCH_DEPTH_COUNT - 1];
+    Uint64      memory    = 0;
+    const char* out_path  = NULL;
+    FILE*       csv       = stdout;
+    Uint64*     samples[PHASE_COUNT];
+    BenchResult software[BENCH_DEPTH_COUNT];
+    int         has_software = 0;
+    int         failed       = 0;
+    int         target;
+    int         depth;
+    int         phase;
+    int         i;
+
+    /* Read the command-line options. */
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            frames = (Uint32) atol(argv[++i]);
+        } else if (strcmp(argv[i], "--max-depth") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            max_depth = (Uint32) atol(argv[++i]);
+        } else if (strcmp(argv[i], "--memory") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            memory = (Uint64) atol(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--frames n] [--max-depth n] [--memory records] [--out csv_file]\n",
+                    argv[0]);
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Initialize the SDL Video subsystem. Without a display, fall back to the dummy video driver,
+       which can still do everything but the accelerated renderer. */
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+            fprintf(stderr, "error - Initialization of SDL subsystems failed: %s\n", SDL_GetError());
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Allocate dynamic memory for the timings and check for errors. */
+    for (phase = 0; phase < PHASE_COUNT; ++phase) {
+        samples[phase] = (Uint64*) malloc(frames * sizeof(Uint64));
+        if (!samples[phase]) {
+            fprintf(stderr, "error - Allocating the timings failed\n");
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    if (out_path) {
+        csv = fopen(out_path, "w");
+        if (!csv) {
+            fprintf(stderr, "error - Creating the file %s failed\n", out_path);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+    /* The memory check takes the place of the benchmark of the frame pipeline. */
+    if (memory > 0) {
+        failed = (checkMemory(memory, csv) != 0);
+    } else {
+        fprintf(csv, "renderer,output,depth,phase,frames,steps_per_second,p50_us,p99_us,max_us\n");
+    }
+
+    for (target = 0; target < BENCH_TARGET_COUNT && memory == 0 && !failed; ++target) {
+        Visualizer vis;
+        GlyphAtlas atlas;
+        double     lowest = 0.0;
+
+        memset(&vis, 0, sizeof(vis));
+        if (openTarget(&vis, &BENCH_TARGETS[target]) != 0) {
+            fprintf(stderr, "skipped %s %s - not available on this machine: %s\n",
+                    BENCH_TARGETS[target].renderer, BENCH_TARGETS[target].output, SDL_GetError());
+            destroyVisualizer(&vis);
+            continue;
+        }
+        if (vis.renderer && glyphAtlasInit(&atlas, vis.renderer) == 0) {
+            vis.labels      = &atlas;
+            vis.show_labels = 1;
+        }
+
+        // The software renderer offscreen comes first, so every kernel of the rasterizer
+        // can be compared with it right away.
+        for (depth = 0; depth < BENCH_DEPTH_COUNT && BENCH_DEPTHS[depth] <= max_depth; ++depth) {
+            BenchResult result;
+            double      speedup;
+
+            if (benchDepth(&vis, &BENCH_TARGETS[target], BENCH_DEPTHS[depth], frames, samples, csv,
+                           &result) != 0) {
+                fprintf(stderr, "error - Allocating the stack view failed\n");
+                failed = 1;
+                break;
+            }
+            if (target == 0) {
+                software[depth] = result;
+                has_software    = 1;
+            } else if (BENCH_TARGETS[target].kernel >= 0 && has_software) {
+                speedup = writeSpeedup(&BENCH_TARGETS[target], BENCH_DEPTHS[depth], frames, &result,
+                                       &software[depth], csv);
+                if (depth == 0 || speedup < lowest) {
+                    lowest = speedup;
+                }
+            }
+        }
+        if (BENCH_TARGETS[target].kernel >= 0 && has_software && !failed) {
+            fprintf(stderr, "%s is at least %.1f times as fast as the software renderer offscreen, "
+                    "the target is %.1f times\n", BENCH_TARGETS[target].renderer, lowest, RASTER_TARGET_SPEEDUP);
+        }
+
+        destroyVisualizer(&vis);
+    }
+
+    if (out_path && fclose(csv) != 0) {
+        fprintf(stderr, "error - Writing the file %s failed\n", out_path);
+        failed = 1;
+    }
+    for (phase = 0; phase < PHASE_COUNT; ++phase) {
+        free(samples[phase]);
+    }
+
+    SDL_Quit();
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,643 @@
+/**
+ * @file    recursion_visualized_calltree.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the call-tree view functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+
+#include "recursion_visualized_calltree.h"
+#include "recursion_visualized_header.h"  // CYAN
+
+
+/* The indices of the batches, one per color. */
+#define TREE_ACTIVE    0  // on the runtime stack
+#define TREE_RETURNING 1  // being returned from
+#define TREE_RETURNED  2  // already returned
+#define TREE_HIT       3  // answered from the memoization cache
+
+/* The RGB colors of the batches: LIME, PINK, grey and CYAN. */
+static const Uint8 TREE_COLOR_RGB[TREE_COLOR_COUNT][3] = {
+    {   0, 255, 100 },
+    { 255,   0, 100 },
+    { 200, 200, 220 },
+    {   0, 220, 255 }
+};
+
+/* The most a column can be zoomed in to, in pixels per column. */
+#define TREE_MAX_COLUMN_WIDTH 64.0
+
+/* Boxes at least this wide or tall are drawn with a 1 pixel gap, so they can be told apart. */
+#define TREE_GAP_MIN_SIZE 4
+
+
+/**
+ * This function finishes the layout of a call, once it has returned.
+ * A call that made no further calls is a leaf, and takes the next free column.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param Uint32 i - The index of the call.
+ */
+static void finishCall(CallTree* tree, Uint32 i)
+{
+    CallNode* node = &tree->nodes[i];
+
+    if (node->next != TREE_NONE) {
+        return;
+    }
+
+    // Nothing was added after the call, so it has no descendants.
+    if (tree->count == i + 1) {
+        ++tree->columns;
+    }
+
+    node->column_end = tree->columns;
+    node->next       = tree->count;
+
+    if (node->parent != TREE_NONE && tree->nodes[node->parent].height < node->height + 1) {
+        tree->nodes[node->parent].height = node->height + 1;
+    }
+}
+
+
+/**
+ * This function finishes every call on the runtime stack deeper than the given depth.
+ * Not every recursive function records its exit, bunny() does not for its base case,
+ * so a call is also known to have returned when a shallower one is pushed or popped.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param Uint32 depth - The depth that the runtime stack went back down to.
+ */
+static void finishAbove(CallTree* tree, Uint32 depth)
+{
+    while (tree->depth > depth) {
+        finishCall(tree, tree->stack[tree->depth - 1]);
+        --tree->depth;
+    }
+}
+
+
+/**
+ * This function merges every returned subtree at most width columns wide into its first call,
+ * and moves the calls which are left together, in the same order.
+ * The calls are walked in order with the path of callers to the current one, so that
+ * the new index of every caller is known when its callees arrive, and its new end once
+ * the walk has left it.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param Uint32 width - The widest subtree to merge, in columns.
+ *
+ * @return int - 0 on success, -1 if the memory for the path could not be allocated.
+ */
+static int mergeSubtrees(CallTree* tree, Uint32 width)
+{
+    Uint32* old_path  = (Uint32*) malloc(((size_t) tree->max_depth + 1) * 2 * sizeof(Uint32));
+    Uint32* new_path  = old_path + tree->max_depth + 1;
+    Uint32  path      = 0;
+    Uint32  read      = 0;
+    Uint32  write     = 0;
+    Uint32  level     = 0;
+    Uint32  returning = TREE_NONE;
+
+    if (!old_path) {
+        return -1;
+    }
+
+    while (read < tree->count) {
+        CallNode node = tree->nodes[read];
+        Uint32   next = read + 1;
+
+	// The callers on the path which are not the caller of this call have ended right before it.
+        while (path > 0 && old_path[path - 1] != node.parent) {
+            --path;
+            if (tree->nodes[new_path[path]].next != TREE_NONE) {
+                tree->nodes[new_path[path]].next = write;
+            }
+        }
+        node.parent = (path > 0) ? new_path[path - 1] : TREE_NONE;
+
+	// A narrow subtree which has returned becomes a single call, and its descendants are skipped.
+        if (node.next != TREE_NONE && node.next > read + 1 && node.column_end - node.column <= width) {
+            next        = node.next;
+            node.next   = write + 1;
+            node.merged = 1;
+        } else {
+            old_path[path] = read;
+            new_path[path] = write;
+            ++path;
+        }
+
+	// The calls on the runtime stack and the one being returned from are never skipped.
+        if (read == tree->returning) {
+            returning = write;
+        }
+        while (level < tree->depth && tree->stack[level] == read) {
+            tree->stack[level++] = write;
+        }
+
+        tree->nodes[write++] = node;
+        read = next;
+    }
+    while (path > 0) {
+        --path;
+        if (tree->nodes[new_path[path]].next != TREE_NONE) {
+            tree->nodes[new_path[path]].next = write;
+        }
+    }
+
+    tree->count        = write;
+    tree->returning    = returning;
+    free(old_path);
+
+    // This happens while a call is pushed, so the calls merged may still have been on the runtime
+    // stack at an earlier point with as many calls made. Only the point after the push is safe.
+    tree->merged_calls = tree->calls + 1;
+
+    return 0;
+}
+
+
+/**
+ * This function makes room for one more call. Within the budget the room is doubled,
+ * and past it the narrowest returned subtrees are merged, until at most half of the budget
+ * is used. Only if merging cannot free a quarter of the room is it doubled anyway.
+ *
+ * @param CallTree* tree - A pointer to the tree, which is full.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated,
+ *               or there would be more calls than can be counted.
+ */
+static int makeRoom(CallTree* tree)
+{
+    CallNode* nodes;
+
+    if (tree->capacity >= TREE_NODE_BUDGET) {
+        while (tree->count > TREE_NODE_BUDGET / 2) {
+            if (mergeSubtrees(tree, tree->merge_width) != 0 || tree->count <= TREE_NODE_BUDGET / 2 ||
+                tree->merge_width > tree->columns || tree->merge_width >= 0x80000000) {
+                break;
+            }
+            tree->merge_width *= 2;
+        }
+        if (tree->count <= tree->capacity / 4 * 3) {
+            return 0;
+        }
+    }
+
+    if (tree->capacity > TREE_NONE / 2 / sizeof(CallNode)) {
+        return -1;
+    }
+    nodes = (CallNode*) realloc(tree->nodes, (size_t) tree->capacity * 2 * sizeof(CallNode));
+    if (!nodes) {
+        return -1;
+    }
+    tree->nodes     = nodes;
+    tree->capacity *= 2;
+
+    return 0;
+}
+
+
+/**
+ * This function appends one box to the batch of its color, making more room if needed.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param int batch - TREE_ACTIVE, TREE_RETURNING, TREE_RETURNED or TREE_HIT.
+ *
+ * @param const SDL_Rect* rect - The box.
+ */
+static void addToBatch(CallTree* tree, int batch, const SDL_Rect* rect)
+{
+    if (tree->batch_sizes[batch] == tree->batch_capacity) {
+        int       capacity = tree->batch_capacity * 2;
+        SDL_Rect* grown[TREE_COLOR_COUNT];
+        int       b;
+
+        for (b = 0; b < TREE_COLOR_COUNT; ++b) {
+            grown[b] = (SDL_Rect*) realloc(tree->batches[b], capacity * sizeof(SDL_Rect));
+            if (grown[b]) {
+                tree->batches[b] = grown[b];
+            }
+        }
+        for (b = 0; b < TREE_COLOR_COUNT; ++b) {
+            if (!grown[b]) {
+		// Out of memory, so this box is simply not drawn.
+                return;
+            }
+        }
+        tree->batch_capacity = capacity;
+    }
+
+    tree->batches[batch][tree->batch_sizes[batch]++] = *rect;
+}
+
+
+int callTreeInit(CallTree* tree, int width, int height)
+{
+    int batch;
+
+    tree->capacity       = 1024;
+    tree->stack_capacity = 64;
+    tree->batch_capacity = width * 4;
+    tree->nodes          = (CallNode*) malloc(tree->capacity * sizeof(CallNode));
+    tree->stack          = (Uint32*) malloc(tree->stack_capacity * sizeof(Uint32));
+    for (batch = 0; batch < TREE_COLOR_COUNT; ++batch) {
+        tree->batches[batch]     = (SDL_Rect*) malloc(tree->batch_capacity * sizeof(SDL_Rect));
+        tree->batch_sizes[batch] = 0;
+    }
+
+    tree->count             = 0;
+    tree->depth             = 0;
+    tree->max_depth         = 0;
+    tree->columns           = 0;
+    tree->returning         = TREE_NONE;
+    tree->calls             = 0;
+    tree->merged_calls      = 0;
+    tree->merge_width       = 1;
+    tree->width             = width;
+    tree->height            = height;
+    tree->offset            = 0.0;
+    tree->columns_per_pixel = 1.0;
+    tree->fit               = 1;
+    tree->follow            = 0;
+
+    for (batch = 0; batch < TREE_COLOR_COUNT; ++batch) {
+        if (!tree->batches[batch]) {
+            callTreeDestroy(tree);
+            return -1;
+        }
+    }
+    if (!tree->nodes || !tree->stack) {
+        callTreeDestroy(tree);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void callTreeDestroy(CallTree* tree)
+{
+    int batch;
+
+    for (batch = 0; batch < TREE_COLOR_COUNT; ++batch) {
+        free(tree->batches[batch]);
+        tree->batches[batch] = NULL;
+    }
+    free(tree->nodes);
+    free(tree->stack);
+    tree->nodes    = NULL;
+    tree->stack    = NULL;
+    tree->count    = 0;
+    tree->capacity = 0;
+}
+
+
+int callTreeApply(CallTree* tree, const StackEvent* event)
+{
+    CallNode* node;
+
+    if (event->type == EVENT_END) {
+        finishAbove(tree, 0);
+        tree->returning = TREE_NONE;
+        return 0;
+    }
+
+    if (event->type == EVENT_POP) {
+        finishAbove(tree, event->depth);
+        if (tree->depth == event->depth) {
+            tree->returning = tree->stack[event->depth - 1];
+            finishCall(tree, tree->returning);
+            --tree->depth;
+        }
+        return 0;
+    }
+
+    // A push: everything that was deeper than the caller has returned.
+    finishAbove(tree, event->depth - 1);
+    tree->returning = TREE_NONE;
+
+    // Make room for the new call, and for a deeper runtime stack.
+    if (tree->count == tree->capacity && makeRoom(tree) != 0) {
+        return -1;
+    }
+    if (event->depth > tree->stack_capacity) {
+        Uint32* stack;
+
+        if (event->depth > TREE_NONE / 2 / sizeof(Uint32)) {
+            return -1;
+        }
+        stack = (Uint32*) realloc(tree->stack, (size_t) event->depth * 2 * sizeof(Uint32));
+        if (!stack) {
+            return -1;
+        }
+        tree->stack          = stack;
+        tree->stack_capacity = event->depth * 2;
+    }
+
+    node = &tree->nodes[tree->count];
+    node->column     = tree->columns;
+    node->column_end = TREE_NONE;
+    node->next       = TREE_NONE;
+    node->parent     = (tree->depth > 0) ? tree->stack[tree->depth - 1] : TREE_NONE;
+    node->depth      = event->depth;
+    node->height     = 0;
+    node->hit        = (event->color == CYAN);
+    node->merged     = 0;
+
+    tree->stack[event->depth - 1] = tree->count;
+    tree->depth = event->depth;
+    ++tree->count;
+    ++tree->calls;
+
+    if (tree->max_depth < tree->depth) {
+        tree->max_depth = tree->depth;
+    }
+
+    return 0;
+}
+
+
+int callTreeRewind(CallTree* tree, Uint64 calls, const StackEvent* last)
+{
+    Uint32 depth     = 0;
+    Uint32 old_depth = tree->depth;
+    Uint32 count;
+    Uint32 node;
+    Uint32 level;
+    Uint32 common    = 0;
+
+    // The calls made since subtrees were last merged still each have a call of their own,
+    // right after the ones which are left from before.
+    if (calls > tree->calls) {
+        return 0;
+    }
+    if (calls < tree->merged_calls) {
+        return -1;
+    }
+    count       = (Uint32) (calls - (tree->calls - tree->count));
+    tree->calls = calls;
+
+    // How deep the runtime stack was right after the last record.
+    if (count > 0 && last->type == EVENT_PUSH) {
+        depth = last->depth;
+    } else if (count > 0 && last->type == EVENT_POP) {
+        depth = last->depth - 1;
+    }
+
+    tree->count     = count;
+    tree->depth     = depth;
+    tree->returning = TREE_NONE;
+
+    // The calls on the runtime stack are the last call made and its callers, from the first
+    // one that was not deeper than the stack. Every call in between had already returned,
+    // and the call at the depth of a pop is the one being returned from.
+    node = (count > 0) ? count - 1 : TREE_NONE;
+    while (node != TREE_NONE && tree->nodes[node].depth > depth) {
+        if (last->type == EVENT_POP && tree->nodes[node].depth == last->depth) {
+            tree->returning = node;
+        }
+        node = tree->nodes[node].parent;
+    }
+
+    // Fill in the runtime stack from the top down, until it agrees with what it was before.
+    // Below that point, nothing about the calls changed.
+    for (level = depth; level > 0 && node != TREE_NONE; --level) {
+        if (level <= old_depth && tree->stack[level - 1] == node) {
+            common = level;
+            break;
+        }
+        tree->stack[level - 1] = node;
+        node = tree->nodes[node].parent;
+    }
+
+    // The calls on the runtime stack above that point have not returned yet. The deepest
+    // of their returned callees is the only thing which decides their height so far.
+    // The call at that point may have lost returned callees too.
+    for (level = (common > 0) ? common : 1; level <= depth; ++level) {
+        CallNode* caller = &tree->nodes[tree->stack[level - 1]];
+        Uint32    open   = (level < depth) ? tree->stack[level] : count;
+        Uint32    callee = tree->stack[level - 1] + 1;
+
+        caller->column_end = TREE_NONE;
+        caller->next       = TREE_NONE;
+        caller->height     = 0;
+        while (callee < open) {
+            if (caller->height < tree->nodes[callee].height + 1) {
+                caller->height = tree->nodes[callee].height + 1;
+            }
+            callee = tree->nodes[callee].next;
+        }
+    }
+
+    // The next free column is right after the last leaf that returned.
+    if (depth > 0) {
+        const CallNode* top    = &tree->nodes[tree->stack[depth - 1]];
+        Uint32          callee = tree->stack[depth - 1] + 1;
+
+        tree->columns = top->column;
+        while (callee < count) {
+            tree->columns = tree->nodes[callee].column_end;
+            callee = tree->nodes[callee].next;
+        }
+    } else {
+        Uint32 first = 0;
+
+        tree->columns = 0;
+        while (first < count) {
+            tree->columns = tree->nodes[first].column_end;
+            first = tree->nodes[first].next;
+        }
+    }
+
+    return 0;
+}
+
+
+void callTreeClear(CallTree* tree)
+{
+    tree->count        = 0;
+    tree->depth        = 0;
+    tree->max_depth    = 0;
+    tree->columns      = 0;
+    tree->returning    = TREE_NONE;
+    tree->calls        = 0;
+    tree->merged_calls = 0;
+    tree->merge_width  = 1;
+}
+
+
+void callTreeScroll(CallTree* tree, int pixels)
+{
+    tree->offset += pixels * tree->columns_per_pixel;
+    if (tree->offset < 0.0) {
+        tree->offset = 0.0;
+    }
+
+    tree->fit    = 0;
+    tree->follow = 0;
+}
+
+
+void callTreeZoom(CallTree* tree, int steps)
+{
+    // Zoom around the active call, or around the middle of the viewport if there is none.
+    double anchor = (tree->depth > 0) ? tree->columns + 0.5
+                                      : tree->offset + tree->width / 2.0 * tree->columns_per_pixel;
+    double x      = (anchor - tree->offset) / tree->columns_per_pixel;
+    double widest = (tree->columns + 1.0) / tree->width * 2.0;
+
+    for (; steps > 0 && tree->columns_per_pixel / 2.0 >= 1.0 / TREE_MAX_COLUMN_WIDTH; --steps) {
+        tree->columns_per_pixel /= 2.0;
+    }
+    for (; steps < 0 && tree->columns_per_pixel < widest; ++steps) {
+        tree->columns_per_pixel *= 2.0;
+    }
+
+    tree->offset = anchor - x * tree->columns_per_pixel;
+    if (tree->offset < 0.0) {
+        tree->offset = 0.0;
+    }
+
+    tree->fit    = 0;
+    tree->follow = 1;
+}
+
+
+void callTreeFit(CallTree* tree)
+{
+    tree->fit    = 1;
+    tree->follow = 0;
+}
+
+
+void callTreeDraw(CallTree* tree, SDL_Renderer* renderer)
+{
+    double   cpp;
+    double   row_height;
+    Uint32   end_columns = tree->columns + ((tree->depth > 0) ? 1 : 0);
+    Uint32   i;
+    int      batch;
+    SDL_Rect rect;
+
+    if (tree->fit) {
+        tree->offset            = 0.0;
+        tree->columns_per_pixel = (end_columns > 0) ? (double) end_columns / tree->width : 1.0;
+        if (tree->columns_per_pixel < 1.0 / TREE_MAX_COLUMN_WIDTH) {
+            tree->columns_per_pixel = 1.0 / TREE_MAX_COLUMN_WIDTH;
+        }
+    } else if (tree->follow && tree->depth > 0) {
+	// Keep the active call inside of the viewport, bringing it back to the middle when it leaves.
+        double x = (tree->columns - tree->offset) / tree->columns_per_pixel;
+        if (x < 0.0 || x >= tree->width) {
+            tree->offset = tree->columns - tree->width / 2.0 * tree->columns_per_pixel;
+            if (tree->offset < 0.0) {
+                tree->offset = 0.0;
+            }
+        }
+    }
+
+    cpp        = tree->columns_per_pixel;
+    row_height = (tree->max_depth > 0) ? (double) tree->height / tree->max_depth : TREE_ROW_HEIGHT;
+    if (row_height > TREE_ROW_HEIGHT) {
+        row_height = TREE_ROW_HEIGHT;
+    }
+
+    for (batch = 0; batch < TREE_COLOR_COUNT; ++batch) {
+        tree->batch_sizes[batch] = 0;
+    }
+
+    // Walk the calls in the order they were made, which visits every caller before its callees.
+    // A call that is still on the runtime stack has no known end yet: its box reaches up to the
+    // active column, and all the calls after it are its descendants.
+    i = 0;
+    while (i < tree->count) {
+        const CallNode* node    = &tree->nodes[i];
+        int             active  = (node->next == TREE_NONE);
+        Uint32          end     = active ? tree->columns + 1 : node->column_end;
+        Uint32          skip    = active ? tree->count : node->next;
+        double          left    = (node->column - tree->offset) / cpp;
+        double          right   = (end - tree->offset) / cpp;
+        int             top     = (int) ((node->depth - 1) * row_height);
+        int             bottom  = (int) (node->depth * row_height);
+        int             x0;
+        int             x1;
+
+	// The call and all of its descendants are outside of the viewport.
+        if (right <= 0.0 || left >= tree->width || top >= tree->height) {
+            i = skip;
+            continue;
+        }
+
+        x0 = (left < 0.0) ? 0 : (int) left;
+        x1 = (right > tree->width) ? tree->width : (int) right;
+
+	// The whole subtree is narrower than a pixel, or was merged, so it is drawn as one block,
+	// down to its deepest descendant. The calls on the runtime stack are never collapsed
+	// like this, so the active path always stays visible.
+        if (!active && (x1 - x0 < 1 || node->merged)) {
+            rect.x = x0;
+            rect.y = top;
+            rect.w = (x1 - x0 < 1) ? 1 : x1 - x0;
+            rect.h = (int) ((node->depth + node->height) * row_height) - top;
+            if (rect.h < 1) {
+                rect.h = 1;
+            }
+            addToBatch(tree, (i == tree->returning) ? TREE_RETURNING : node->hit ? TREE_HIT : TREE_RETURNED, &rect);
+            i = skip;
+            continue;
+        }
+
+        rect.x = x0;
+        rect.y = top;
+        rect.w = x1 - x0;
+        rect.h = bottom - top;
+        if (rect.w < 1) {
+            rect.w = 1;
+        }
+        if (rect.h < 1) {
+            rect.h = 1;
+        }
+        if (rect.w >= TREE_GAP_MIN_SIZE) {
+            rect.w -= 1;
+        }
+        if (rect.h >= TREE_GAP_MIN_SIZE) {
+            rect.h -= 1;
+        }
+
+        if (i == tree->returning) {
+            addToBatch(tree, TREE_RETURNING, &rect);
+        } else if (active) {
+            addToBatch(tree, TREE_ACTIVE, &rect);
+        } else if (node->hit) {
+            addToBatch(tree, TREE_HIT, &rect);
+        } else {
+            addToBatch(tree, TREE_RETURNED, &rect);
+        }
+
+        ++i;
+    }
+
+    // One draw call per color, however many calls are visible.
+    // The returned calls go first, so the active path is drawn on top of them.
+    for (batch = TREE_COLOR_COUNT - 1; batch >= 0; --batch) {
+        if (tree->batch_sizes[batch] > 0) {
+            SDL_SetRenderDrawColor(renderer, TREE_COLOR_RGB[batch][0], TREE_COLOR_RGB[batch][1],
+                                   TREE_COLOR_RGB[batch][2], 255);
+            SDL_RenderFillRects(renderer, tree->batches[batch], tree->batch_sizes[batch]);
+        }
+    }
+}
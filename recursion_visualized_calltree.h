@@ -0,0 +1,304 @@
+/**
+ * @file    recursion_visualized_calltree.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the call-tree view, which shows branching (tree)
+ * recursion such as fibonacci() as a tree of calls, instead of as a single column.
+ *
+ * The tree is drawn as an icicle chart: the first call is the top row, and every call is a
+ * box in the row of its depth, spanning exactly the columns of all of its descendants.
+ * The calls that are on the runtime stack right now, the active root-to-leaf path, are drawn
+ * in LIME, the call that is being returned from in PINK, and calls that already returned in grey.
+ * Calls that were answered from the memoization cache are leaves in CYAN once they returned.
+ *
+ * The layout is incremental and never changes once made. Every call that makes no further
+ * calls, a leaf, takes the next free column when it returns, and every other call starts
+ * in the column of its first child and ends after its last one. The calls are stored in the
+ * order they were made, so the descendants of a call always directly follow it.
+ *
+ * This makes the tree its own spatial index, a bounding volume hierarchy: the box of a call
+ * contains the boxes of all of its descendants. Drawing walks the calls in order, and skips
+ * a whole subtree at once when it is outside of the viewport, or when it is narrower than
+ * a pixel, in which case the subtree is drawn as one block. Only calls whose boxes can be seen
+ * are ever visited, so the cost of a frame stays bounded by the size of the window, even with
+ * millions of calls recorded, such as the 2.7 million of fibonacci(30).
+ *
+ * The memory of the tree is bounded too. Once it holds TREE_NODE_BUDGET calls, the returned
+ * subtrees narrower than a few columns are merged into their first call, which keeps the box,
+ * the columns and the height of the whole subtree and is drawn as one block, like a subtree
+ * narrower than a pixel is. The narrowest subtrees go first, doubling the width until at most
+ * half of the budget is used. Only the calls on the runtime stack can never be merged, so the
+ * tree only grows past the budget when they alone fill it.
+ */
+
+#ifndef RECURSION_VISUALIZED_CALLTREE_H
+#define RECURSION_VISUALIZED_CALLTREE_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_ring.h"  // StackEvent
+
+
+/* The tallest a row of the call tree is drawn, in pixels. */
+#define TREE_ROW_HEIGHT 24.0
+
+/* The number of different colors a call can be drawn in: active, returning, returned,
+   and answered from the memoization cache. */
+#define TREE_COLOR_COUNT 4
+
+/* Marks a call which has no parent, or which has not returned yet. */
+#define TREE_NONE 0xFFFFFFFF
+
+/* The most calls the tree holds before it merges returned subtrees, 28 MB of them. */
+#define TREE_NODE_BUDGET (1 << 20)
+
+
+/**
+ * One call in the call tree.
+ *
+ * @field Uint32 column - The first column of the box of the call.
+ *
+ * @field Uint32 column_end - One past the last column of the box, once the call has returned.
+ *
+ * @field Uint32 next - The index one past the last descendant of the call, once it has returned,
+ *                      or TREE_NONE while it is still on the runtime stack.
+ *
+ * @field Uint32 parent - The index of the caller, or TREE_NONE for the first call.
+ *
+ * @field Uint32 depth - The depth of the call. The first call has depth 1.
+ *
+ * @field Uint32 height - How many rows the deepest descendant of the call is below it.
+ *
+ * @field Uint16 hit - Nonzero if the call was answered from the memoization cache, recorded in CYAN.
+ *
+ * @field Uint16 merged - Nonzero if the descendants of the call were merged into it.
+ */
+typedef struct CallNode {
+    Uint32 column;
+    Uint32 column_end;
+    Uint32 next;
+    Uint32 parent;
+    Uint32 depth;
+    Uint32 height;
+    Uint16 hit;
+    Uint16 merged;
+} CallNode;
+
+
+/**
+ * The call tree, and the viewport through which it is drawn.
+ *
+ * @field CallNode* nodes - The calls, in the order they were made.
+ *
+ * @field Uint32 count, capacity - The number of calls, and the room for them.
+ *
+ * @field Uint32* stack - stack[i] is the index of the call at depth i + 1 on the runtime stack.
+ *
+ * @field Uint32 depth, stack_capacity - The current depth of the runtime stack, and the room for it.
+ *
+ * @field Uint32 max_depth - The deepest the runtime stack has been.
+ *
+ * @field Uint32 columns - The next free column, which is also the number of leaves so far.
+ *
+ * @field Uint32 returning - The index of the call which is being returned from, or TREE_NONE.
+ *
+ * @field Uint64 calls - The number of calls made so far, including the ones which were merged.
+ *
+ * @field Uint64 merged_calls - The fewest calls the tree can be wound back to,
+ *                              since subtrees were last merged.
+ *
+ * @field Uint32 merge_width - The widest, in columns, that a subtree is merged at.
+ *
+ * @field int width, height - The size of the viewport in pixels.
+ *
+ * @field double offset - The column shown at the left edge of the viewport.
+ *
+ * @field double columns_per_pixel - The horizontal zoom.
+ *
+ * @field int fit - Nonzero if the whole tree is fitted into the viewport every time it is drawn.
+ *
+ * @field int follow - Nonzero if the viewport scrolls by itself to keep the active call in sight.
+ *
+ * @field SDL_Rect* batches[TREE_COLOR_COUNT], int batch_sizes[], int batch_capacity - The boxes
+ *                  of each color gathered for drawing, and the room there is for them.
+ */
+typedef struct CallTree {
+    CallNode* nodes;
+    Uint32    count;
+    Uint32    capacity;
+    Uint32*   stack;
+    Uint32    depth;
+    Uint32    stack_capacity;
+    Uint32    max_depth;
+    Uint32    columns;
+    Uint32    returning;
+    Uint64    calls;
+    Uint64    merged_calls;
+    Uint32    merge_width;
+    int       width;
+    int       height;
+    double    offset;
+    double    columns_per_pixel;
+    int       fit;
+    int       follow;
+    SDL_Rect* batches[TREE_COLOR_COUNT];
+    int       batch_sizes[TREE_COLOR_COUNT];
+    int       batch_capacity;
+} CallTree;
+
+
+/**
+ * This function sets up an empty call tree.
+ *
+ * @param CallTree* tree - A pointer to the tree to initialize.
+ *
+ * @param int width, height - The size of the viewport in pixels.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int callTreeInit(CallTree* tree, int width, int height);
+
+
+/**
+ * This function deallocates the memory owned by the call tree.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeDestroy(CallTree* tree);
+
+
+/**
+ * This function plays one push/pop record back into the call tree.
+ * A push adds a new call under the caller at the top of the runtime stack,
+ * and a pop finishes the layout of the call at event->depth.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param const StackEvent* event - The record to play back.
+ *
+ * @return int - 0 on success, -1 if the memory for more calls could not be allocated,
+ *               or there would be more than can be counted.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int callTreeApply(CallTree* tree, const StackEvent* event);
+
+
+/**
+ * This function winds the call tree back to how it was earlier in the same recording,
+ * which is how the timeline jumps back to an earlier step. The calls made after that
+ * point are forgotten, and the calls on the runtime stack back then are reopened.
+ * It only visits the calls on the runtime stack which changed, and their returned callees.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param Uint64 calls - How many calls had been made at that point. It must not be more
+ *                       than there are now.
+ *
+ * @param const StackEvent* last - The last push/pop record played back before that point.
+ *                                 It is ignored if calls is 0.
+ *
+ * @return int - 0 on success, -1 if subtrees were merged after that point, in which case the tree
+ *               is unchanged, and has to be cleared with callTreeClear() and played back again.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int callTreeRewind(CallTree* tree, Uint64 calls, const StackEvent* last);
+
+
+/**
+ * This function forgets every call, so the tree can be played back again from the start.
+ * The viewport stays where it is.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeClear(CallTree* tree);
+
+
+/**
+ * These functions move the viewport.
+ *
+ * callTreeScroll() scrolls sideways by the given number of pixels, positive to the right.
+ * It turns off fitting and following.
+ *
+ * callTreeZoom() halves the columns per pixel for every positive step, and doubles
+ * them for every negative step, keeping the active call in the same place.
+ * It turns off fitting, and turns on following.
+ *
+ * callTreeFit() turns fitting back on.
+ *
+ * @param CallTree* tree - A pointer to the tree.
+ *
+ * @param int pixels / int steps - How far to scroll or zoom.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeScroll(CallTree* tree, int pixels);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeZoom(CallTree* tree, int steps);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeFit(CallTree* tree);
+
+
+/**
+ * This function draws the calls inside of the viewport onto the renderer,
+ * with one SDL_RenderFillRects() call per color. A call whose descendants were merged into it
+ * is drawn as one block, down to its deepest descendant.
+ * It does not clear the background and does not present.
+ *
+ * @param CallTree* tree - A pointer to the tree. In fitting mode its zoom is updated.
+ *
+ * @param SDL_Renderer* renderer - The renderer to draw into.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void callTreeDraw(CallTree* tree, SDL_Renderer* renderer);
+
+#endif /* RECURSION_VISUALIZED_CALLTREE_H */
@@ -0,0 +1,339 @@
+/**
+ * @file    recursion_visualized_chrome.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the Chrome trace exporter functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+#include <stdio.h>   // C standard input/output - for fopen(), fwrite(), fclose()
+#include <string.h>  // C strings - for memset(), memcpy(), strlen()
+
+#include "recursion_visualized_chrome.h"
+#include "recursion_visualized_trace.h"     // traceTicks(), FUNCTION_*
+#include "recursion_visualized_examples.h"  // functionName(), describeCall()
+
+
+/* The start and the end of the JSON. */
+static const char CHROME_HEADER[] =
+    "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+    "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Recursion Visualized\"}},\n"
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"recursion\"}}";
+static const char CHROME_FOOTER[] = "\n]}\n";
+
+
+/**
+ * This function writes out the events in the buffer.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @return int - 0 on success, -1 if writing failed.
+ */
+static int flushBuffer(ChromeWriter* writer)
+{
+    if (writer->used > 0 && fwrite(writer->buffer, writer->used, 1, writer->file) != 1) {
+        writer->failed = 1;
+    }
+    writer->used = 0;
+
+    return writer->failed ? -1 : 0;
+}
+
+
+/**
+ * This function appends text to the buffer, which must have room for it.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param const char* text - The text, terminated by '\0'.
+ */
+static void appendText(ChromeWriter* writer, const char* text)
+{
+    size_t length = strlen(text);
+
+    memcpy(writer->buffer + writer->used, text, length);
+    writer->used += length;
+}
+
+
+/**
+ * This function appends an unsigned number in decimal to the buffer, which must have room for it.
+ * The digits are made from the last one, backwards, without going through the C library.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param Uint64 value - The number.
+ *
+ * @param int min_digits - The fewest digits to write, padded with leading zeros.
+ */
+static void appendUnsigned(ChromeWriter* writer, Uint64 value, int min_digits)
+{
+    char digits[20];
+    int  count = 0;
+
+    do {
+        digits[count++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value > 0 || count < min_digits);
+
+    while (count > 0) {
+        writer->buffer[writer->used++] = digits[--count];
+    }
+}
+
+
+/**
+ * This function appends a signed number in decimal to the buffer, which must have room for it.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param Sint64 value - The number.
+ */
+static void appendSigned(ChromeWriter* writer, Sint64 value)
+{
+    if (value < 0) {
+        writer->buffer[writer->used++] = '-';
+        appendUnsigned(writer, (Uint64) 0 - (Uint64) value, 1);
+    } else {
+        appendUnsigned(writer, (Uint64) value, 1);
+    }
+}
+
+
+/**
+ * This function appends the timestamp of a record, in microseconds since the first record,
+ * to the buffer, which must have room for it.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param Uint64 ticks - When the record was made, in the ticks of traceTicks().
+ */
+static void appendTimestamp(ChromeWriter* writer, Uint64 ticks)
+{
+    // The clocks of two CPUs may be a few ticks apart, which must not make a timestamp negative.
+    Uint64 ns = (ticks > writer->first_ticks) ?
+                (Uint64) ((double) (ticks - writer->first_ticks) / writer->ticks_per_ns + 0.5) : 0;
+
+    appendUnsigned(writer, ns / 1000, 1);
+    writer->buffer[writer->used++] = '.';
+    appendUnsigned(writer, ns % 1000, 3);
+}
+
+
+/**
+ * This function tells how many arguments a recursive function records, the same ones
+ * describeCall() shows.
+ *
+ * @param Uint16 function - The FUNCTION_* constant of the function.
+ *
+ * @return int - The number of arguments, at most STACK_EVENT_ARGS.
+ */
+static int argumentCount(Uint16 function)
+{
+    switch (function) {
+    case FUNCTION_BUNNY:
+    case FUNCTION_FACTORIAL:
+    case FUNCTION_FIBONACCI:
+        return 1;
+    case FUNCTION_QUICKSORT:
+    case FUNCTION_ACKERMANN:
+    case FUNCTION_MERGESORT:
+        return 2;
+    case FUNCTION_HANOI:
+        return 3;
+    default:
+	// The argument of an instrumented function is its address, which is already its name.
+        return 0;
+    }
+}
+
+
+/**
+ * This function ends every open slice at least as deep as a depth.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param Uint32 depth - The depth of the shallowest slice to end.
+ *
+ * @param Uint64 ticks - When they end.
+ *
+ * @return int - 0 on success, -1 if writing failed.
+ */
+static int endFrom(ChromeWriter* writer, Uint32 depth, Uint64 ticks)
+{
+    while (writer->open_count > 0 && writer->open[writer->open_count - 1] >= depth) {
+        if (writer->used + CHROME_EVENT_MAX_SIZE > CHROME_BUFFER_SIZE && flushBuffer(writer) != 0) {
+            return -1;
+        }
+        appendText(writer, ",\n{\"ph\":\"E\",\"ts\":");
+        appendTimestamp(writer, ticks);
+        appendText(writer, ",\"pid\":1,\"tid\":1}");
+        --writer->open_count;
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function keeps the depth of a slice being begun.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param Uint32 depth - The depth of the slice.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int beginAt(ChromeWriter* writer, Uint32 depth)
+{
+    if (writer->open_count == writer->open_capacity) {
+        Uint32  capacity = writer->open_capacity ? writer->open_capacity * 2 : 1024;
+        Uint32* open;
+
+        if (writer->open_capacity > 0xFFFFFFFF / 2 / sizeof(Uint32)) {
+            return -1;
+        }
+        open = (Uint32*) realloc(writer->open, capacity * sizeof(Uint32));
+        if (!open) {
+            return -1;
+        }
+        writer->open          = open;
+        writer->open_capacity = capacity;
+    }
+    writer->open[writer->open_count++] = depth;
+
+    return 0;
+}
+
+
+int chromeWriterOpen(ChromeWriter* writer, const char* path)
+{
+    Uint64 counter;
+    Uint64 ticks;
+
+    memset(writer, 0, sizeof(*writer));
+
+    writer->buffer = (char*) malloc(CHROME_BUFFER_SIZE);
+    if (!writer->buffer) {
+        return -1;
+    }
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        free(writer->buffer);
+        writer->buffer = NULL;
+        return -1;
+    }
+
+    // The rate of traceTicks() is measured against SDL_GetPerformanceCounter(), whose rate is known.
+    counter = SDL_GetPerformanceCounter();
+    ticks   = traceTicks();
+    SDL_Delay(CHROME_CALIBRATION_MS);
+    counter = SDL_GetPerformanceCounter() - counter;
+    ticks   = traceTicks() - ticks;
+    writer->ticks_per_ns = (counter > 0 && ticks > 0) ?
+                           (double) ticks * SDL_GetPerformanceFrequency() / counter / 1e9 :
+                           SDL_GetPerformanceFrequency() / 1e9;
+
+    appendText(writer, CHROME_HEADER);
+
+    return 0;
+}
+
+
+int chromeWriterWrite(ChromeWriter* writer, const StackEvent* event)
+{
+    char name[64];
+    int  args;
+    int  i;
+
+    if (event->type == EVENT_END) {
+        return endFrom(writer, 0, writer->last_ticks);
+    }
+    if (event->type != EVENT_PUSH && event->type != EVENT_POP) {
+        return 0;
+    }
+    if (writer->count == 0) {
+        writer->first_ticks = event->ticks;
+    }
+    writer->last_ticks = event->ticks;
+
+    // The calls deeper than a pop returned without a pop of their own, so their slices end with it.
+    // A pop only has to end the slice the push began, if that is still open.
+    if (event->type == EVENT_POP) {
+        ++writer->count;
+        return endFrom(writer, event->depth, event->ticks);
+    }
+
+    // So did the calls at least as deep as a push.
+    if (endFrom(writer, event->depth, event->ticks) != 0) {
+        return -1;
+    }
+    if (beginAt(writer, event->depth) != 0) {
+        writer->failed = 1;
+        return -1;
+    }
+    if (writer->used + CHROME_EVENT_MAX_SIZE > CHROME_BUFFER_SIZE && flushBuffer(writer) != 0) {
+        return -1;
+    }
+
+    // None of the names has a character which would have to be escaped in JSON.
+    describeCall(name, sizeof(name), event->function, event->args);
+    appendText(writer, ",\n{\"name\":\"");
+    appendText(writer, name);
+    appendText(writer, "\",\"cat\":\"");
+    appendText(writer, (event->function == FUNCTION_INSTRUMENTED) ? "instrumented" : functionName(event->function));
+    appendText(writer, "\",\"ph\":\"B\",\"ts\":");
+    appendTimestamp(writer, event->ticks);
+    appendText(writer, ",\"pid\":1,\"tid\":1,\"args\":{\"depth\":");
+    appendUnsigned(writer, event->depth, 1);
+
+    args = argumentCount(event->function);
+    if (args > 0) {
+        appendText(writer, ",\"arguments\":[");
+        for (i = 0; i < args; ++i) {
+            if (i > 0) {
+                writer->buffer[writer->used++] = ',';
+            }
+            appendSigned(writer, event->args[i]);
+        }
+        writer->buffer[writer->used++] = ']';
+    }
+    if (event->stack > 0) {
+        appendText(writer, ",\"stack_bytes\":");
+        appendUnsigned(writer, event->stack, 1);
+    }
+    appendText(writer, "}}");
+    ++writer->count;
+
+    return 0;
+}
+
+
+int chromeWriterClose(ChromeWriter* writer)
+{
+    if (!writer->file) {
+        return -1;
+    }
+
+    endFrom(writer, 0, writer->last_ticks);
+    appendText(writer, CHROME_FOOTER);
+    flushBuffer(writer);
+    if (fclose(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    writer->file = NULL;
+    free(writer->buffer);
+    writer->buffer = NULL;
+    free(writer->open);
+    writer->open = NULL;
+
+    return writer->failed ? -1 : 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file    recursion_visualized_chrome.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the Chrome trace exporter, which writes the push/pop
+ * records of a run as a JSON trace that chrome://tracing and Perfetto (ui.perfetto.dev) can open.
+ *
+ * Every push becomes a "B" event and every pop an "E" event of the same thread, so each call is
+ * shown as a slice nested inside the one of its caller:
+ *   {"displayTimeUnit":"ns","traceEvents":[
+ *   {"name":"process_name","ph":"M","pid":1,"tid":1,"args":{"name":"Recursion Visualized"}},
+ *   {"name":"fibonacci(3)","cat":"fibonacci","ph":"B","ts":0.000,"pid":1,"tid":1,
+ *    "args":{"depth":1,"arguments":[3],"stack_bytes":176}},
+ *   {"ph":"E","ts":0.212,"pid":1,"tid":1},
+ *   ...
+ *   ]}
+ * (every event is on a line of its own). The timestamps are in microseconds since the first record,
+ * with nanoseconds after the decimal point. The records are timed in the ticks of traceTicks(),
+ * which are converted with the rate of the clock measured when the exporter is opened,
+ * so a trace file recorded on another machine is exported with the rate of this one.
+ *
+ * The events are formatted by hand into one buffer, which is written out whenever it is nearly
+ * full, so nothing is allocated per event, and millions of events are written in seconds.
+ *
+ * Not every push has a pop: bunny() returns from its base case without one, and a run which is
+ * stopped early ends with calls still on the stack. The depths of the slices still open are kept,
+ * so a pop, or a push, ends every slice at least as deep as itself first, the way the call tree
+ * finishes them, and the slices still open at the end are ended with the last record.
+ */
+
+#ifndef RECURSION_VISUALIZED_CHROME_H
+#define RECURSION_VISUALIZED_CHROME_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"  // StackEvent
+
+
+/* The size of the buffer the events are formatted into, and the most room one event can take. */
+#define CHROME_BUFFER_SIZE    (256 * 1024)
+#define CHROME_EVENT_MAX_SIZE 512
+
+/* How long the rate of traceTicks() is measured for when the exporter is opened, in milliseconds. */
+#define CHROME_CALIBRATION_MS 20
+
+
+/**
+ * A Chrome trace being exported.
+ *
+ * @field FILE* file - The open file.
+ *
+ * @field char* buffer - The events formatted but not written yet, CHROME_BUFFER_SIZE bytes.
+ *
+ * @field size_t used - How many bytes of buffer are in use.
+ *
+ * @field double ticks_per_ns - The rate of traceTicks(), in ticks per nanosecond.
+ *
+ * @field Uint64 first_ticks - When the first record was made, which the timestamps count from.
+ *
+ * @field Uint64 count - How many records have been exported.
+ *
+ * @field Uint64 last_ticks - When the last record was made, which ends the slices left open.
+ *
+ * @field Uint32* open - The depths of the slices begun but not ended yet, the innermost last.
+ *
+ * @field Uint32 open_count - How many slices are open.
+ *
+ * @field Uint32 open_capacity - How many depths open has room for.
+ *
+ * @field int failed - Nonzero if writing to the file failed.
+ */
+typedef struct ChromeWriter {
+    FILE*   file;
+    char*   buffer;
+    size_t  used;
+    double  ticks_per_ns;
+    Uint64  first_ticks;
+    Uint64  count;
+    Uint64  last_ticks;
+    Uint32* open;
+    Uint32  open_count;
+    Uint32  open_capacity;
+    int     failed;
+} ChromeWriter;
+
+
+/**
+ * This function creates a Chrome trace file, writes the start of the JSON into it,
+ * and measures the rate of traceTicks(), which takes CHROME_CALIBRATION_MS.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer to initialize.
+ *
+ * @param const char* path - The path of the file to create. An existing file is overwritten.
+ *
+ * @return int - 0 on success, -1 if the file or the buffer could not be created.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int chromeWriterOpen(ChromeWriter* writer, const char* path);
+
+
+/**
+ * This function appends the event of one push or pop record to a Chrome trace file.
+ * An EVENT_END record ends the slices still open.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @param const StackEvent* event - The record to export.
+ *
+ * @return int - 0 on success, -1 if writing failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int chromeWriterWrite(ChromeWriter* writer, const StackEvent* event);
+
+
+/**
+ * This function ends the slices still open, writes the end of the JSON and closes a Chrome trace file.
+ *
+ * @param ChromeWriter* writer - A pointer to the writer.
+ *
+ * @return int - 0 on success, -1 if anything written to the file failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int chromeWriterClose(ChromeWriter* writer);
+
+#endif /* RECURSION_VISUALIZED_CHROME_H */
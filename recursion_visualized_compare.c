@@ -0,0 +1,895 @@
+/**
+ * @file    recursion_visualized_compare.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the iterative versions of the examples,
+ * and of the comparison functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+#include <stdio.h>   // C standard input/output - for fprintf()
+#include <string.h>  // C strings - for memset()
+
+#if defined(__linux__)
+#include <unistd.h>             // POSIX - for syscall(), read(), close()
+#include <sys/ioctl.h>          // POSIX - for ioctl()
+#include <sys/syscall.h>        // Linux - for __NR_perf_event_open
+#include <linux/perf_event.h>   // Linux - for perf_event_attr
+#define COMPARE_PERF_EVENT 1
+#endif
+
+#include "recursion_visualized_compare.h"
+#include "recursion_visualized_trace.h"     // Tracer, traceRecordFrame()
+#include "recursion_visualized_examples.h"  // runExample(), exampleArray(), exampleMaxDepth()
+
+
+/* The height of the counters on top of each pane: 5 lines of text and a margin. */
+#define COUNTERS_MARGIN 4
+#define COUNTERS_HEIGHT (5 * GLYPH_HEIGHT + 2 * COUNTERS_MARGIN)
+
+
+/**
+ * A stack frame of an iterative version, in its stack array.
+ *
+ * @field Sint64 args[3] - The arguments of the call.
+ *
+ * @field Sint64 local - A local variable: a result kept over the next call, a partition point,
+ *                        or the middle of the range to merge.
+ *
+ * @field int state - How far the call has got: 0 when it starts, then one more for every call it made.
+ */
+typedef struct IterativeFrame {
+    Sint64 args[3];
+    Sint64 local;
+    int    state;
+} IterativeFrame;
+
+
+/**
+ * The stack array of an iterative version.
+ *
+ * @field IterativeFrame* frames - The stack frames, from the bottom up.
+ *
+ * @field Uint32 depth, capacity - The number of stack frames, and the room for them.
+ *
+ * @field Uint16 function - The FUNCTION_* constant the stack frames are recorded with.
+ *
+ * @field Tracer* tracer - The trace to record into.
+ */
+typedef struct IterativeStack {
+    IterativeFrame* frames;
+    Uint32          depth;
+    Uint32          capacity;
+    Uint16          function;
+    Tracer*         tracer;
+} IterativeStack;
+
+
+/**
+ * This function pushes a stack frame onto the stack array, and records the call.
+ * The stack array grows when it is full, which moves the stack frames.
+ *
+ * @param IterativeStack* stack - The stack array.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @return int - 0 on success, -1 if the stack array could not be grown.
+ */
+static int pushFrame(IterativeStack* stack, Sint64 a0, Sint64 a1, Sint64 a2)
+{
+    IterativeFrame* frame;
+
+    if (stack->depth == stack->capacity) {
+        Uint32          capacity = (stack->capacity > 0) ? stack->capacity * 2 : 64;
+        IterativeFrame* frames   = (IterativeFrame*) realloc(stack->frames, capacity * sizeof(IterativeFrame));
+        if (!frames) {
+            return -1;
+        }
+        stack->frames   = frames;
+        stack->capacity = capacity;
+    }
+
+    frame = &stack->frames[stack->depth++];
+    frame->args[0] = a0;
+    frame->args[1] = a1;
+    frame->args[2] = a2;
+    frame->local   = 0;
+    frame->state   = 0;
+
+    traceRecordFrame(stack->tracer, EVENT_PUSH, stack->function, a0, a1, a2,
+                     (Uint64) (size_t) frame, stack->depth * sizeof(IterativeFrame), LIME);
+
+    return 0;
+}
+
+
+/**
+ * This function records the return from the call on top of the stack array, and pops its stack frame.
+ *
+ * @param IterativeStack* stack - The stack array, which must not be empty.
+ */
+static void popFrame(IterativeStack* stack)
+{
+    IterativeFrame* frame = &stack->frames[stack->depth - 1];
+
+    traceRecordFrame(stack->tracer, EVENT_POP, stack->function, frame->args[0], frame->args[1], frame->args[2],
+                     (Uint64) (size_t) frame, stack->depth * sizeof(IterativeFrame), PINK);
+    --stack->depth;
+}
+
+
+/**
+ * The iterative versions of the examples. Each of them makes the same calls in the same order
+ * as its recursive version in recursion_visualized_examples.c, with the arguments of the first
+ * call on its stack array, and stores the same result into value. They return 0 on success,
+ * or -1 if the stack array could not be grown.
+ * The result of the call that just returned is kept in result, where the recursive version
+ * would have the return value of the call.
+ */
+static int factorialIterative(IterativeStack* stack, Sint64 n, Sint64* value)
+{
+    Sint64 result = 0;
+
+    if (pushFrame(stack, n, 0, 0) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+
+        if (frame->state == 0 && frame->args[0] > 1) {
+            frame->state = 1;
+            if (pushFrame(stack, frame->args[0] - 1, 0, 0) != 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        result = (frame->state == 0) ? 1 : exampleMultiply(frame->args[0], result);
+        popFrame(stack);
+    }
+
+    *value = result;
+
+    return 0;
+}
+
+
+static int fibonacciIterative(IterativeStack* stack, Sint64 n, Sint64* value)
+{
+    Sint64 result = 0;
+
+    if (pushFrame(stack, n, 0, 0) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+        Sint64          next;
+
+        if (frame->args[0] < 2) {
+            result = frame->args[0];
+            popFrame(stack);
+            continue;
+        }
+
+        switch (frame->state) {
+        case 0:
+            next = frame->args[0] - 1;
+            break;
+        case 1:
+	    // fibonacci(n - 1) returned, keep it over the call of fibonacci(n - 2).
+            frame->local = result;
+            next = frame->args[0] - 2;
+            break;
+        default:
+            result = exampleAdd(frame->local, result);
+            popFrame(stack);
+            continue;
+        }
+        ++frame->state;
+        if (pushFrame(stack, next, 0, 0) != 0) {
+            return -1;
+        }
+    }
+
+    *value = result;
+
+    return 0;
+}
+
+
+static int hanoiIterative(IterativeStack* stack, Sint64 n, Sint64* value)
+{
+    Sint64 result = 0;
+
+    if (pushFrame(stack, n, 1, 3) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+        Sint64          from  = frame->args[1];
+        Sint64          to    = frame->args[2];
+        Sint64          via   = 6 - from - to;
+        int             pushed;
+
+        if (frame->args[0] <= 0) {
+            result = 0;
+            popFrame(stack);
+            continue;
+        }
+
+        switch (frame->state) {
+        case 0:
+            frame->state = 1;
+            pushed = pushFrame(stack, frame->args[0] - 1, from, via);
+            break;
+        case 1:
+	    // The moves of the first call, and the one of the biggest disk.
+            frame->local = exampleAdd(result, 1);
+            frame->state = 2;
+            pushed = pushFrame(stack, frame->args[0] - 1, via, to);
+            break;
+        default:
+            result = exampleAdd(frame->local, result);
+            popFrame(stack);
+            continue;
+        }
+        if (pushed != 0) {
+            return -1;
+        }
+    }
+
+    *value = result;
+
+    return 0;
+}
+
+
+static int quicksortIterative(IterativeStack* stack, int* array, Sint64 n, Sint64* value)
+{
+    if (pushFrame(stack, 0, n - 1, 0) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+        Sint64          low   = frame->args[0];
+        Sint64          high  = frame->args[1];
+        int             pushed;
+
+        if (low >= high) {
+            popFrame(stack);
+            continue;
+        }
+
+        switch (frame->state) {
+        case 0:
+            frame->local = quicksortPartition(array, low, high);
+            frame->state = 1;
+            pushed = pushFrame(stack, low, frame->local - 1, 0);
+            break;
+        case 1:
+            frame->state = 2;
+            pushed = pushFrame(stack, frame->local + 1, high, 0);
+            break;
+        default:
+            popFrame(stack);
+            continue;
+        }
+        if (pushed != 0) {
+            return -1;
+        }
+    }
+
+    *value = (n > 0) ? n : 0;
+
+    return 0;
+}
+
+
+static int ackermannIterative(IterativeStack* stack, Sint64 m, Sint64 n, Sint64* value)
+{
+    Sint64 result = 0;
+
+    if (pushFrame(stack, m, n, 0) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+        Sint64          a     = frame->args[0];
+        Sint64          b     = frame->args[1];
+        int             pushed;
+
+        if (frame->state == 2 || a == 0) {
+	    // The result of the last call it made is its own, or it is the base case.
+            if (a == 0) {
+                result = b + 1;
+            }
+            popFrame(stack);
+            continue;
+        }
+
+        if (frame->state == 0 && b > 0) {
+	    // ackermann(m - 1, ackermann(m, n - 1)) needs the inner call first.
+            frame->state = 1;
+            pushed = pushFrame(stack, a, b - 1, 0);
+        } else {
+            frame->state = 2;
+            pushed = pushFrame(stack, a - 1, (b > 0) ? result : 1, 0);
+        }
+        if (pushed != 0) {
+            return -1;
+        }
+    }
+
+    *value = result;
+
+    return 0;
+}
+
+
+static int mergesortIterative(IterativeStack* stack, int* array, int* scratch, Sint64 n, Sint64* value)
+{
+    if (pushFrame(stack, 0, n - 1, 0) != 0) {
+        return -1;
+    }
+    while (stack->depth > 0) {
+        IterativeFrame* frame = &stack->frames[stack->depth - 1];
+        Sint64          low   = frame->args[0];
+        Sint64          high  = frame->args[1];
+        int             pushed;
+
+        if (low >= high) {
+            popFrame(stack);
+            continue;
+        }
+
+        switch (frame->state) {
+        case 0:
+            frame->local = low + (high - low) / 2;
+            frame->state = 1;
+            pushed = pushFrame(stack, low, frame->local, 0);
+            break;
+        case 1:
+            frame->state = 2;
+            pushed = pushFrame(stack, frame->local + 1, high, 0);
+            break;
+        default:
+            mergesortMerge(array, scratch, low, frame->local, high);
+            popFrame(stack);
+            continue;
+        }
+        if (pushed != 0) {
+            return -1;
+        }
+    }
+
+    *value = (n > 0) ? n : 0;
+
+    return 0;
+}
+
+
+int runIterative(Tracer* tracer, int function, Sint64 n, Sint64* result)
+{
+    IterativeStack stack;
+    int            status = -1;
+    int*           array;
+    int*           scratch;
+
+    memset(&stack, 0, sizeof(stack));
+    stack.function = (Uint16) function;
+    stack.tracer   = tracer;
+
+    switch (function) {
+    case FUNCTION_FACTORIAL:
+        status = factorialIterative(&stack, n, result);
+        break;
+    case FUNCTION_FIBONACCI:
+        status = fibonacciIterative(&stack, n, result);
+        break;
+    case FUNCTION_HANOI:
+        status = hanoiIterative(&stack, n, result);
+        break;
+    case FUNCTION_QUICKSORT:
+        array = exampleArray(n);
+        if (array) {
+            status = quicksortIterative(&stack, array, n, result);
+            free(array);
+        }
+        break;
+    case FUNCTION_ACKERMANN:
+        status = ackermannIterative(&stack, 2, n, result);
+        break;
+    case FUNCTION_MERGESORT:
+        array   = exampleArray(n);
+        scratch = exampleArray(n);
+        if (array && scratch) {
+            status = mergesortIterative(&stack, array, scratch, n, result);
+        }
+        free(array);
+        free(scratch);
+        break;
+    default:
+        break;
+    }
+
+    free(stack.frames);
+
+    return status;
+}
+
+
+/**
+ * This function opens a hardware counter of the instructions executed by the calling thread
+ * in user space. It starts out disabled.
+ *
+ * @return int - The file descriptor of the counter, or -1 if the kernel does not allow it.
+ */
+static int openInstructionCounter(void)
+{
+#ifdef COMPARE_PERF_EVENT
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+
+/**
+ * This function runs one version once with a Tracer which keeps nothing, and measures it.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param int side - COMPARE_RECURSIVE or COMPARE_ITERATIVE.
+ *
+ * @param int counter - The file descriptor of the instruction counter, or -1.
+ *
+ * @param CompareCost* cost - Receives the cost of the run.
+ *
+ * @return int - 0 on success, -1 if the version could not be run.
+ */
+static int measureRun(int function, Sint64 n, int side, int counter, CompareCost* cost)
+{
+    Tracer tracer;
+    Sint64 result;
+    int    status;
+    Uint64 start;
+    Uint64 ticks;
+
+    if (tracerInit(&tracer, 0, NULL) != 0) {
+        return -1;
+    }
+
+#ifdef COMPARE_PERF_EVENT
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    start  = SDL_GetPerformanceCounter();
+    status = (side == COMPARE_RECURSIVE) ? runExample(&tracer, function, n, &result) :
+                                           runIterative(&tracer, function, n, &result);
+    ticks  = SDL_GetPerformanceCounter() - start;
+
+    cost->instructions = 0;
+    cost->counted      = 0;
+#ifdef COMPARE_PERF_EVENT
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        cost->counted = (read(counter, &cost->instructions, sizeof(cost->instructions)) ==
+                         (ssize_t) sizeof(cost->instructions));
+        if (!cost->counted) {
+            cost->instructions = 0;
+        }
+    }
+#endif
+
+    // Without a ring buffer or room to keep them, the records are only counted.
+    cost->calls       = tracer.dropped / 2;
+    cost->peak        = tracer.peak;
+    cost->nanoseconds = (Uint64) ((double) ticks * 1e9 / SDL_GetPerformanceFrequency());
+    tracerDestroy(&tracer);
+
+    return status;
+}
+
+
+int compareMeasure(int function, Sint64 n, CompareCost* costs)
+{
+    int counter = openInstructionCounter();
+    int failed  = 0;
+    int side;
+    int run;
+
+    for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE && !failed; ++side) {
+        for (run = 0; run < COMPARE_RUNS; ++run) {
+            CompareCost cost;
+
+            if (measureRun(function, n, side, counter, &cost) != 0) {
+                failed = 1;
+                break;
+            }
+            if (run == 0 || cost.nanoseconds < costs[side].nanoseconds) {
+                costs[side].nanoseconds = cost.nanoseconds;
+            }
+            if (run == 0 || cost.instructions < costs[side].instructions) {
+                costs[side].instructions = cost.instructions;
+            }
+            costs[side].calls   = cost.calls;
+            costs[side].peak    = cost.peak;
+            costs[side].counted = cost.counted;
+        }
+    }
+
+#ifdef COMPARE_PERF_EVENT
+    if (counter >= 0) {
+        close(counter);
+    }
+#endif
+
+    return failed ? -1 : 0;
+}
+
+
+int compareThread(void* data)
+{
+    CompareArgs* args = (CompareArgs*) data;
+    Tracer       tracer;
+    Sint64       result;
+    int          status;
+    StackEvent   end;
+
+    if (args->costs) {
+        status = compareMeasure(args->function, args->n, args->costs);
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(args->measured, (status == 0) ? 1 : -1);
+    }
+
+    // Nothing needs to be kept, every record is forwarded to the render loop.
+    tracerInit(&tracer, 0, args->ring);
+    if (args->side == COMPARE_RECURSIVE) {
+        status = runExample(&tracer, args->function, args->n, &result);
+    } else {
+        status = runIterative(&tracer, args->function, args->n, &result);
+    }
+    tracerDestroy(&tracer);
+
+    // Tell the render loop that there is nothing more to play back.
+    memset(&end, 0, sizeof(end));
+    end.type = EVENT_END;
+    ringPush(args->ring, &end);
+
+    return status;
+}
+
+
+/**
+ * This function plays back the records of a version which was started on its own,
+ * without showing them, so that it does not stay stuck on its full ring buffer, and waits for it.
+ *
+ * @param SDL_Thread* thread - The thread of the version.
+ *
+ * @param EventRing* ring - The ring buffer the version records into.
+ */
+static void drainThread(SDL_Thread* thread, EventRing* ring)
+{
+    StackEvent event;
+
+    do {
+        while (!ringPop(ring, &event)) {
+            SDL_Delay(1);
+        }
+    } while (event.type != EVENT_END);
+
+    SDL_WaitThread(thread, NULL);
+}
+
+
+int comparisonInit(Comparison* comparison, EventRing* ring, int function, Sint64 n,
+                   int width, int height, size_t stack_size)
+{
+    int side;
+
+    memset(comparison, 0, sizeof(*comparison));
+    SDL_AtomicSet(&comparison->measured, 0);
+
+    comparison->ring = (EventRing*) malloc(sizeof(EventRing));
+    if (!comparison->ring) {
+        return -1;
+    }
+    ringInit(comparison->ring);
+
+    if (stackViewInit(&comparison->view, width, height, exampleMaxDepth(function, n)) != 0) {
+        free(comparison->ring);
+        comparison->ring = NULL;
+        return -1;
+    }
+    comparison->view.stack_limit = (Uint64) exampleMaxDepth(function, n) * sizeof(IterativeFrame);
+
+    for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE; ++side) {
+        CompareArgs* args = &comparison->args[side];
+
+        args->ring     = (side == COMPARE_RECURSIVE) ? ring : comparison->ring;
+        args->function = function;
+        args->n        = n;
+        args->side     = side;
+        args->costs    = (side == COMPARE_RECURSIVE) ? comparison->costs : NULL;
+        args->measured = &comparison->measured;
+
+        comparison->panes[side].x = side * width;
+        comparison->panes[side].y = 0;
+        comparison->panes[side].w = width;
+        comparison->panes[side].h = height;
+    }
+
+    // The recursive version measures both versions before it records anything, so that
+    // the iterative one, which is stuck on its full ring buffer by then, does not disturb it.
+    comparison->threads[COMPARE_RECURSIVE] = SDL_CreateThreadWithStackSize(compareThread, "recursive", stack_size,
+                                                                           &comparison->args[COMPARE_RECURSIVE]);
+    comparison->threads[COMPARE_ITERATIVE] = SDL_CreateThread(compareThread, "iterative",
+                                                              &comparison->args[COMPARE_ITERATIVE]);
+    if (!comparison->threads[COMPARE_RECURSIVE] || !comparison->threads[COMPARE_ITERATIVE]) {
+        // The version which did start still has to be run to its end before it can be waited for.
+        for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE; ++side) {
+            if (comparison->threads[side]) {
+                drainThread(comparison->threads[side], comparison->args[side].ring);
+                comparison->threads[side] = NULL;
+            }
+            comparison->ended[side] = 1;
+        }
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void comparisonDestroy(Comparison* comparison)
+{
+    int side;
+
+    if (comparison->ended[COMPARE_RECURSIVE] && comparison->ended[COMPARE_ITERATIVE]) {
+        for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE; ++side) {
+            if (comparison->threads[side]) {
+                SDL_WaitThread(comparison->threads[side], NULL);
+                comparison->threads[side] = NULL;
+            }
+        }
+        free(comparison->ring);
+        comparison->ring = NULL;
+    }
+
+    stackViewDestroy(&comparison->view);
+}
+
+
+/**
+ * This function counts one record of a version into its counters.
+ *
+ * @param Comparison* comparison - A pointer to the comparison.
+ *
+ * @param int side - COMPARE_RECURSIVE or COMPARE_ITERATIVE.
+ *
+ * @param const StackEvent* event - The record.
+ */
+static void countRecord(Comparison* comparison, int side, const StackEvent* event)
+{
+    if (event->type == EVENT_PUSH) {
+        ++comparison->calls[side];
+    }
+    if (event->type != EVENT_END && event->stack > comparison->peaks[side]) {
+        comparison->peaks[side] = event->stack;
+    }
+}
+
+
+int comparisonStep(Comparison* comparison, EventRing* ring, StackEvent* event)
+{
+    StackEvent other;
+
+    if (!comparison->has_pending) {
+        if (!ringPop(ring, &comparison->pending)) {
+            return 0;
+        }
+        comparison->has_pending = 1;
+    }
+
+    // Once the iterative version has ended, the recursive one is played back on its own.
+    // That only happens if they did not make the same calls after all.
+    if (!comparison->ended[COMPARE_ITERATIVE]) {
+        if (!ringPop(comparison->ring, &other)) {
+            return 0;
+        }
+        countRecord(comparison, COMPARE_ITERATIVE, &other);
+        if (other.type == EVENT_END) {
+            comparison->ended[COMPARE_ITERATIVE] = 1;
+        } else if (stackViewApply(&comparison->view, &other) != 0) {
+            return -1;
+        }
+    }
+
+    *event = comparison->pending;
+    comparison->has_pending = 0;
+    countRecord(comparison, COMPARE_RECURSIVE, event);
+    if (event->type == EVENT_END) {
+        comparison->ended[COMPARE_RECURSIVE] = 1;
+    }
+
+    return 1;
+}
+
+
+/**
+ * This function writes the counters of one version on top of its pane.
+ *
+ * @param const Comparison* comparison - A pointer to the comparison.
+ *
+ * @param int side - COMPARE_RECURSIVE or COMPARE_ITERATIVE.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with.
+ */
+static void writeCounters(const Comparison* comparison, int side, GlyphAtlas* atlas)
+{
+    const CompareCost* cost = &comparison->costs[side];
+    int                x    = comparison->panes[side].x + COUNTERS_MARGIN;
+    int                y    = comparison->panes[side].y + COUNTERS_MARGIN;
+    char               text[64];
+
+    glyphAtlasText(atlas, x, y, (side == COMPARE_RECURSIVE) ? "recursive, runtime stack" :
+                                                              "iterative, stack array");
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "calls %llu", (unsigned long long) comparison->calls[side]);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "peak %s %llu bytes", (side == COMPARE_RECURSIVE) ? "stack" : "heap",
+                 (unsigned long long) comparison->peaks[side]);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    // What a whole run costs at full speed is known once it was measured.
+    if (SDL_AtomicGet((SDL_atomic_t*) &comparison->measured) == 0) {
+        glyphAtlasText(atlas, x, y, "measuring...");
+        return;
+    }
+    if (SDL_AtomicGet((SDL_atomic_t*) &comparison->measured) < 0) {
+        glyphAtlasText(atlas, x, y, "measuring failed");
+        return;
+    }
+    SDL_MemoryBarrierAcquire();
+
+    SDL_snprintf(text, sizeof(text), "run %.3f ms, %.2f ns/step", cost->nanoseconds / 1e6,
+                 (cost->calls > 0) ? cost->nanoseconds / (2.0 * cost->calls) : 0.0);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    if (cost->counted) {
+        SDL_snprintf(text, sizeof(text), "%.1f instructions/step",
+                     (cost->calls > 0) ? cost->instructions / (2.0 * cost->calls) : 0.0);
+    } else {
+        SDL_snprintf(text, sizeof(text), "instructions not counted");
+    }
+    glyphAtlasText(atlas, x, y, text);
+}
+
+
+void comparisonDraw(Comparison* comparison, const StackView* left, SDL_Renderer* renderer,
+                    GlyphAtlas* atlas, int labels)
+{
+    StackView* view = &comparison->view;
+    SDL_Rect   background;
+    int        side;
+
+    // The iterative version is scrolled and zoomed along with the recursive one.
+    if (view->bytes != left->bytes) {
+        stackViewShowBytes(view, left->bytes);
+    }
+    view->scroll       = left->scroll;
+    view->fit          = left->fit;
+    view->frame_height = left->frame_height;
+
+    // It is drawn in full every time, into its own pane, on the blue background.
+    SDL_RenderSetViewport(renderer, &comparison->panes[COMPARE_ITERATIVE]);
+    background.x = 0;
+    background.y = 0;
+    background.w = comparison->panes[COMPARE_ITERATIVE].w;
+    background.h = comparison->panes[COMPARE_ITERATIVE].h;
+    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+    SDL_RenderFillRect(renderer, &background);
+    stackViewDraw(view, renderer);
+    if (atlas && labels) {
+        stackViewDrawLabels(view, renderer, atlas);
+    }
+    SDL_RenderSetViewport(renderer, NULL);
+
+    if (!atlas) {
+        return;
+    }
+
+    // The counters go on a black band across the top of both panes, in one batch.
+    for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE; ++side) {
+        background   = comparison->panes[side];
+        background.h = COUNTERS_HEIGHT;
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderFillRect(renderer, &background);
+        writeCounters(comparison, side, atlas);
+    }
+    glyphAtlasFlush(atlas, renderer);
+}
+
+
+/**
+ * This is the entry point of the thread of compareBenchmark(), as required by SDL_CreateThread().
+ *
+ * @param void* data - A pointer to the CompareArgs, whose costs receive the measurements.
+ *
+ * @return int - 0 on success, -1 if a version could not be run.
+ */
+static int benchmarkThread(void* data)
+{
+    CompareArgs* args = (CompareArgs*) data;
+
+    return compareMeasure(args->function, args->n, args->costs);
+}
+
+
+int compareBenchmark(int function, Sint64 n, size_t stack_size, FILE* out)
+{
+    CompareCost  costs[2];
+    CompareArgs  args;
+    SDL_Thread*  thread;
+    int          result = -1;
+    int          side;
+
+    memset(costs, 0, sizeof(costs));
+    memset(&args, 0, sizeof(args));
+    args.function = function;
+    args.n        = n;
+    args.costs    = costs;
+
+    thread = SDL_CreateThreadWithStackSize(benchmarkThread, "benchmark", stack_size, &args);
+    if (!thread) {
+        return -1;
+    }
+    SDL_WaitThread(thread, &result);
+    if (result != 0) {
+        return -1;
+    }
+
+    fprintf(out, "version,calls,steps,peak_bytes,nanoseconds,ns_per_step,instructions_per_step\n");
+    for (side = COMPARE_RECURSIVE; side <= COMPARE_ITERATIVE; ++side) {
+        const CompareCost* cost  = &costs[side];
+        double             steps = (cost->calls > 0) ? 2.0 * cost->calls : 1.0;
+
+        fprintf(out, "%s,%llu,%llu,%llu,%llu,%.2f,", (side == COMPARE_RECURSIVE) ? "recursive" : "iterative",
+                (unsigned long long) cost->calls, (unsigned long long) (2 * cost->calls),
+                (unsigned long long) cost->peak, (unsigned long long) cost->nanoseconds,
+                cost->nanoseconds / steps);
+        if (cost->counted) {
+            fprintf(out, "%.1f", cost->instructions / steps);
+        }
+        fprintf(out, "\n");
+    }
+
+    return 0;
+}
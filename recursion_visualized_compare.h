@@ -0,0 +1,326 @@
+/**
+ * @file    recursion_visualized_compare.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the comparison mode, which runs a traced recursive
+ * function next to an iterative version of it, to show what the recursion costs.
+ *
+ * The iterative version of every example keeps its stack frames in an array on the heap,
+ * which it pushes and pops by hand, where the recursive version has the runtime stack do it.
+ * A stack frame of the array holds the arguments of the call, one local variable, and how far
+ * the call has got, so that the loop knows where to go on when the call it made returns.
+ * Both versions make the same calls in the same order, and record them the same way, so the
+ * render loop plays back one record of each at every step, and the two stacks move in lockstep.
+ * The iterative version records the stack frames of its array, with their addresses there,
+ * and the bytes of the array in use instead of the bytes of the runtime stack.
+ *
+ * The window is split in two: the recursive version on the left, and the iterative one on the right.
+ * On top of each side are its counters: the calls and the peak bytes of stack or heap in use so far,
+ * which go up as the animation plays, and what a whole run costs at full speed, without the
+ * animation: the wall time, and the time and the instructions per step. These are measured
+ * before the animation starts, by running each version COMPARE_RUNS times with nothing but
+ * the Tracer, and taking the fastest run. The instructions are counted by the hardware,
+ * with perf_event_open() of Linux, where the kernel allows it.
+ *
+ * In the headless mode, only the measurements are made, and written to stdout as CSV:
+ *   version,calls,steps,peak_bytes,nanoseconds,ns_per_step,instructions_per_step
+ * instructions_per_step is left empty where the instructions could not be counted.
+ */
+
+#ifndef RECURSION_VISUALIZED_COMPARE_H
+#define RECURSION_VISUALIZED_COMPARE_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"       // StackEvent, EventRing
+#include "recursion_visualized_stackview.h"  // StackView
+#include "recursion_visualized_font.h"       // GlyphAtlas
+
+/* The Visualizer has a Comparison, and recursion_visualized_trace.h includes the header of the
+   Visualizer, so the Tracer can only be declared here. It is defined in recursion_visualized_trace.h. */
+struct Tracer;
+
+/* How many times each version is run for the measurements. The fastest run counts. */
+#define COMPARE_RUNS 5
+
+/* The sides of the comparison. */
+#define COMPARE_RECURSIVE 0
+#define COMPARE_ITERATIVE 1
+
+
+/**
+ * What a whole run of one version costs.
+ *
+ * @field Uint64 calls - The number of calls, which is half the number of steps.
+ *
+ * @field Uint64 peak - The most bytes of the runtime stack, or of the stack array, in use at once.
+ *
+ * @field Uint64 nanoseconds - The wall time of the fastest run.
+ *
+ * @field Uint64 instructions - The instructions executed by the fastest run, or 0 if they were not counted.
+ *
+ * @field int counted - Nonzero if the instructions could be counted.
+ */
+typedef struct CompareCost {
+    Uint64 calls;
+    Uint64 peak;
+    Uint64 nanoseconds;
+    Uint64 instructions;
+    int    counted;
+} CompareCost;
+
+
+/**
+ * The arguments of a thread which runs one version of the comparison.
+ *
+ * @field EventRing* ring - The ring buffer the records are forwarded into.
+ *
+ * @field int function - The FUNCTION_* constant of the example.
+ *
+ * @field Sint64 n - The problem size.
+ *
+ * @field int side - COMPARE_RECURSIVE or COMPARE_ITERATIVE.
+ *
+ * @field CompareCost* costs - If not NULL, the thread measures both versions into costs[COMPARE_RECURSIVE]
+ *                             and costs[COMPARE_ITERATIVE] before it starts recording.
+ *
+ * @field SDL_atomic_t* measured - Set to 1 once the costs are measured, or to -1 if measuring them failed.
+ */
+typedef struct CompareArgs {
+    EventRing*    ring;
+    int           function;
+    Sint64        n;
+    int           side;
+    CompareCost*  costs;
+    SDL_atomic_t* measured;
+} CompareArgs;
+
+
+/**
+ * The comparison between the recursive and the iterative version of an example.
+ *
+ * @field StackView view - The stack array of the iterative version. The recursive version
+ *                         uses the stack view of the Visualizer.
+ *
+ * @field EventRing* ring - The ring buffer of the iterative version.
+ *
+ * @field SDL_Thread* threads[2] - The threads of both versions.
+ *
+ * @field CompareArgs args[2] - Their arguments.
+ *
+ * @field CompareCost costs[2] - What a whole run of each version costs, once measured is set.
+ *
+ * @field SDL_atomic_t measured - Set by the thread of the recursive version once it measured both,
+ *                                to 1, or to -1 if measuring them failed.
+ *
+ * @field StackEvent pending, int has_pending - A record of the recursive version which waits
+ *                                              for the one of the iterative version.
+ *
+ * @field int ended[2] - Nonzero once each version has sent its EVENT_END record, and it was played back.
+ *
+ * @field Uint64 calls[2], peaks[2] - The calls and the peak bytes in use played back so far.
+ *
+ * @field SDL_Rect panes[2] - Where the two versions are drawn in the window.
+ */
+typedef struct Comparison {
+    StackView    view;
+    EventRing*   ring;
+    SDL_Thread*  threads[2];
+    CompareArgs  args[2];
+    CompareCost  costs[2];
+    SDL_atomic_t measured;
+    StackEvent   pending;
+    int          has_pending;
+    int          ended[2];
+    Uint64       calls[2];
+    Uint64       peaks[2];
+    SDL_Rect     panes[2];
+} Comparison;
+
+
+/**
+ * This function runs the iterative version of one example for the problem size n, the same way
+ * runExample() runs the recursive one.
+ *
+ * @param Tracer* tracer - The trace to record into.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param Sint64* result - Receives the same result as the recursive version.
+ *
+ * @return int - 0 on success, -1 if it could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int runIterative(struct Tracer* tracer, int function, Sint64 n, Sint64* result);
+
+
+/**
+ * This function measures what a whole run of both versions of an example costs.
+ * The recursive version needs a runtime stack as deep as it recurses.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param CompareCost* costs - Receives the costs of the recursive and of the iterative version.
+ *
+ * @return int - 0 on success, -1 if a version could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int compareMeasure(int function, Sint64 n, CompareCost* costs);
+
+
+/**
+ * This is the entry point of the thread of one version, as required by SDL_CreateThread().
+ * It measures both versions first if asked to, then runs its version, forwarding every
+ * record into its ring buffer, and ends it with an EVENT_END record.
+ *
+ * @param void* data - A pointer to the CompareArgs.
+ *
+ * @return int - 0 on success, -1 if the version could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int compareThread(void* data);
+
+
+/**
+ * This function sets up the comparison and starts the threads of both versions.
+ *
+ * @param Comparison* comparison - A pointer to the comparison to initialize.
+ *
+ * @param EventRing* ring - The ring buffer the recursive version records into.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param int width, int height - The size of each of the two panes, in pixels.
+ *
+ * @param size_t stack_size - The size of the runtime stack of the recursive version.
+ *
+ * @return int - 0 on success, -1 if the memory or the threads could not be had.
+ *               If only one of the threads could be started, it is run to its end and waited for,
+ *               so comparisonDestroy() can deallocate everything.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int comparisonInit(Comparison* comparison, EventRing* ring, int function, Sint64 n,
+                   int width, int height, size_t stack_size);
+
+
+/**
+ * This function waits for the threads if both versions have ended, and deallocates the comparison.
+ * Threads which are still running are left alone, since they cannot be cancelled,
+ * and so is the ring buffer they record into. That only happens when the program exits early.
+ *
+ * @param Comparison* comparison - A pointer to the comparison.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void comparisonDestroy(Comparison* comparison);
+
+
+/**
+ * This function plays back one step of both versions in lockstep: it takes the next record
+ * of the recursive version out of its ring buffer, and the matching record of the iterative
+ * version, which it plays back into the stack view of the comparison, and counts both.
+ *
+ * @param Comparison* comparison - A pointer to the comparison.
+ *
+ * @param EventRing* ring - The ring buffer of the recursive version.
+ *
+ * @param StackEvent* event - Receives the record of the recursive version, for the caller to play back.
+ *
+ * @return int - 1 if a step was taken, 0 if a version has not made its next record yet,
+ *               -1 if the stack view could not be grown.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int comparisonStep(Comparison* comparison, EventRing* ring, StackEvent* event);
+
+
+/**
+ * This function draws the iterative version into the right pane, with the same viewport
+ * as the stack view of the recursive version in the left pane, and the counters on top of both.
+ *
+ * @param Comparison* comparison - A pointer to the comparison.
+ *
+ * @param const StackView* left - The stack view of the recursive version.
+ *
+ * @param SDL_Renderer* renderer - The renderer.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with, or NULL to leave out the counters.
+ *
+ * @param int labels - Nonzero to label the stack frames of the iterative version as well.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void comparisonDraw(Comparison* comparison, const StackView* left, SDL_Renderer* renderer,
+                    GlyphAtlas* atlas, int labels);
+
+
+/**
+ * This function measures both versions of an example on a thread with a big enough runtime stack,
+ * and writes the costs as CSV, with a header line.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param size_t stack_size - The size of the runtime stack of the recursive version.
+ *
+ * @param FILE* out - Where to write the CSV.
+ *
+ * @return int - 0 on success, -1 if the thread could not be created or a version could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int compareBenchmark(int function, Sint64 n, size_t stack_size, FILE* out);
+
+#endif /* RECURSION_VISUALIZED_COMPARE_H */
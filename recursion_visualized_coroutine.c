@@ -0,0 +1,181 @@
+/**
+ * @file    recursion_visualized_coroutine.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the coroutine functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stddef.h>  // C standard definitions - for size_t, NULL
+
+#include <sys/mman.h>  // POSIX - for mmap(), mprotect(), munmap()
+#include <unistd.h>    // POSIX - for sysconf()
+
+#include "recursion_visualized_coroutine.h"
+
+
+/* The coroutine which is being resumed. Its function is started from here the first time,
+   since a new runtime stack cannot be handed any arguments. */
+static Coroutine* starting_coroutine = NULL;
+
+
+#ifndef COROUTINE_UCONTEXT
+/**
+ * This function saves the registers which a function call has to keep on the running
+ * runtime stack, stores the stack pointer, switches to the other runtime stack,
+ * and loads the registers which were saved on top of it.
+ * It returns on the other runtime stack, to wherever that one switched away from.
+ *
+ * @param void** save - Receives the stack pointer of the running side.
+ *
+ * @param void* load - The stack pointer of the side to switch to.
+ */
+void coroutineSwitch(void** save, void* load) __asm__("rv_coroutine_switch");
+
+__asm__(
+    ".text\n"
+    ".globl rv_coroutine_switch\n"
+    "rv_coroutine_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    movq  %rsp, (%rdi)\n"
+    "    movq  %rsi, %rsp\n"
+    "    popq  %r15\n"
+    "    popq  %r14\n"
+    "    popq  %r13\n"
+    "    popq  %r12\n"
+    "    popq  %rbx\n"
+    "    popq  %rbp\n"
+    "    ret\n"
+);
+
+/* The number of registers coroutineSwitch() saves on the runtime stack. */
+#define COROUTINE_SAVED_REGISTERS 6
+#endif
+
+
+/**
+ * This function is the bottom of the runtime stack of every coroutine.
+ * It calls the function of the coroutine, and when that returns,
+ * it goes back to the render loop for the last time.
+ */
+static void coroutineEntry(void)
+{
+    Coroutine* coroutine = starting_coroutine;
+
+    coroutine->result   = coroutine->function(coroutine->data);
+    coroutine->finished = 1;
+
+    // The coroutine is never resumed again, so this never returns.
+#ifdef COROUTINE_UCONTEXT
+    setcontext(&coroutine->caller_context);
+#else
+    coroutineSwitch(&coroutine->stack_pointer, coroutine->caller_pointer);
+#endif
+}
+
+
+int coroutineInit(Coroutine* coroutine, size_t stack_size, SDL_ThreadFunction function, void* data)
+{
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    Uint8* stack;
+
+    // The stack is rounded up to whole pages, and one more page is mapped below it as the guard.
+    stack_size = (stack_size + page - 1) / page * page;
+
+    coroutine->function = function;
+    coroutine->data     = data;
+    coroutine->result   = 0;
+    coroutine->finished = 0;
+    coroutine->size     = stack_size + page;
+    coroutine->memory   = mmap(NULL, coroutine->size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (coroutine->memory == MAP_FAILED) {
+        coroutine->memory = NULL;
+        return -1;
+    }
+    if (mprotect(coroutine->memory, page, PROT_NONE) != 0) {
+        munmap(coroutine->memory, coroutine->size);
+        coroutine->memory = NULL;
+        return -1;
+    }
+    stack = (Uint8*) coroutine->memory + page;
+
+#ifdef COROUTINE_UCONTEXT
+    if (getcontext(&coroutine->context) != 0) {
+        munmap(coroutine->memory, coroutine->size);
+        coroutine->memory = NULL;
+        return -1;
+    }
+    coroutine->context.uc_stack.ss_sp   = stack;
+    coroutine->context.uc_stack.ss_size = stack_size;
+    coroutine->context.uc_link          = NULL;
+    makecontext(&coroutine->context, coroutineEntry, 0);
+#else
+    {
+	// The first switch to the coroutine pops zeroed registers off the top of its stack,
+	// and then returns into coroutineEntry(), as if it had been called from address 0.
+	// The stack pointer is then 8 bytes short of a multiple of 16, as after any call.
+        void** top = (void**) (stack + stack_size) - (COROUTINE_SAVED_REGISTERS + 2);
+        int    i;
+
+        for (i = 0; i < COROUTINE_SAVED_REGISTERS; ++i) {
+            top[i] = NULL;
+        }
+        top[COROUTINE_SAVED_REGISTERS]     = (void*) coroutineEntry;
+        top[COROUTINE_SAVED_REGISTERS + 1] = NULL;
+
+        coroutine->stack_pointer  = top;
+        coroutine->caller_pointer = NULL;
+    }
+#endif
+
+    return 0;
+}
+
+
+int coroutineResume(Coroutine* coroutine)
+{
+    if (coroutine->finished) {
+        return 0;
+    }
+
+    starting_coroutine = coroutine;
+#ifdef COROUTINE_UCONTEXT
+    swapcontext(&coroutine->caller_context, &coroutine->context);
+#else
+    coroutineSwitch(&coroutine->caller_pointer, coroutine->stack_pointer);
+#endif
+
+    return !coroutine->finished;
+}
+
+
+void coroutineYield(Coroutine* coroutine)
+{
+#ifdef COROUTINE_UCONTEXT
+    swapcontext(&coroutine->context, &coroutine->caller_context);
+#else
+    coroutineSwitch(&coroutine->stack_pointer, coroutine->caller_pointer);
+#endif
+}
+
+
+void coroutineDestroy(Coroutine* coroutine)
+{
+    if (coroutine->memory) {
+        munmap(coroutine->memory, coroutine->size);
+        coroutine->memory = NULL;
+    }
+}
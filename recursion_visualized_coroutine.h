@@ -0,0 +1,153 @@
+/**
+ * @file    recursion_visualized_coroutine.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the coroutine, which runs the recursion
+ * on the main thread instead of on a thread of its own.
+ *
+ * A coroutine is a function with a runtime stack of its own. The render loop resumes it,
+ * and it runs on its own stack, as deep into the recursion as it likes, until it yields.
+ * Then the render loop goes on exactly where it was, and the next time it resumes
+ * the coroutine, the recursion goes on exactly where it yielded. The stack frames of the
+ * recursion stay on the runtime stack of the coroutine in between, real and unchanged.
+ * So the recursion still runs on a real call stack, but the render loop decides when it runs:
+ * it can be stepped, paused or cancelled without any other thread.
+ *
+ * Switching between the render loop and the coroutine only saves the registers which a
+ * function call has to keep, and loads those of the other side. On x86-64 this is done by
+ * a few instructions of assembly, and takes about 15 nanoseconds. On other processors,
+ * swapcontext() of POSIX is used, which is some 20 times slower, because it also saves
+ * the signal mask with a system call.
+ *
+ * The runtime stack of a coroutine is memory-mapped, with a guard page below it,
+ * so a recursion which runs out of stack crashes instead of overwriting other memory.
+ * Coroutines need a POSIX system.
+ */
+
+#ifndef RECURSION_VISUALIZED_COROUTINE_H
+#define RECURSION_VISUALIZED_COROUTINE_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stddef.h>  // C standard definitions - for size_t
+
+#if !defined(__x86_64__) || defined(_WIN32)
+#include <ucontext.h>  // POSIX - for ucontext_t
+#define COROUTINE_UCONTEXT 1
+#endif
+
+
+/**
+ * A coroutine, and the render loop which resumes it.
+ *
+ * @field SDL_ThreadFunction function, void* data - The function which the coroutine runs,
+ *                           and its argument, in the same form as for SDL_CreateThread().
+ *
+ * @field int result - What the function returned, once it has finished.
+ *
+ * @field int finished - Nonzero once the function has returned.
+ *
+ * @field void* memory, size_t size - The memory mapping of the runtime stack, including the guard page.
+ *
+ * @field void* stack_pointer, caller_pointer - The stack pointer of the coroutine while it does not run,
+ *                                              and of the render loop while the coroutine runs,
+ *                                              with the registers saved on top of it.
+ *
+ * @field ucontext_t context, caller_context - The same, on processors without the assembly.
+ */
+typedef struct Coroutine {
+    SDL_ThreadFunction function;
+    void*              data;
+    int                result;
+    int                finished;
+    void*              memory;
+    size_t             size;
+#ifdef COROUTINE_UCONTEXT
+    ucontext_t         context;
+    ucontext_t         caller_context;
+#else
+    void*              stack_pointer;
+    void*              caller_pointer;
+#endif
+} Coroutine;
+
+
+/**
+ * This function allocates the runtime stack of a coroutine, and prepares it
+ * to call the function the first time it is resumed.
+ *
+ * @param Coroutine* coroutine - A pointer to the coroutine to initialize.
+ *
+ * @param size_t stack_size - The size of its runtime stack in bytes. The memory is only
+ *                            committed as the stack grows into it.
+ *
+ * @param SDL_ThreadFunction function - The function to run.
+ *
+ * @param void* data - The argument to pass to the function.
+ *
+ * @return int - 0 on success, -1 if the runtime stack could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int coroutineInit(Coroutine* coroutine, size_t stack_size, SDL_ThreadFunction function, void* data);
+
+
+/**
+ * This function runs the coroutine until it yields, or until its function returns.
+ * It must only be called from outside of the coroutine.
+ *
+ * @param Coroutine* coroutine - A pointer to the coroutine.
+ *
+ * @return int - 1 if the coroutine yielded and can be resumed again, 0 if it has finished.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int coroutineResume(Coroutine* coroutine);
+
+
+/**
+ * This function suspends the coroutine, and goes back to where it was resumed from.
+ * It returns when the coroutine is resumed the next time.
+ * It must only be called from inside of the coroutine.
+ *
+ * @param Coroutine* coroutine - A pointer to the running coroutine.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void coroutineYield(Coroutine* coroutine);
+
+
+/**
+ * This function deallocates the runtime stack of a coroutine. If the coroutine has not
+ * finished, it is cancelled: the stack frames still on its runtime stack are dropped
+ * without ever returning, so the function must not hold anything else that needs freeing.
+ *
+ * @param Coroutine* coroutine - A pointer to the coroutine, which must not be running.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void coroutineDestroy(Coroutine* coroutine);
+
+#endif /* RECURSION_VISUALIZED_COROUTINE_H */
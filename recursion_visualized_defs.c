@@ -14,39 +14,228 @@
 
 #include "SDL.h"     // Simple DirectMedia Layer API structures and functions
 #include <stdlib.h>  // C standard library - for exit(), EXIT_SUCCESS, EXIT_FAILURE
+#include <stdio.h>   // C standard input/output - for printf()
+#include <string.h>  // C strings - for memcpy(), memset()
 
 #include "recursion_visualized_header.h"
+#include "recursion_visualized_trace.h"  // traceTicks(), traceStackPointer(), FUNCTION_BUNNY
 
 
-void bunny(SDL_Renderer* renderer, SDL_Window* window, SDL_Rect* rectangle, SDL_Event* event)
+void bunny(EventRing* ring, SDL_Rect* rectangle, Uint32 depth, Uint32 max_depth, Uint64 stack_base)
 {
-    handleEvents(renderer, window, event);
+    StackEvent event;
+    event.ticks    = traceTicks();
+    event.address  = traceFrameAddress();
+    event.stack    = traceStackUsed(stack_base, traceStackPointer());
+    event.args[0]  = rectangle->y;
+    event.args[1]  = 0;
+    event.args[2]  = 0;
+    event.function = FUNCTION_BUNNY;
+    event.type     = EVENT_PUSH;
+    event.color    = LIME;
+    event.depth    = depth;
+    event.rect     = *rectangle;
+    ringPush(ring, &event);
 
-    drawStack(renderer, rectangle, LIME);
-
-    if (rectangle->y == 90) {
+    if (depth == max_depth) {
 	// reached the max, or base case.
         return;
     } else {
 	// going up the stack.
         rectangle->y -= 50;
 
-	bunny(renderer, window, rectangle, event);
+	bunny(ring, rectangle, depth + 1, max_depth, stack_base);
     }
 
     // going down the stack.
     rectangle->y += 50;
 
-    drawStack(renderer, rectangle, PINK);
-
-    handleEvents(renderer, window, event);
+    event.ticks    = traceTicks();
+    event.args[0]  = rectangle->y;
+    event.type     = EVENT_POP;
+    event.color    = PINK;
+    event.depth    = depth;
+    event.rect     = *rectangle;
+    ringPush(ring, &event);
 
     return;
 }
 
 
-void handleEvents(SDL_Renderer* renderer, SDL_Window* window, SDL_Event* event)
+int recursionThread(void* data)
+{
+    RecursionArgs* args = (RecursionArgs*) data;
+
+    // The stack frames of bunny() start right below the stack pointer of this function.
+    bunny(args->ring, &args->box, 1, args->max_depth, traceStackPointer());
+
+    // Tell the render loop that there is nothing more to play back.
+    StackEvent end;
+    memset(&end, 0, sizeof(end));
+    end.type = EVENT_END;
+    end.rect = args->box;
+    ringPush(args->ring, &end);
+
+    return 0;
+}
+
+
+/**
+ * This function tells when the frame about to be presented is shown in the exported animation.
+ *
+ * @param const Visualizer* vis - A pointer to the Visualizer.
+ *
+ * @return Uint32 - The time in milliseconds: the real time in the windowed mode,
+ *                  and one step per frame at the animation rate in the headless mode.
+ */
+static Uint32 frameTime(const Visualizer* vis)
+{
+    if (vis->headless && vis->scheduler) {
+        return (Uint32) (vis->frame * 1000.0 / vis->scheduler->steps_per_second);
+    }
+
+    return SDL_GetTicks();
+}
+
+
+void destroyVisualizer(Visualizer* vis)
+{
+    if (vis->hud) {
+        if (vis->hud->csv_path && hudWriteCsv(vis->hud, vis->hud->csv_path) != 0) {
+            fprintf(stderr, "error - Writing the frame timings into %s failed\n", vis->hud->csv_path);
+        }
+        free(vis->hud);
+        vis->hud = NULL;
+    }
+    if (vis->gif) {
+        if (gifWriterClose(vis->gif, frameTime(vis)) != 0) {
+            fprintf(stderr, "error - Writing the animated GIF failed\n");
+        }
+        vis->gif = NULL;
+    }
+    if (vis->backbuffer) {
+        SDL_DestroyTexture(vis->backbuffer);
+        vis->backbuffer = NULL;
+    }
+    if (vis->raster) {
+        rasterDestroy(vis->raster);
+        free(vis->raster);
+        vis->raster = NULL;
+    }
+    if (vis->labels) {
+        glyphAtlasDestroy(vis->labels);
+        vis->labels = NULL;
+    }
+    if (vis->renderer) {
+        SDL_DestroyRenderer(vis->renderer);
+        vis->renderer = NULL;
+    }
+    if (vis->window) {
+        SDL_DestroyWindow(vis->window);
+        vis->window = NULL;
+    }
+    if (vis->surface) {
+        SDL_FreeSurface(vis->surface);
+        vis->surface = NULL;
+    }
+    stackViewDestroy(&vis->view);
+    callTreeDestroy(&vis->tree);
+    if (vis->timeline) {
+        timelineDestroy(vis->timeline);
+        vis->timeline = NULL;
+    }
+    if (vis->history) {
+        historyDestroy(vis->history);
+        vis->history = NULL;
+    }
+    if (vis->comparison) {
+        comparisonDestroy(vis->comparison);
+        vis->comparison = NULL;
+    }
+    if (vis->parallel) {
+        parallelDestroy(vis->parallel);
+        vis->parallel = NULL;
+    }
+}
+
+
+/**
+ * This function shows in the title of the window whether the animation is paused and at what rate
+ * it plays, which step of the trace file being replayed, or of the history that was rewound, is shown,
+ * and while the stack frames are drawn in proportion to their real size,
+ * how many bytes of the runtime stack are in use against its size, and the size and the
+ * address of the stack frame on top.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer.
+ */
+static void updateTitle(Visualizer* vis)
+{
+    const StackView* view = &vis->view;
+    char             title[192];
+    size_t           length;
+
+    if (!vis->window) {
+        return;
+    }
+
+    length = SDL_snprintf(title, sizeof(title), "Recursion Visualized");
+    if (vis->scheduler) {
+        length += SDL_snprintf(title + length, sizeof(title) - length, " - %s%g steps/s",
+                               vis->scheduler->paused ? "paused, " : "",
+                               vis->scheduler->steps_per_second);
+    }
+    if (vis->timeline) {
+        length += SDL_snprintf(title + length, sizeof(title) - length, " - step %llu of %llu",
+                               (unsigned long long) vis->timeline->step,
+                               (unsigned long long) timelineEnd(vis->timeline));
+    } else if (vis->history && vis->history->step < vis->history->count) {
+        length += SDL_snprintf(title + length, sizeof(title) - length, " - step %llu of %llu",
+                               (unsigned long long) vis->history->step,
+                               (unsigned long long) vis->history->count);
+    }
+    if (view->bytes && view->depth > 0) {
+        Uint64 used  = view->stack[view->depth - 1];
+        Uint64 frame = (view->depth > 1) ? used - view->stack[view->depth - 2] : used;
+
+        SDL_snprintf(title + length, sizeof(title) - length,
+                     " - stack %llu of %llu bytes, top frame %llu bytes at 0x%llx",
+                     (unsigned long long) used, (unsigned long long) view->stack_limit,
+                     (unsigned long long) frame, (unsigned long long) view->address);
+    }
+
+    SDL_SetWindowTitle(vis->window, title);
+}
+
+
+/**
+ * This function jumps to another step of the trace file being replayed, or of the history
+ * of the live run, and shows the step in the title of the window.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer, which has a timeline or a history.
+ *
+ * @param Sint64 step - The step to jump to. It is clamped to the steps there are.
+ */
+static void seekTimeline(Visualizer* vis, Sint64 step)
+{
+    if (step < 0) {
+        step = 0;
+    }
+    if (vis->timeline && timelineSeek(vis->timeline, &vis->view, &vis->tree, (Uint64) step) != 0) {
+        fprintf(stderr, "error - Jumping along the timeline failed\n");
+    }
+    if (vis->history && historySeek(vis->history, &vis->view, &vis->tree, (Uint64) step) != 0) {
+        fprintf(stderr, "error - Jumping along the history failed\n");
+    }
+    vis->dirty = 1;
+
+    updateTitle(vis);
+}
+
+
+void handleEvents(Visualizer* vis, SDL_Event* event)
 {
+    Uint64 start = SDL_GetPerformanceCounter();
+
     while (SDL_PollEvent(event)) {
 	// If the user clicks the (X), the SDL_QUIT or SDL_WINDOWEVENT_CLOSE event
 	// may be generated. This code reacts to the recieved event by destroying the
@@ -54,36 +243,412 @@ void handleEvents(SDL_Renderer* renderer, SDL_Window* window, SDL_Event* event)
 	// Then it quits the SDL subsystems and exits the program with an appropriate
 	// return code providing information for the OS.
         if (event->type == SDL_QUIT || event->type == SDL_WINDOWEVENT_CLOSE) {
-	    SDL_DestroyWindow(window);
-	    SDL_DestroyRenderer(renderer);
+	    destroyVisualizer(vis);
 	    SDL_Quit();
 	    exit(EXIT_SUCCESS);
 	}
+
+	// The contents of the window, or of the backbuffer, were lost, so redraw everything.
+        if (event->type == SDL_WINDOWEVENT &&
+            (event->window.event == SDL_WINDOWEVENT_EXPOSED ||
+             event->window.event == SDL_WINDOWEVENT_RESIZED ||
+             event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)) {
+            stackViewInvalidate(&vis->view);
+        }
+        if (event->type == SDL_RENDER_TARGETS_RESET || event->type == SDL_RENDER_DEVICE_RESET) {
+            stackViewInvalidate(&vis->view);
+        }
+
+	// Anything the user does may move the viewport, so the next frame is drawn.
+        if (event->type == SDL_KEYDOWN || event->type == SDL_MOUSEWHEEL || event->type == SDL_WINDOWEVENT) {
+            vis->dirty = 1;
+        }
+
+	// Space pauses and resumes the animation, and Z and X slow it down and speed it up.
+	// Stepping pauses it first. A trace file being replayed is stepped along its timeline below,
+	// and so is a live run which keeps its history, until it is back at the end of it.
+	// Without a history, a live run can only be stepped forwards, since its records are gone once played back.
+        if (vis->scheduler && event->type == SDL_KEYDOWN) {
+            Scheduler*  sched = vis->scheduler;
+            SDL_Keycode key   = event->key.keysym.sym;
+
+            if (key == SDLK_SPACE) {
+                schedulerSetPaused(sched, !sched->paused);
+                updateTitle(vis);
+                continue;
+            } else if (key == SDLK_z) {
+                schedulerSetRate(sched, sched->steps_per_second / SCHEDULER_RATE_FACTOR);
+                updateTitle(vis);
+                continue;
+            } else if (key == SDLK_x) {
+                schedulerSetRate(sched, sched->steps_per_second * SCHEDULER_RATE_FACTOR);
+                updateTitle(vis);
+                continue;
+            } else if (key == SDLK_PERIOD && !vis->timeline &&
+                       (!vis->history || vis->history->step == vis->history->count)) {
+                schedulerSingleStep(sched);
+                updateTitle(vis);
+                continue;
+            } else if ((key == SDLK_COMMA || key == SDLK_PERIOD) && (vis->timeline || vis->history) &&
+                       !sched->paused) {
+                schedulerSetPaused(sched, 1);
+            }
+        }
+
+	// While a trace file is replayed, the keyboard and the mouse scrub along its timeline,
+	// and along the history of a live run the same way.
+        if (vis->timeline || vis->history) {
+            Sint64 step = (Sint64) (vis->timeline ? vis->timeline->step : vis->history->step);
+            Sint64 end  = (Sint64) (vis->timeline ? timelineEnd(vis->timeline) : vis->history->count);
+            Sint64 jump = (end / 100 > 0) ? end / 100 : 1;
+
+            if (event->type == SDL_KEYDOWN) {
+                SDL_Keycode key = event->key.keysym.sym;
+
+                if (key == SDLK_COMMA) {
+                    seekTimeline(vis, step - 1);
+                    continue;
+                } else if (key == SDLK_PERIOD) {
+                    seekTimeline(vis, step + 1);
+                    continue;
+                } else if (key == SDLK_LEFTBRACKET) {
+                    seekTimeline(vis, step - jump);
+                    continue;
+                } else if (key == SDLK_RIGHTBRACKET) {
+                    seekTimeline(vis, step + jump);
+                    continue;
+                } else if (key >= SDLK_0 && key <= SDLK_9) {
+                    seekTimeline(vis, end * (key - SDLK_0) / 10);
+                    continue;
+                }
+            }
+            if ((event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT) ||
+                (event->type == SDL_MOUSEMOTION && (event->motion.state & SDL_BUTTON_LMASK))) {
+                int x = (event->type == SDL_MOUSEMOTION) ? event->motion.x : event->button.x;
+                seekTimeline(vis, (Sint64) ((double) end * x / (vis->view.width - 1)));
+                continue;
+            }
+        }
+
+	// T switches between the stack view and the call tree.
+	// The stack view is redrawn in full when it comes back, since the backbuffer was overwritten.
+        if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_t) {
+            vis->show_tree = !vis->show_tree;
+            stackViewInvalidate(&vis->view);
+            continue;
+        }
+
+	// L switches the labels of the stack frames on and off.
+	// They are drawn on top of the backbuffer, so it does not have to be redrawn.
+        if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_l) {
+            vis->show_labels = !vis->show_labels;
+            continue;
+        }
+
+	// H shows and hides the overlay of the frame timings, which is drawn on top of the backbuffer too.
+        if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_h && vis->hud) {
+            vis->hud->shown = !vis->hud->shown;
+            continue;
+        }
+
+	// While the call tree is shown, the mouse wheel and the keyboard move its viewport instead.
+        if (vis->show_tree) {
+            if (event->type == SDL_MOUSEWHEEL) {
+                callTreeScroll(&vis->tree, -event->wheel.y * FRAME_SIZE);
+            }
+            if (event->type == SDL_KEYDOWN) {
+                switch (event->key.keysym.sym) {
+                case SDLK_LEFT:
+                    callTreeScroll(&vis->tree, -FRAME_SIZE);
+                    break;
+                case SDLK_RIGHT:
+                    callTreeScroll(&vis->tree, FRAME_SIZE);
+                    break;
+                case SDLK_PLUS:
+                case SDLK_EQUALS:
+                    callTreeZoom(&vis->tree, 1);
+                    break;
+                case SDLK_MINUS:
+                    callTreeZoom(&vis->tree, -1);
+                    break;
+                case SDLK_HOME:
+                case SDLK_f:
+                    callTreeFit(&vis->tree);
+                    break;
+                case SDLK_END:
+		    // Zooming by no steps only turns following back on.
+                    callTreeZoom(&vis->tree, 0);
+                    break;
+                default:
+                    break;
+                }
+            }
+            continue;
+        }
+
+	// The mouse wheel scrolls along the stack, up towards its top.
+        if (event->type == SDL_MOUSEWHEEL) {
+            stackViewScroll(&vis->view, -event->wheel.y * FRAME_SIZE);
+        }
+
+	// The keyboard scrolls and zooms the viewport of the stack view.
+        if (event->type == SDL_KEYDOWN) {
+            switch (event->key.keysym.sym) {
+            case SDLK_UP:
+                stackViewScroll(&vis->view, -FRAME_SIZE);
+                break;
+            case SDLK_DOWN:
+                stackViewScroll(&vis->view, FRAME_SIZE);
+                break;
+            case SDLK_PAGEUP:
+                stackViewScroll(&vis->view, -vis->view.height);
+                break;
+            case SDLK_PAGEDOWN:
+                stackViewScroll(&vis->view, vis->view.height);
+                break;
+            case SDLK_PLUS:
+            case SDLK_EQUALS:
+                stackViewZoom(&vis->view, 1);
+                break;
+            case SDLK_MINUS:
+                stackViewZoom(&vis->view, -1);
+                break;
+            case SDLK_HOME:
+            case SDLK_f:
+                stackViewFit(&vis->view);
+                break;
+            case SDLK_END:
+                vis->view.scroll = 0;
+                break;
+            case SDLK_b:
+                stackViewShowBytes(&vis->view, !vis->view.bytes);
+                updateTitle(vis);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    hudTime(vis->hud, HUD_STAGE_EVENTS, start);
+}
+
+
+void holdFrame(Visualizer* vis, SDL_Event* event)
+{
+    Scheduler* sched  = vis->scheduler;
+    Uint32     start  = SDL_GetTicks();
+    Uint32     length = schedulerHoldTime(sched);
+    Uint32     waited = 0;
+
+    while (waited < length || (sched->paused && sched->single_steps == 0)) {
+	// Waits for the rest of the time, or while paused, until the next event.
+        SDL_WaitEventTimeout(NULL, (waited < length) ? (int) (length - waited) : 100);
+
+        handleEvents(vis, event);
+        if (vis->dirty) {
+            drawStack(vis);
+            vis->dirty = 0;
+        }
+
+        waited = SDL_GetTicks() - start;
     }
 }
 
 
-void drawStack(SDL_Renderer* renderer, const SDL_Rect* rectangle, Uint8 color)
+void drawStack(Visualizer* vis)
 {
-    // Draws the blue background.
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
-    SDL_RenderClear(renderer);
+    SDL_Renderer* renderer = vis->renderer;
+
+    // In the comparison mode, the backbuffer goes into the left pane of the window.
+    SDL_Rect* pane = vis->comparison ? &vis->comparison->panes[COMPARE_RECURSIVE] : NULL;
+
+    // The software raster draws into the pixels of the offscreen surface.
+    Raster screen;
+    if (vis->raster) {
+        rasterWrap(&screen, vis->surface->pixels, vis->surface->pitch, vis->surface->w, vis->surface->h,
+                   vis->raster->kernel);
+    }
+
+    // Every stage of the frame is timed from where the one before it ended,
+    // and is closed right after the work it is named for.
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    // The lanes of the workers of a parallel run are drawn in full every time, side by side.
+    if (vis->parallel) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+        SDL_RenderClear(renderer);
+        start = hudTime(vis->hud, HUD_STAGE_CLEAR, start);
+        parallelDraw(vis->parallel, &vis->view, renderer, vis->labels, vis->show_labels);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    } else if (vis->show_tree) {
+	// The call tree is always drawn from scratch, since its layout is stretched as it grows.
+        if (vis->backbuffer) {
+            SDL_SetRenderTarget(renderer, vis->backbuffer);
+        }
+
+	// Draws the blue background, and the calls inside of the viewport.
+        SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+        SDL_RenderClear(renderer);
+        start = hudTime(vis->hud, HUD_STAGE_CLEAR, start);
+        callTreeDraw(&vis->tree, renderer);
+
+        if (vis->backbuffer) {
+            SDL_SetRenderTarget(renderer, NULL);
+            SDL_RenderCopy(renderer, vis->backbuffer, NULL, pane);
+        }
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    } else if (vis->raster) {
+	// The software raster keeps the stack from one frame to the next, like the backbuffer does.
+	// Redraws only the "stack frames" that changed, or else everything from the blue background up.
+        int redrawn = stackViewRasterDirty(&vis->view, vis->raster);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+        if (!redrawn) {
+            rasterSetColor(vis->raster, 0, 0, 255);
+            rasterClear(vis->raster);
+            start = hudTime(vis->hud, HUD_STAGE_CLEAR, start);
+            stackViewRaster(&vis->view, vis->raster);
+            start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+        }
+
+	// Copies the raster into the offscreen surface.
+        rasterCopy(&screen, vis->raster);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    } else if (!vis->backbuffer) {
+	// Without a backbuffer, every frame is drawn from scratch.
+	// Draws the blue background.
+        SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+        SDL_RenderClear(renderer);
+        start = hudTime(vis->hud, HUD_STAGE_CLEAR, start);
+
+	// Draws the "stack frames" inside of the viewport.
+        stackViewDraw(&vis->view, renderer);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    } else {
+        SDL_SetRenderTarget(renderer, vis->backbuffer);
 
-    // Draws the current "stack frame".
-    if (color == LIME) {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 100, 255);
-    } else if (color == PINK) {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 100, 255);
+	// Redraws only the "stack frames" that changed, if the backbuffer still holds the last frame.
+	// Otherwise draws the blue background and all the "stack frames" inside of the viewport.
+        int redrawn = stackViewDrawDirty(&vis->view, renderer);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+        if (!redrawn) {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+            SDL_RenderClear(renderer);
+            start = hudTime(vis->hud, HUD_STAGE_CLEAR, start);
+            stackViewDraw(&vis->view, renderer);
+            start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+        }
+
+	// Copies the backbuffer onto the back buffer of the window.
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_RenderCopy(renderer, vis->backbuffer, NULL, pane);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    }
+
+    // The labels are drawn on top of the stack frames, all of them every time, since they are cheap.
+    // The lanes of a parallel run were labeled along with their stack frames.
+    if (!vis->show_tree && !vis->parallel && vis->raster && vis->show_labels) {
+        stackViewRasterLabels(&vis->view, &screen);
+        start = hudTime(vis->hud, HUD_STAGE_LABELS, start);
+    } else if (!vis->show_tree && !vis->parallel && vis->labels && vis->show_labels) {
+        stackViewDrawLabels(&vis->view, renderer, vis->labels);
+        start = hudTime(vis->hud, HUD_STAGE_LABELS, start);
+    }
+
+    // The counters of the memoization cache go across the top, on top of the stack frames.
+    if (vis->memo && vis->labels) {
+        memoMeterDraw(vis->memo, renderer, vis->labels, vis->view.width);
+        start = hudTime(vis->hud, HUD_STAGE_LABELS, start);
+    }
+
+    // The iterative version is drawn next to it, with the counters of both.
+    if (vis->comparison) {
+        comparisonDraw(vis->comparison, &vis->view, renderer, vis->labels, vis->show_labels);
+        start = hudTime(vis->hud, HUD_STAGE_FILL, start);
+    }
+
+    // The overlay of the frame timings goes on top of everything, and is not timed itself.
+    // With the software raster, it has to be in the surface before the frame is exported.
+    if (vis->hud && vis->hud->shown) {
+        hudDraw(vis->hud, renderer, vis->labels);
+        if (vis->raster) {
+            SDL_RenderFlush(renderer);
+        }
+    }
+
+    // The stack in use changes with every step, so the counter in the title is kept up to date.
+    // The title is also set on the first frame.
+    if (vis->view.bytes || vis->frame == 0) {
+        updateTitle(vis);
     }
-    SDL_RenderFillRect(renderer, rectangle);
 
     // Presents the back buffer onto the front buffer,
     // updating the contents of the renderer.
-    SDL_RenderPresent(renderer);
-
-    // Sleep for 1 second.
-    SDL_Delay(1000);
+    start = SDL_GetPerformanceCounter();
+    presentFrame(vis);
+    if (vis->hud) {
+        hudTime(vis->hud, HUD_STAGE_PRESENT, start);
+        hudCommit(vis->hud, vis->frame - 1);
+    }
 
     return;
 }
 
+
+void presentFrame(Visualizer* vis)
+{
+    // The frame is exported first, since the back buffer is undefined once it is presented.
+    // The offscreen framebuffer can be read as it is, the window has to be read back.
+    if (vis->gif) {
+        GifWriter* gif = vis->gif;
+
+        if (vis->surface) {
+            gifWriterFrame(gif, vis->surface->pixels, vis->surface->pitch, frameTime(vis));
+        } else if (SDL_RenderReadPixels(vis->renderer, NULL, SDL_PIXELFORMAT_ARGB8888, gif->pixels,
+                                        gif->width * (int) sizeof(Uint32)) == 0) {
+            gifWriterFrame(gif, gif->pixels, gif->width * (int) sizeof(Uint32), frameTime(vis));
+        }
+    }
+
+    SDL_RenderPresent(vis->renderer);
+
+    if (vis->headless) {
+        printf("frame %lu %016llx\n", (unsigned long) vis->frame,
+               (unsigned long long) hashFrame(vis->surface));
+    }
+
+    ++vis->frame;
+}
+
+
+Uint64 hashFrame(const SDL_Surface* surface)
+{
+    const Uint64 FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    const Uint64 FNV_PRIME        = 0x00000100000001b3ULL;
+
+    Uint64 hash      = FNV_OFFSET_BASIS;
+    int    row_bytes = surface->w * surface->format->BytesPerPixel;
+    int    y;
+
+    for (y = 0; y < surface->h; ++y) {
+        const Uint8* row = (const Uint8*) surface->pixels + y * surface->pitch;
+        int          x   = 0;
+
+	// The bulk of the row, 8 bytes at a time.
+	// memcpy() is used because the row is not guaranteed to be 8-byte aligned.
+        for (; x + 8 <= row_bytes; x += 8) {
+            Uint64 word;
+            memcpy(&word, row + x, sizeof(word));
+            hash ^= word;
+            hash *= FNV_PRIME;
+        }
+
+	// The leftover bytes at the end of the row, 1 byte at a time.
+        for (; x < row_bytes; ++x) {
+            hash ^= row[x];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    return hash;
+}
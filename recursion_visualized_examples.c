@@ -0,0 +1,422 @@
+/**
+ * @file    recursion_visualized_examples.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the traced example recursive functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), free()
+#include <string.h>  // C strings - for strcmp(), memset(), memcpy()
+
+#include "recursion_visualized_examples.h"
+#include "recursion_visualized_instrumented.h"  // triangular()
+
+
+/* The names of the recursive functions, indexed by their FUNCTION_* constants. */
+static const char* const FUNCTION_NAMES[FUNCTION_COUNT] = {
+    "bunny",
+    "factorial",
+    "fibonacci",
+    "hanoi",
+    "quicksort",
+    "ackermann",
+    "mergesort"
+};
+
+
+Sint64 exampleAdd(Sint64 a, Sint64 b)
+{
+    return (a > SDL_MAX_SINT64 - b) ? SDL_MAX_SINT64 : a + b;
+}
+
+
+Sint64 exampleMultiply(Sint64 a, Sint64 b)
+{
+    return (a != 0 && b > SDL_MAX_SINT64 / a) ? SDL_MAX_SINT64 : a * b;
+}
+
+
+Sint64 factorial(Tracer* tracer, Sint64 n)
+{
+    Sint64 result;
+
+    // A call whose result is in the memoization cache returns it right away.
+    if (TRACE_MEMO_HIT(tracer, FUNCTION_FACTORIAL, n, 0, 0, &result)) {
+        return result;
+    }
+
+    TRACE_ENTER(tracer, FUNCTION_FACTORIAL, n, 0, 0);
+
+    if (n <= 1) {
+	// base case.
+        result = 1;
+    } else {
+        result = exampleMultiply(n, factorial(tracer, n - 1));
+    }
+
+    TRACE_MEMO_STORE(tracer, FUNCTION_FACTORIAL, n, 0, 0, result);
+    TRACE_EXIT(tracer, FUNCTION_FACTORIAL, n, 0, 0);
+
+    return result;
+}
+
+
+Sint64 fibonacci(Tracer* tracer, Sint64 n)
+{
+    Sint64 result;
+
+    // A call whose result is in the memoization cache returns it right away.
+    if (TRACE_MEMO_HIT(tracer, FUNCTION_FIBONACCI, n, 0, 0, &result)) {
+        return result;
+    }
+
+    TRACE_ENTER(tracer, FUNCTION_FIBONACCI, n, 0, 0);
+
+    if (n < 2) {
+	// base case.
+        result = n;
+    } else {
+	// fibonacci(n - 1) is called first, since the order of the arguments of a call is unspecified.
+        result = fibonacci(tracer, n - 1);
+        result = exampleAdd(result, fibonacci(tracer, n - 2));
+    }
+
+    TRACE_MEMO_STORE(tracer, FUNCTION_FIBONACCI, n, 0, 0, result);
+    TRACE_EXIT(tracer, FUNCTION_FIBONACCI, n, 0, 0);
+
+    return result;
+}
+
+
+Sint64 hanoi(Tracer* tracer, Sint64 n, Sint64 from, Sint64 to)
+{
+    Sint64 moves = 0;
+
+    // A call whose result is in the memoization cache returns it right away.
+    if (TRACE_MEMO_HIT(tracer, FUNCTION_HANOI, n, from, to, &moves)) {
+        return moves;
+    }
+
+    TRACE_ENTER(tracer, FUNCTION_HANOI, n, from, to);
+
+    if (n > 0) {
+	// The pegs are 1, 2 and 3, so the spare one is whichever is left over.
+        Sint64 via = 6 - from - to;
+
+        moves = hanoi(tracer, n - 1, from, via);
+        moves = exampleAdd(moves, 1);
+        moves = exampleAdd(moves, hanoi(tracer, n - 1, via, to));
+    }
+
+    TRACE_MEMO_STORE(tracer, FUNCTION_HANOI, n, from, to, moves);
+    TRACE_EXIT(tracer, FUNCTION_HANOI, n, from, to);
+
+    return moves;
+}
+
+
+Sint64 quicksortPartition(int* array, Sint64 low, Sint64 high)
+{
+    // Lomuto partition: everything smaller than the pivot goes to its left.
+    int    pivot = array[high];
+    Sint64 store = low;
+    Sint64 i;
+    int    swap;
+
+    for (i = low; i < high; ++i) {
+        if (array[i] < pivot) {
+            swap         = array[i];
+            array[i]     = array[store];
+            array[store] = swap;
+            ++store;
+        }
+    }
+    array[high]  = array[store];
+    array[store] = pivot;
+
+    return store;
+}
+
+
+Sint64 quicksort(Tracer* tracer, int* array, Sint64 low, Sint64 high)
+{
+    TRACE_ENTER(tracer, FUNCTION_QUICKSORT, low, high, 0);
+
+    if (low < high) {
+        Sint64 store = quicksortPartition(array, low, high);
+
+        quicksort(tracer, array, low, store - 1);
+        quicksort(tracer, array, store + 1, high);
+    }
+
+    TRACE_EXIT(tracer, FUNCTION_QUICKSORT, low, high, 0);
+
+    return (high >= low) ? high - low + 1 : 0;
+}
+
+
+void mergesortMerge(int* array, int* scratch, Sint64 low, Sint64 middle, Sint64 high)
+{
+    Sint64 left  = low;
+    Sint64 right = middle + 1;
+    Sint64 i;
+
+    // Takes the smaller of the heads of both halves, the left one on a tie, so the sort is stable.
+    for (i = low; i <= high; ++i) {
+        if (right > high || (left <= middle && array[left] <= array[right])) {
+            scratch[i] = array[left++];
+        } else {
+            scratch[i] = array[right++];
+        }
+    }
+    memcpy(array + low, scratch + low, (size_t) (high - low + 1) * sizeof(int));
+}
+
+
+Sint64 mergesort(Tracer* tracer, int* array, int* scratch, Sint64 low, Sint64 high)
+{
+    TRACE_ENTER(tracer, FUNCTION_MERGESORT, low, high, 0);
+
+    if (low < high) {
+        Sint64 middle = low + (high - low) / 2;
+
+        mergesort(tracer, array, scratch, low, middle);
+        mergesort(tracer, array, scratch, middle + 1, high);
+        mergesortMerge(array, scratch, low, middle, high);
+    }
+
+    TRACE_EXIT(tracer, FUNCTION_MERGESORT, low, high, 0);
+
+    return (high >= low) ? high - low + 1 : 0;
+}
+
+
+Sint64 ackermann(Tracer* tracer, Sint64 m, Sint64 n)
+{
+    Sint64 result;
+
+    // A call whose result is in the memoization cache returns it right away.
+    if (TRACE_MEMO_HIT(tracer, FUNCTION_ACKERMANN, m, n, 0, &result)) {
+        return result;
+    }
+
+    TRACE_ENTER(tracer, FUNCTION_ACKERMANN, m, n, 0);
+
+    if (m == 0) {
+	// base case.
+        result = n + 1;
+    } else if (n == 0) {
+        result = ackermann(tracer, m - 1, 1);
+    } else {
+        result = ackermann(tracer, m - 1, ackermann(tracer, m, n - 1));
+    }
+
+    TRACE_MEMO_STORE(tracer, FUNCTION_ACKERMANN, m, n, 0, result);
+    TRACE_EXIT(tracer, FUNCTION_ACKERMANN, m, n, 0);
+
+    return result;
+}
+
+
+int findExample(const char* name)
+{
+    int function;
+
+    // bunny() is not traced through the Tracer, so it is not an example.
+    for (function = FUNCTION_BUNNY + 1; function < FUNCTION_COUNT; ++function) {
+        if (strcmp(name, FUNCTION_NAMES[function]) == 0) {
+            return function;
+        }
+    }
+    if (strcmp(name, "instrumented") == 0) {
+        return FUNCTION_INSTRUMENTED;
+    }
+
+    return -1;
+}
+
+
+const char* functionName(Uint16 function)
+{
+    if (function >= FUNCTION_COUNT) {
+        return "unknown";
+    }
+
+    return FUNCTION_NAMES[function];
+}
+
+
+void describeCall(char* text, size_t size, Uint16 function, const Sint64* args)
+{
+    long long a = (long long) args[0];
+    long long b = (long long) args[1];
+    long long c = (long long) args[2];
+
+    switch (function) {
+    case FUNCTION_BUNNY:
+        SDL_snprintf(text, size, "bunny(y=%lld)", a);
+        break;
+    case FUNCTION_FACTORIAL:
+    case FUNCTION_FIBONACCI:
+        SDL_snprintf(text, size, "%s(%lld)", FUNCTION_NAMES[function], a);
+        break;
+    case FUNCTION_HANOI:
+        SDL_snprintf(text, size, "hanoi(%lld, %lld, %lld)", a, b, c);
+        break;
+    case FUNCTION_QUICKSORT:
+    case FUNCTION_ACKERMANN:
+    case FUNCTION_MERGESORT:
+        SDL_snprintf(text, size, "%s(%lld, %lld)", FUNCTION_NAMES[function], a, b);
+        break;
+    case FUNCTION_INSTRUMENTED:
+        SDL_snprintf(text, size, "0x%llx()", (unsigned long long) a);
+        break;
+    default:
+        SDL_snprintf(text, size, "unknown()");
+        break;
+    }
+}
+
+
+int runExample(Tracer* tracer, int function, Sint64 n, Sint64* result)
+{
+    int status = 0;
+
+    switch (function) {
+    case FUNCTION_FACTORIAL:
+        *result = factorial(tracer, n);
+        break;
+    case FUNCTION_FIBONACCI:
+        *result = fibonacci(tracer, n);
+        break;
+    case FUNCTION_HANOI:
+        *result = hanoi(tracer, n, 1, 3);
+        break;
+    case FUNCTION_QUICKSORT: {
+        int* array = exampleArray(n);
+
+        if (!array) {
+            status = -1;
+            break;
+        }
+        *result = quicksort(tracer, array, 0, n - 1);
+        free(array);
+        break;
+    }
+    case FUNCTION_ACKERMANN:
+        *result = ackermann(tracer, 2, n);
+        break;
+    case FUNCTION_MERGESORT: {
+        int* array   = exampleArray(n);
+        int* scratch = exampleArray(n);
+
+        if (array && scratch) {
+            *result = mergesort(tracer, array, scratch, 0, n - 1);
+        } else {
+            status = -1;
+        }
+        free(array);
+        free(scratch);
+        break;
+    }
+    case FUNCTION_INSTRUMENTED:
+	// triangular() knows nothing about the Tracer, the -finstrument-functions hooks record its calls.
+        traceSetActive(tracer);
+        *result = triangular(n);
+        traceSetActive(NULL);
+        break;
+    default:
+        status = -1;
+        break;
+    }
+
+    return status;
+}
+
+
+int* exampleArray(Sint64 n)
+{
+    int*   array = (int*) malloc((n > 0 ? n : 1) * sizeof(int));
+    Uint32 seed  = 12345;
+    Sint64 i;
+
+    // The same pseudo-random numbers every time, from a linear congruential generator,
+    // so that two runs can be compared.
+    if (array) {
+        for (i = 0; i < n; ++i) {
+            seed     = seed * 1103515245u + 12345u;
+            array[i] = (int) ((seed >> 16) % 1000);
+        }
+    }
+
+    return array;
+}
+
+
+Uint32 exampleMaxDepth(int function, Sint64 n)
+{
+    Sint64 depth;
+    Sint64 size;
+
+    // Every example makes at least its first call, and no depth past 0xFFFFFFFF can be counted,
+    // so a problem size that big saturates before the arithmetic below could overflow.
+    if (n < 0) {
+        n = 0;
+    }
+    if (n >= 0x7FFFFFFF) {
+        return 0xFFFFFFFF;
+    }
+
+    switch (function) {
+    case FUNCTION_HANOI:
+        depth = n + 1;
+        break;
+    case FUNCTION_ACKERMANN:
+	// ackermann(2, n) == 2n + 3, and it recurses about that deep.
+        depth = 2 * n + 5;
+        break;
+    case FUNCTION_MERGESORT:
+	// mergesort halves the array at every call, so it recurses about log2(n) deep.
+        for (depth = 1, size = 1; size < n; size *= 2) {
+            ++depth;
+        }
+        break;
+    default:
+	// factorial, fibonacci and triangular recurse n deep, and quicksort at most n deep.
+        depth = n + 1;
+        break;
+    }
+
+    return (depth < 0xFFFFFFFF) ? (Uint32) depth : 0xFFFFFFFF;
+}
+
+
+int exampleThread(void* data)
+{
+    ExampleArgs* args = (ExampleArgs*) data;
+    Tracer       tracer;
+    Sint64       result;
+    int          status;
+    StackEvent   end;
+
+    // Nothing needs to be kept, every record is forwarded to the render loop.
+    tracerInit(&tracer, 0, args->ring);
+    tracer.memo = args->memo;
+    status = runExample(&tracer, args->function, args->n, &result);
+    tracerDestroy(&tracer);
+
+    // Tell the render loop that there is nothing more to play back.
+    memset(&end, 0, sizeof(end));
+    end.type = EVENT_END;
+    ringPush(args->ring, &end);
+
+    return status;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file    recursion_visualized_examples.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the classic recursive functions which are traced
+ * with the recursion tracing API, so that their runtime stacks can be animated like bunny()'s.
+ */
+
+#ifndef RECURSION_VISUALIZED_EXAMPLES_H
+#define RECURSION_VISUALIZED_EXAMPLES_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_trace.h"  // Tracer, Memo
+
+
+/**
+ * These are the traced recursive functions. Each of them takes the Tracer to record into
+ * as its first argument, and records its own arguments on entrance and on exit.
+ * factorial, fibonacci, hanoi and ackermann look their calls up in the memoization cache
+ * of the Tracer, if it has one.
+ *
+ * factorial(n)                   n! by linear recursion.
+ * fibonacci(n)                   The n-th Fibonacci number by naive tree recursion.
+ * hanoi(n, from, to)             Moves n disks from peg from to peg to, and returns the number of moves.
+ *                                These three results saturate at SDL_MAX_SINT64 instead of overflowing,
+ *                                from 21!, fibonacci(93) and 63 disks on.
+ *                                The pegs are numbered 1, 2 and 3.
+ * quicksort(array, low, high)    Sorts array[low..high] in place, with the Lomuto partition scheme.
+ *                                It returns the number of elements sorted.
+ * ackermann(m, n)                The Ackermann function, which recurses very deeply for small arguments.
+ * mergesort(array, scratch, low, high)
+ *                                Sorts array[low..high] by sorting both halves and merging them,
+ *                                through scratch, which is as large as array.
+ *                                It returns the number of elements sorted.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 factorial(Tracer* tracer, Sint64 n);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 fibonacci(Tracer* tracer, Sint64 n);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 hanoi(Tracer* tracer, Sint64 n, Sint64 from, Sint64 to);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 quicksort(Tracer* tracer, int* array, Sint64 low, Sint64 high);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 ackermann(Tracer* tracer, Sint64 m, Sint64 n);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 mergesort(Tracer* tracer, int* array, int* scratch, Sint64 low, Sint64 high);
+
+
+/**
+ * This function partitions array[low..high] around its last element, for quicksort().
+ *
+ * @param int* array - The array.
+ *
+ * @param Sint64 low, Sint64 high - The first and the last index of the part to partition, low < high.
+ *
+ * @return Sint64 - Where the pivot ended up. Everything left of it is smaller.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 quicksortPartition(int* array, Sint64 low, Sint64 high);
+
+
+/**
+ * This function merges the sorted halves array[low..middle] and array[middle + 1..high], for mergesort().
+ *
+ * @param int* array - The array.
+ *
+ * @param int* scratch - An array as large as array, whose elements low to high are overwritten.
+ *
+ * @param Sint64 low, Sint64 middle, Sint64 high - Where the halves begin and end, low <= middle < high.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void mergesortMerge(int* array, int* scratch, Sint64 low, Sint64 middle, Sint64 high);
+
+
+/**
+ * These functions add and multiply two results of the examples, neither of them negative,
+ * and saturate at SDL_MAX_SINT64 instead of overflowing.
+ *
+ * @param Sint64 a, Sint64 b - The operands, at least 0.
+ *
+ * @return Sint64 - The sum or the product, at most SDL_MAX_SINT64.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 exampleAdd(Sint64 a, Sint64 b);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 exampleMultiply(Sint64 a, Sint64 b);
+
+
+/**
+ * This function looks up a traced function by the name it is given on the command line:
+ * "factorial", "fibonacci", "hanoi", "quicksort", "ackermann" or "mergesort",
+ * or "instrumented" for triangular(), which is traced by the -finstrument-functions hooks.
+ *
+ * @param const char* name - The name of the function.
+ *
+ * @return int - The FUNCTION_* constant of the function, or -1 if there is no such function.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int findExample(const char* name);
+
+
+/**
+ * This function gives the name of a recursive function.
+ *
+ * @param Uint16 function - A FUNCTION_* constant.
+ *
+ * @return const char* - The name of the function, "bunny" for FUNCTION_BUNNY,
+ *                       and "unknown" if there is no such function.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+const char* functionName(Uint16 function);
+
+
+/**
+ * This function writes down a call of a recursive function the way it would look in the code,
+ * such as "hanoi(3, 1, 3)", for the label of its stack frame. bunny() is written down with the
+ * y coordinate of its rectangle, "bunny(y=590)", and a function compiled with
+ * -finstrument-functions with its address, "0x401136()".
+ *
+ * @param char* text - Receives the text, terminated by '\0'. It is cut short if it does not fit.
+ *
+ * @param size_t size - The size of text in bytes.
+ *
+ * @param Uint16 function - A FUNCTION_* constant.
+ *
+ * @param const Sint64* args - The STACK_EVENT_ARGS arguments recorded for the call.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void describeCall(char* text, size_t size, Uint16 function, const Sint64* args);
+
+
+/**
+ * This function runs one traced recursive function for the problem size n:
+ * factorial(n), fibonacci(n), hanoi(n, 1, 3), quicksort of n pseudo-random numbers,
+ * ackermann(2, n), mergesort of the same n pseudo-random numbers,
+ * or triangular(n) for FUNCTION_INSTRUMENTED, with the -finstrument-functions hooks recording into tracer.
+ *
+ * @param Tracer* tracer - The trace to record into.
+ *
+ * @param int function - The FUNCTION_* constant of the function to run.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param Sint64* result - Receives the result of the function.
+ *
+ * @return int - 0 on success, -1 if it could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int runExample(Tracer* tracer, int function, Sint64 n, Sint64* result);
+
+
+/**
+ * This function allocates the array of n pseudo-random numbers which runExample() sorts,
+ * the same ones every time.
+ *
+ * @param Sint64 n - The number of elements.
+ *
+ * @return int* - The array, to be deallocated with free(), or NULL if it could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int* exampleArray(Sint64 n);
+
+
+/**
+ * This function estimates how deep the runtime stack of an example gets for the problem size n,
+ * so that the thread it runs on can be given a big enough stack.
+ *
+ * @param int function - The FUNCTION_* constant of the function.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @return Uint32 - The greatest number of stack frames the function can have at once,
+ *                  or 0xFFFFFFFF if there are more than can be counted.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint32 exampleMaxDepth(int function, Sint64 n);
+
+
+/**
+ * The arguments handed over to the example thread.
+ *
+ * @field EventRing* ring - The ring buffer shared with the render loop.
+ *
+ * @field int function - The FUNCTION_* constant of the example to run.
+ *
+ * @field Sint64 n - The problem size.
+ *
+ * @field Memo* memo - The memoization cache to look the calls up in, or NULL.
+ */
+typedef struct ExampleArgs {
+    EventRing* ring;
+    int        function;
+    Sint64     n;
+    Memo*      memo;
+} ExampleArgs;
+
+
+/**
+ * This is the entry point of the example thread, as required by SDL_CreateThread().
+ *
+ * It traces one example into the ring buffer, with the memoization cache if it is given one,
+ * and when it has finished, it emits an EVENT_END record so the render loop knows that
+ * the animation is over.
+ *
+ * @param void* data - A pointer to the ExampleArgs structure.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int exampleThread(void* data);
+
+#endif /* RECURSION_VISUALIZED_EXAMPLES_H */
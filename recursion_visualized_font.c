@@ -0,0 +1,410 @@
+/**
+ * @file    recursion_visualized_font.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the bitmap font, and the definitions of the glyph atlas functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for calloc(), realloc(), free()
+#include <string.h>  // C strings - for strlen()
+
+#include "recursion_visualized_font.h"
+
+
+/* The characters in the font are the printable ASCII characters, from ' ' to '~'. */
+#define FONT_FIRST 32
+#define FONT_COUNT 95
+
+/* The atlas has 16 cells in a row, and as many rows as it takes to hold the whole font. */
+#define ATLAS_COLUMNS 16
+#define ATLAS_ROWS    ((FONT_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS)
+#define ATLAS_WIDTH   (ATLAS_COLUMNS * GLYPH_WIDTH)
+#define ATLAS_HEIGHT  (ATLAS_ROWS * GLYPH_HEIGHT)
+
+/* How many characters the batch has room for at first. */
+#define BATCH_INITIAL_CAPACITY 1024
+
+
+/* The glyphs of the font, 5 columns of 8 pixels each, from left to right.
+   Bit 0 of a column is its top pixel, bit 7 its bottom pixel. */
+static const Uint8 FONT_GLYPHS[FONT_COUNT][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+    { 0x00, 0x00, 0x5F, 0x00, 0x00 },  // '!'
+    { 0x00, 0x07, 0x00, 0x07, 0x00 },  // '"'
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 },  // '#'
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 },  // '$'
+    { 0x23, 0x13, 0x08, 0x64, 0x62 },  // '%'
+    { 0x36, 0x49, 0x56, 0x20, 0x50 },  // '&'
+    { 0x00, 0x08, 0x07, 0x03, 0x00 },  // '\''
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 },  // '('
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 },  // ')'
+    { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A },  // '*'
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 },  // '+'
+    { 0x00, 0x80, 0x70, 0x30, 0x00 },  // ','
+    { 0x08, 0x08, 0x08, 0x08, 0x08 },  // '-'
+    { 0x00, 0x00, 0x60, 0x60, 0x00 },  // '.'
+    { 0x20, 0x10, 0x08, 0x04, 0x02 },  // '/'
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },  // '0'
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },  // '1'
+    { 0x72, 0x49, 0x49, 0x49, 0x46 },  // '2'
+    { 0x21, 0x41, 0x49, 0x4D, 0x33 },  // '3'
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },  // '4'
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },  // '5'
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 },  // '6'
+    { 0x41, 0x21, 0x11, 0x09, 0x07 },  // '7'
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },  // '8'
+    { 0x46, 0x49, 0x49, 0x29, 0x1E },  // '9'
+    { 0x00, 0x00, 0x14, 0x00, 0x00 },  // ':'
+    { 0x00, 0x40, 0x34, 0x00, 0x00 },  // ';'
+    { 0x00, 0x08, 0x14, 0x22, 0x41 },  // '<'
+    { 0x14, 0x14, 0x14, 0x14, 0x14 },  // '='
+    { 0x00, 0x41, 0x22, 0x14, 0x08 },  // '>'
+    { 0x02, 0x01, 0x59, 0x09, 0x06 },  // '?'
+    { 0x3E, 0x41, 0x5D, 0x59, 0x4E },  // '@'
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C },  // 'A'
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 },  // 'B'
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 },  // 'C'
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E },  // 'D'
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 },  // 'E'
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 },  // 'F'
+    { 0x3E, 0x41, 0x41, 0x51, 0x73 },  // 'G'
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F },  // 'H'
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 },  // 'I'
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 },  // 'J'
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 },  // 'K'
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 },  // 'L'
+    { 0x7F, 0x02, 0x1C, 0x02, 0x7F },  // 'M'
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F },  // 'N'
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E },  // 'O'
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 },  // 'P'
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E },  // 'Q'
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 },  // 'R'
+    { 0x26, 0x49, 0x49, 0x49, 0x32 },  // 'S'
+    { 0x03, 0x01, 0x7F, 0x01, 0x03 },  // 'T'
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F },  // 'U'
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F },  // 'V'
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F },  // 'W'
+    { 0x63, 0x14, 0x08, 0x14, 0x63 },  // 'X'
+    { 0x03, 0x04, 0x78, 0x04, 0x03 },  // 'Y'
+    { 0x61, 0x59, 0x49, 0x4D, 0x43 },  // 'Z'
+    { 0x00, 0x7F, 0x41, 0x41, 0x41 },  // '['
+    { 0x02, 0x04, 0x08, 0x10, 0x20 },  // '\\'
+    { 0x00, 0x41, 0x41, 0x41, 0x7F },  // ']'
+    { 0x04, 0x02, 0x01, 0x02, 0x04 },  // '^'
+    { 0x40, 0x40, 0x40, 0x40, 0x40 },  // '_'
+    { 0x00, 0x03, 0x07, 0x08, 0x00 },  // '`'
+    { 0x20, 0x54, 0x54, 0x78, 0x40 },  // 'a'
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 },  // 'b'
+    { 0x38, 0x44, 0x44, 0x44, 0x28 },  // 'c'
+    { 0x38, 0x44, 0x44, 0x28, 0x7F },  // 'd'
+    { 0x38, 0x54, 0x54, 0x54, 0x18 },  // 'e'
+    { 0x00, 0x08, 0x7E, 0x09, 0x02 },  // 'f'
+    { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },  // 'g'
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 },  // 'h'
+    { 0x00, 0x44, 0x7D, 0x40, 0x00 },  // 'i'
+    { 0x20, 0x40, 0x40, 0x3D, 0x00 },  // 'j'
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 },  // 'k'
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 },  // 'l'
+    { 0x7C, 0x04, 0x78, 0x04, 0x78 },  // 'm'
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 },  // 'n'
+    { 0x38, 0x44, 0x44, 0x44, 0x38 },  // 'o'
+    { 0xFC, 0x18, 0x24, 0x24, 0x18 },  // 'p'
+    { 0x18, 0x24, 0x24, 0x18, 0xFC },  // 'q'
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 },  // 'r'
+    { 0x48, 0x54, 0x54, 0x54, 0x24 },  // 's'
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 },  // 't'
+    { 0x3C, 0x40, 0x40, 0x20, 0x7C },  // 'u'
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C },  // 'v'
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C },  // 'w'
+    { 0x44, 0x28, 0x10, 0x28, 0x44 },  // 'x'
+    { 0x4C, 0x90, 0x90, 0x90, 0x7C },  // 'y'
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 },  // 'z'
+    { 0x00, 0x08, 0x36, 0x41, 0x00 },  // '{'
+    { 0x00, 0x00, 0x77, 0x00, 0x00 },  // '|'
+    { 0x00, 0x41, 0x36, 0x08, 0x00 },  // '}'
+    { 0x02, 0x01, 0x02, 0x04, 0x02 },  // '~'
+};
+
+
+/**
+ * This function finds the cell of a character in the atlas.
+ *
+ * @param char c - The character. Anything that is not in the font is drawn as a '?'.
+ *
+ * @param SDL_Rect* cell - Receives the cell, in pixels.
+ */
+static void glyphCell(char c, SDL_Rect* cell)
+{
+    int index = (unsigned char) c - FONT_FIRST;
+
+    if (index < 0 || index >= FONT_COUNT) {
+        index = '?' - FONT_FIRST;
+    }
+
+    cell->x = (index % ATLAS_COLUMNS) * GLYPH_WIDTH;
+    cell->y = (index / ATLAS_COLUMNS) * GLYPH_HEIGHT;
+    cell->w = GLYPH_WIDTH;
+    cell->h = GLYPH_HEIGHT;
+}
+
+
+/**
+ * This function makes room in the batch for more characters.
+ *
+ * @param GlyphAtlas* atlas - A pointer to the atlas.
+ *
+ * @param int count - How many characters the batch must have room for.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int growBatch(GlyphAtlas* atlas, int count)
+{
+    int capacity = (atlas->capacity > 0) ? atlas->capacity : BATCH_INITIAL_CAPACITY;
+
+    if (count <= atlas->capacity) {
+        return 0;
+    }
+
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+#ifdef GLYPH_ATLAS_GEOMETRY
+    {
+        SDL_Vertex* vertices;
+        int*        indices;
+        int         i;
+
+        vertices = (SDL_Vertex*) realloc(atlas->vertices, capacity * 4 * sizeof(SDL_Vertex));
+        if (!vertices) {
+            return -1;
+        }
+        atlas->vertices = vertices;
+        indices = (int*) realloc(atlas->indices, capacity * 6 * sizeof(int));
+        if (!indices) {
+            return -1;
+        }
+        atlas->indices = indices;
+
+	// The corners of every quad are stored in the same order, top left, top right,
+	// bottom left, bottom right, so the triangles never change, and are set up only once.
+        for (i = atlas->capacity; i < capacity; ++i) {
+            indices[i * 6 + 0] = i * 4 + 0;
+            indices[i * 6 + 1] = i * 4 + 1;
+            indices[i * 6 + 2] = i * 4 + 2;
+            indices[i * 6 + 3] = i * 4 + 2;
+            indices[i * 6 + 4] = i * 4 + 1;
+            indices[i * 6 + 5] = i * 4 + 3;
+        }
+    }
+#else
+    {
+        SDL_Rect* sources;
+        SDL_Rect* targets;
+
+        sources = (SDL_Rect*) realloc(atlas->sources, capacity * sizeof(SDL_Rect));
+        if (!sources) {
+            return -1;
+        }
+        atlas->sources = sources;
+        targets = (SDL_Rect*) realloc(atlas->targets, capacity * sizeof(SDL_Rect));
+        if (!targets) {
+            return -1;
+        }
+        atlas->targets = targets;
+    }
+#endif
+
+    atlas->capacity = capacity;
+
+    return 0;
+}
+
+
+int glyphAtlasInit(GlyphAtlas* atlas, SDL_Renderer* renderer)
+{
+    Uint32* pixels;
+    int     index;
+
+    atlas->texture  = NULL;
+    atlas->count    = 0;
+    atlas->capacity = 0;
+#ifdef GLYPH_ATLAS_GEOMETRY
+    atlas->vertices = NULL;
+    atlas->indices  = NULL;
+#else
+    atlas->sources  = NULL;
+    atlas->targets  = NULL;
+#endif
+
+    // The glyphs are white, and everything around them is transparent.
+    pixels = (Uint32*) calloc(ATLAS_WIDTH * ATLAS_HEIGHT, sizeof(Uint32));
+    if (!pixels) {
+        return -1;
+    }
+    for (index = 0; index < FONT_COUNT; ++index) {
+        SDL_Rect cell;
+        int      x;
+        int      y;
+
+        glyphCell((char) (index + FONT_FIRST), &cell);
+        for (x = 0; x < 5; ++x) {
+            for (y = 0; y < 8; ++y) {
+                if (FONT_GLYPHS[index][x] & (1 << y)) {
+                    pixels[(cell.y + y) * ATLAS_WIDTH + cell.x + x] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+
+    atlas->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                       ATLAS_WIDTH, ATLAS_HEIGHT);
+    if (!atlas->texture || SDL_UpdateTexture(atlas->texture, NULL, pixels, ATLAS_WIDTH * sizeof(Uint32)) != 0) {
+        free(pixels);
+        glyphAtlasDestroy(atlas);
+        return -1;
+    }
+    free(pixels);
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+
+    if (growBatch(atlas, BATCH_INITIAL_CAPACITY) != 0) {
+        glyphAtlasDestroy(atlas);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void glyphAtlasDestroy(GlyphAtlas* atlas)
+{
+    if (atlas->texture) {
+        SDL_DestroyTexture(atlas->texture);
+        atlas->texture = NULL;
+    }
+#ifdef GLYPH_ATLAS_GEOMETRY
+    free(atlas->vertices);
+    free(atlas->indices);
+    atlas->vertices = NULL;
+    atlas->indices  = NULL;
+#else
+    free(atlas->sources);
+    free(atlas->targets);
+    atlas->sources = NULL;
+    atlas->targets = NULL;
+#endif
+    atlas->count    = 0;
+    atlas->capacity = 0;
+}
+
+
+int glyphAtlasText(GlyphAtlas* atlas, int x, int y, const char* text)
+{
+    int length = (int) strlen(text);
+    int i;
+
+    if (growBatch(atlas, atlas->count + length) != 0) {
+        return -1;
+    }
+
+    for (i = 0; i < length; ++i, x += GLYPH_WIDTH) {
+        SDL_Rect cell;
+
+        // Spaces are only skipped over.
+        if (text[i] == ' ') {
+            continue;
+        }
+        glyphCell(text[i], &cell);
+
+#ifdef GLYPH_ATLAS_GEOMETRY
+        {
+            SDL_Vertex* corner = &atlas->vertices[atlas->count * 4];
+            float       left   = (float) cell.x / ATLAS_WIDTH;
+            float       right  = (float) (cell.x + cell.w) / ATLAS_WIDTH;
+            float       top    = (float) cell.y / ATLAS_HEIGHT;
+            float       bottom = (float) (cell.y + cell.h) / ATLAS_HEIGHT;
+            int         k;
+
+            for (k = 0; k < 4; ++k) {
+                corner[k].position.x  = (float) ((k & 1) ? x + GLYPH_WIDTH : x);
+                corner[k].position.y  = (float) ((k & 2) ? y + GLYPH_HEIGHT : y);
+                corner[k].tex_coord.x = (k & 1) ? right : left;
+                corner[k].tex_coord.y = (k & 2) ? bottom : top;
+                corner[k].color.r     = 255;
+                corner[k].color.g     = 255;
+                corner[k].color.b     = 255;
+                corner[k].color.a     = 255;
+            }
+        }
+#else
+        atlas->sources[atlas->count]   = cell;
+        atlas->targets[atlas->count].x = x;
+        atlas->targets[atlas->count].y = y;
+        atlas->targets[atlas->count].w = GLYPH_WIDTH;
+        atlas->targets[atlas->count].h = GLYPH_HEIGHT;
+#endif
+        ++atlas->count;
+    }
+
+    return 0;
+}
+
+
+void glyphAtlasFlush(GlyphAtlas* atlas, SDL_Renderer* renderer)
+{
+    if (atlas->count == 0) {
+        return;
+    }
+
+#ifdef GLYPH_ATLAS_GEOMETRY
+    // One draw call for every character in the batch.
+    SDL_RenderGeometry(renderer, atlas->texture, atlas->vertices, atlas->count * 4,
+                       atlas->indices, atlas->count * 6);
+#else
+    {
+        int i;
+
+        for (i = 0; i < atlas->count; ++i) {
+            SDL_RenderCopy(renderer, atlas->texture, &atlas->sources[i], &atlas->targets[i]);
+        }
+    }
+#endif
+
+    atlas->count = 0;
+}
+
+
+void glyphRasterText(Raster* raster, int x, int y, const char* text)
+{
+    for (; *text != '\0'; ++text, x += GLYPH_WIDTH) {
+        int index = (unsigned char) *text - FONT_FIRST;
+        int column;
+        int row;
+
+        if (index < 0 || index >= FONT_COUNT) {
+            index = '?' - FONT_FIRST;
+        }
+
+	// Every set bit of a column is one pixel, and the ones outside of the raster are left out.
+        for (column = 0; column < 5; ++column) {
+            Uint8 bits = FONT_GLYPHS[index][column];
+
+            if (x + column < 0 || x + column >= raster->width) {
+                continue;
+            }
+            for (row = 0; bits != 0; ++row, bits >>= 1) {
+                if ((bits & 1) && y + row >= 0 && y + row < raster->height) {
+                    raster->pixels[(size_t) (y + row) * raster->pitch + x + column] = raster->color;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file    recursion_visualized_font.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the glyph atlas, which draws the text of the labels
+ * on the stack frames.
+ *
+ * The program carries its own bitmap font of the printable ASCII characters, 5 by 8 pixels each.
+ * At startup, every character is drawn once into its own cell of a single SDL_Texture, the atlas.
+ * From then on, nothing is rasterized any more: a line of text is a row of quads, each of which
+ * copies the cell of its character out of the atlas. The quads of all the labels on the screen
+ * are gathered into one batch, and handed to the renderer with a single SDL_RenderGeometry() call,
+ * so hundreds of labels cost about as much to draw as one.
+ *
+ * With SDL versions older than 2.0.18, which do not have SDL_RenderGeometry(),
+ * the batch is drawn with one SDL_RenderCopy() call per character instead.
+ *
+ * The software rasterizer has no textures, so it draws the characters straight out of the font,
+ * with glyphRasterText().
+ */
+
+#ifndef RECURSION_VISUALIZED_FONT_H
+#define RECURSION_VISUALIZED_FONT_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_raster.h"  // Raster
+
+
+/* The size of the cell of one character in pixels, which is also how far apart the characters
+   are drawn. The glyph takes 5 by 8 pixels of it, the rest is the space to the next character. */
+#define GLYPH_WIDTH  6
+#define GLYPH_HEIGHT 9
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define GLYPH_ATLAS_GEOMETRY 1
+#endif
+
+
+/**
+ * The texture with every character of the font, and the batch of quads to draw out of it.
+ *
+ * @field SDL_Texture* texture - The atlas: 16 cells in a row, one for each printable ASCII character.
+ *
+ * @field int count - How many characters are in the batch.
+ *
+ * @field int capacity - How many characters the batch has room for. It grows when it is full.
+ *
+ * @field SDL_Vertex* vertices - The 4 corners of the quad of each character in the batch.
+ *
+ * @field int* indices - The 2 triangles of each quad, as indices into vertices.
+ *
+ * @field SDL_Rect* sources, targets - The cell in the atlas and the place on the screen of each
+ *                                     character in the batch, without SDL_RenderGeometry().
+ */
+typedef struct GlyphAtlas {
+    SDL_Texture* texture;
+    int          count;
+    int          capacity;
+#ifdef GLYPH_ATLAS_GEOMETRY
+    SDL_Vertex*  vertices;
+    int*         indices;
+#else
+    SDL_Rect*    sources;
+    SDL_Rect*    targets;
+#endif
+} GlyphAtlas;
+
+
+/**
+ * This function draws the font into a new atlas texture of the renderer. This is the only time
+ * the characters are rasterized.
+ *
+ * @param GlyphAtlas* atlas - A pointer to the atlas to initialize.
+ *
+ * @param SDL_Renderer* renderer - The renderer the labels are going to be drawn with.
+ *
+ * @return int - 0 on success, -1 if the texture could not be created.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int glyphAtlasInit(GlyphAtlas* atlas, SDL_Renderer* renderer);
+
+
+/**
+ * This function destroys the atlas texture, and deallocates the batch.
+ *
+ * @param GlyphAtlas* atlas - A pointer to the atlas.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void glyphAtlasDestroy(GlyphAtlas* atlas);
+
+
+/**
+ * This function adds a line of text to the batch. Nothing is drawn until glyphAtlasFlush().
+ * Characters which are not printable ASCII are drawn as question marks.
+ *
+ * @param GlyphAtlas* atlas - A pointer to the atlas.
+ *
+ * @param int x, int y - The top left corner of the first character, in pixels.
+ *
+ * @param const char* text - The text, terminated by '\0'.
+ *
+ * @return int - 0 on success, -1 if the batch could not be grown. Then the text is left out.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int glyphAtlasText(GlyphAtlas* atlas, int x, int y, const char* text);
+
+
+/**
+ * This function draws every character in the batch, in white, and empties the batch.
+ *
+ * @param GlyphAtlas* atlas - A pointer to the atlas.
+ *
+ * @param SDL_Renderer* renderer - The renderer the atlas was made for.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void glyphAtlasFlush(GlyphAtlas* atlas, SDL_Renderer* renderer);
+
+
+/**
+ * This function draws a line of text into a software raster right away, in the color of the raster,
+ * without an atlas. The pixels of the characters are the same ones the atlas draws.
+ * Characters which are not printable ASCII are drawn as question marks.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * @param int x, int y - The top left corner of the first character, in pixels.
+ *
+ * @param const char* text - The text, terminated by '\0'.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void glyphRasterText(Raster* raster, int x, int y, const char* text);
+
+#endif /* RECURSION_VISUALIZED_FONT_H */
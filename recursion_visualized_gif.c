@@ -0,0 +1,593 @@
+/**
+ * @file    recursion_visualized_gif.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the animated GIF exporter functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for fopen(), fwrite(), fputc(), fclose()
+#include <stdlib.h>  // C standard library - for malloc(), free()
+#include <string.h>  // C strings - for memcpy(), memset()
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // SSE2 intrinsics - for _mm_cmpeq_epi32(), _mm_movemask_epi8()
+#endif
+
+#include "recursion_visualized_gif.h"
+
+
+/* The LZW codes of a GIF file are at most 12 bits long. */
+#define LZW_MAX_CODES 4096
+
+/* The size of the hash table of the LZW dictionary. It must be a power of two,
+   and it is twice as large as the dictionary can get, so it never gets too full. */
+#define LZW_HASH_SIZE 8192
+#define LZW_HASH_BITS 13
+
+/* The size of the hash table of the colors of a frame. It must be a power of two above 256. */
+#define COLOR_HASH_SIZE 512
+#define COLOR_HASH_BITS 9
+
+/* The number of levels of red, green and blue of the color cube used for frames with too many colors. */
+#define CUBE_RED   6
+#define CUBE_GREEN 7
+#define CUBE_BLUE  6
+
+
+/**
+ * The data of a frame is written in sub-blocks of at most 255 bytes, each led by its length.
+ * This collects the variable-length LZW codes into bytes, and the bytes into sub-blocks.
+ *
+ * @field FILE* file - The file the sub-blocks are written to.
+ *
+ * @field Uint8 block[255], int length - The sub-block being filled, and how full it is.
+ *
+ * @field Uint32 bits, int count - The bits not yet collected into a byte, and how many there are.
+ */
+typedef struct BlockWriter {
+    FILE*  file;
+    Uint8  block[255];
+    int    length;
+    Uint32 bits;
+    int    count;
+} BlockWriter;
+
+
+/**
+ * This function writes the sub-block being filled, if it is not empty.
+ *
+ * @param BlockWriter* writer - A pointer to the block writer.
+ */
+static void flushBlock(BlockWriter* writer)
+{
+    if (writer->length > 0) {
+        fputc(writer->length, writer->file);
+        fwrite(writer->block, 1, (size_t) writer->length, writer->file);
+        writer->length = 0;
+    }
+}
+
+
+/**
+ * This function appends an LZW code to the sub-blocks, least significant bit first.
+ *
+ * @param BlockWriter* writer - A pointer to the block writer.
+ *
+ * @param Uint32 code - The code.
+ *
+ * @param int size - The length of the code in bits, at most 12.
+ */
+static void putCode(BlockWriter* writer, Uint32 code, int size)
+{
+    writer->bits  |= code << writer->count;
+    writer->count += size;
+
+    while (writer->count >= 8) {
+        writer->block[writer->length++] = (Uint8) writer->bits;
+        if (writer->length == 255) {
+            flushBlock(writer);
+        }
+        writer->bits  >>= 8;
+        writer->count  -= 8;
+    }
+}
+
+
+/**
+ * This function writes a 16-bit number in little-endian byte order, as everything in a GIF file is.
+ */
+static void putShort(FILE* file, int value)
+{
+    fputc(value & 0xFF, file);
+    fputc((value >> 8) & 0xFF, file);
+}
+
+
+/**
+ * This function compresses the color indices of a frame with LZW, as GIF files require,
+ * and writes them as sub-blocks, followed by the empty sub-block which ends them.
+ *
+ * The dictionary maps a string of indices, given as the code of all of it but its last
+ * index and that last index, to its code. It is kept in a hash table.
+ *
+ * @param GifWriter* gif - A pointer to the writer, which has the hash table.
+ *
+ * @param const Uint8* indices - The color indices.
+ *
+ * @param size_t count - The number of color indices, at least 1.
+ *
+ * @param int min_code_size - The number of bits of a color index, at least 2.
+ */
+static void writeLzw(GifWriter* gif, const Uint8* indices, size_t count, int min_code_size)
+{
+    const Uint32 clear = 1u << min_code_size;
+    const Uint32 end   = clear + 1;
+
+    BlockWriter writer;
+    Uint32      next      = end + 1;
+    int         code_size = min_code_size + 1;
+    Uint32      current   = indices[0];
+    size_t      i;
+
+    writer.file   = gif->file;
+    writer.length = 0;
+    writer.bits   = 0;
+    writer.count  = 0;
+
+    fputc(min_code_size, gif->file);
+    memset(gif->lzw_keys, 0, LZW_HASH_SIZE * sizeof(Uint32));
+    putCode(&writer, clear, code_size);
+
+    for (i = 1; i < count; ++i) {
+	// The key is never 0, which marks an empty slot.
+        Uint32 key  = ((current << 8) | indices[i]) + 1;
+        Uint32 slot = (key * 2654435761u) >> (32 - LZW_HASH_BITS);
+
+        while (gif->lzw_keys[slot] != 0 && gif->lzw_keys[slot] != key) {
+            slot = (slot + 1) & (LZW_HASH_SIZE - 1);
+        }
+        if (gif->lzw_keys[slot] == key) {
+	    // The string goes on, try a longer one.
+            current = gif->lzw_codes[slot];
+            continue;
+        }
+
+	// The longest string in the dictionary ends here. Its code is written,
+	// and it is added to the dictionary with the next index after it.
+        putCode(&writer, current, code_size);
+        gif->lzw_keys[slot]  = key;
+        gif->lzw_codes[slot] = (Uint16) next;
+        if (next >= (1u << code_size)) {
+            ++code_size;
+        }
+        if (next == LZW_MAX_CODES - 1) {
+	    // The dictionary is full, so it is started over.
+            putCode(&writer, clear, code_size);
+            memset(gif->lzw_keys, 0, LZW_HASH_SIZE * sizeof(Uint32));
+            next      = end + 1;
+            code_size = min_code_size + 1;
+        } else {
+            ++next;
+        }
+        current = indices[i];
+    }
+    putCode(&writer, current, code_size);
+
+    // The reader adds one more string to its dictionary after the last code,
+    // which may make the end code one bit longer.
+    if (next == (1u << code_size) && code_size < 12) {
+        ++code_size;
+    }
+    putCode(&writer, end, code_size);
+
+    if (writer.count > 0) {
+        putCode(&writer, 0, 8 - writer.count);
+    }
+    flushBlock(&writer);
+    fputc(0, gif->file);
+}
+
+
+/**
+ * This function writes the rectangle of the last frame which differs from what the frames
+ * written so far show, with its own color table, to be shown for the given time.
+ *
+ * @param GifWriter* gif - A pointer to the writer.
+ *
+ * @param Uint32 delay - How long the frame is shown, in hundredths of a second.
+ */
+static void writeFrame(GifWriter* gif, Uint32 delay)
+{
+    const SDL_Rect box = gif->box;
+
+    Uint32 keys[COLOR_HASH_SIZE];
+    Uint8  values[COLOR_HASH_SIZE];
+    Uint8  palette[256 * 3];
+    int    colors = 0;
+    int    bits   = 1;
+    size_t count  = 0;
+    int    x, y;
+
+    memset(keys, 0, sizeof(keys));
+
+    // Gives every color in the rectangle an index, as long as there are at most 256 of them.
+    for (y = box.y; y < box.y + box.h && colors <= 256; ++y) {
+        const Uint32* row = gif->frame + (size_t) y * gif->width;
+
+        for (x = box.x; x < box.x + box.w; ++x) {
+	    // The key is never 0, which marks an empty slot.
+            Uint32 key  = (row[x] & 0xFFFFFF) | 0x1000000;
+            Uint32 slot = (key * 2654435761u) >> (32 - COLOR_HASH_BITS);
+
+            while (keys[slot] != 0 && keys[slot] != key) {
+                slot = (slot + 1) & (COLOR_HASH_SIZE - 1);
+            }
+            if (keys[slot] != key) {
+                if (colors == 256) {
+                    colors = 257;
+                    break;
+                }
+                keys[slot]   = key;
+                values[slot] = (Uint8) colors;
+                palette[colors * 3 + 0] = (Uint8) (key >> 16);
+                palette[colors * 3 + 1] = (Uint8) (key >> 8);
+                palette[colors * 3 + 2] = (Uint8) key;
+                ++colors;
+            }
+            gif->indices[count++] = values[slot];
+        }
+    }
+
+    // Too many colors, so every pixel gets the nearest color of the color cube instead.
+    if (colors > 256) {
+        int r, g, b;
+
+        colors = 0;
+        for (r = 0; r < CUBE_RED; ++r) {
+            for (g = 0; g < CUBE_GREEN; ++g) {
+                for (b = 0; b < CUBE_BLUE; ++b) {
+                    palette[colors * 3 + 0] = (Uint8) (r * 255 / (CUBE_RED - 1));
+                    palette[colors * 3 + 1] = (Uint8) (g * 255 / (CUBE_GREEN - 1));
+                    palette[colors * 3 + 2] = (Uint8) (b * 255 / (CUBE_BLUE - 1));
+                    ++colors;
+                }
+            }
+        }
+
+        count = 0;
+        for (y = box.y; y < box.y + box.h; ++y) {
+            const Uint32* row = gif->frame + (size_t) y * gif->width;
+
+            for (x = box.x; x < box.x + box.w; ++x) {
+                Uint32 color = row[x];
+
+                r = (int) (((color >> 16) & 0xFF) * (CUBE_RED - 1) + 127) / 255;
+                g = (int) (((color >> 8) & 0xFF) * (CUBE_GREEN - 1) + 127) / 255;
+                b = (int) ((color & 0xFF) * (CUBE_BLUE - 1) + 127) / 255;
+                gif->indices[count++] = (Uint8) ((r * CUBE_GREEN + g) * CUBE_BLUE + b);
+            }
+        }
+    }
+
+    // The color table has a power of two entries, the unused ones are black.
+    while ((1 << bits) < colors) {
+        ++bits;
+    }
+    memset(palette + colors * 3, 0, (size_t) ((1 << bits) - colors) * 3);
+
+    // The graphic control extension: the rectangle is left in place when the next frame comes,
+    // and shown for delay hundredths of a second.
+    fputc(0x21, gif->file);
+    fputc(0xF9, gif->file);
+    fputc(4, gif->file);
+    fputc(0x04, gif->file);
+    putShort(gif->file, (int) delay);
+    fputc(0, gif->file);
+    fputc(0, gif->file);
+
+    // The image descriptor, with the local color table after it.
+    fputc(0x2C, gif->file);
+    putShort(gif->file, box.x);
+    putShort(gif->file, box.y);
+    putShort(gif->file, box.w);
+    putShort(gif->file, box.h);
+    fputc(0x80 | (bits - 1), gif->file);
+    fwrite(palette, 3, (size_t) 1 << bits, gif->file);
+
+    writeLzw(gif, gif->indices, count, (bits < 2) ? 2 : bits);
+
+    ++gif->count;
+}
+
+
+/**
+ * This function finds the first pixel in which two rows differ.
+ *
+ * @param const Uint32* a, const Uint32* b - The two rows.
+ *
+ * @param int n - The number of pixels to compare.
+ *
+ * @return int - The index of the first pixel which differs, or n if none does.
+ */
+static int firstDifference(const Uint32* a, const Uint32* b, int n)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    // 8 pixels at a time, until a group of 8 has a difference in it.
+    for (; i + 8 <= n; i += 8) {
+        __m128i low  = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (a + i)),
+                                       _mm_loadu_si128((const __m128i*) (b + i)));
+        __m128i high = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (a + i + 4)),
+                                       _mm_loadu_si128((const __m128i*) (b + i + 4)));
+
+        if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+
+/**
+ * This function finds the last pixel in which two rows differ.
+ *
+ * @param const Uint32* a, const Uint32* b - The two rows.
+ *
+ * @param int n - The number of pixels to compare.
+ *
+ * @return int - The index of the last pixel which differs, or -1 if none does.
+ */
+static int lastDifference(const Uint32* a, const Uint32* b, int n)
+{
+    int i = n;
+
+#ifdef __SSE2__
+    // 8 pixels at a time from the end, until a group of 8 has a difference in it.
+    for (; i >= 8; i -= 8) {
+        __m128i low  = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (a + i - 8)),
+                                       _mm_loadu_si128((const __m128i*) (b + i - 8)));
+        __m128i high = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (a + i - 4)),
+                                       _mm_loadu_si128((const __m128i*) (b + i - 4)));
+
+        if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF) {
+            break;
+        }
+    }
+#endif
+
+    while (i > 0) {
+        --i;
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+/**
+ * This function finds a row of pixels.
+ *
+ * @param const void* pixels, int pitch - The pixels, and the length of a row in bytes.
+ *
+ * @param int y - The number of the row.
+ *
+ * @return const Uint32* - The first pixel of the row.
+ */
+static const Uint32* rowOf(const void* pixels, int pitch, int y)
+{
+    return (const Uint32*) ((const Uint8*) pixels + (size_t) y * pitch);
+}
+
+
+/**
+ * This function finds the smallest rectangle around the pixels in which a new frame
+ * differs from the last one.
+ *
+ * @param const GifWriter* gif - A pointer to the writer, which has the last frame.
+ *
+ * @param const void* pixels, int pitch - The new frame.
+ *
+ * @param SDL_Rect* box - Receives the rectangle.
+ *
+ * @return int - 1 if any pixel differs, 0 if none does.
+ */
+static int findChanges(const GifWriter* gif, const void* pixels, int pitch, SDL_Rect* box)
+{
+    const int width     = gif->width;
+    const int pitch_old = width * (int) sizeof(Uint32);
+    int       top       = 0;
+    int       bottom;
+    int       left      = width;
+    int       right     = -1;
+    int       y;
+
+    while (top < gif->height &&
+           firstDifference(rowOf(pixels, pitch, top), rowOf(gif->frame, pitch_old, top), width) == width) {
+        ++top;
+    }
+    if (top == gif->height) {
+        return 0;
+    }
+    bottom = gif->height - 1;
+    while (lastDifference(rowOf(pixels, pitch, bottom), rowOf(gif->frame, pitch_old, bottom), width) < 0) {
+        --bottom;
+    }
+
+    // Each row only has to be searched outside of the columns already known to differ.
+    for (y = top; y <= bottom; ++y) {
+        const Uint32* a     = rowOf(pixels, pitch, y);
+        const Uint32* b     = rowOf(gif->frame, pitch_old, y);
+        int           first = firstDifference(a, b, left);
+        int           last  = lastDifference(a + right + 1, b + right + 1, width - right - 1);
+
+        if (first < left) {
+            left = first;
+        }
+        if (last >= 0) {
+            right += 1 + last;
+        }
+    }
+
+    box->x = left;
+    box->y = top;
+    box->w = right - left + 1;
+    box->h = bottom - top + 1;
+
+    return 1;
+}
+
+
+int gifWriterOpen(GifWriter* gif, const char* path, int width, int height)
+{
+    size_t pixels = (size_t) width * height;
+
+    gif->width     = width;
+    gif->height    = height;
+    gif->time      = 0;
+    gif->started   = 0;
+    gif->count     = 0;
+    gif->failed    = 0;
+    gif->frame     = (Uint32*) malloc(pixels * sizeof(Uint32));
+    gif->pixels    = (Uint32*) malloc(pixels * sizeof(Uint32));
+    gif->indices   = (Uint8*) malloc(pixels);
+    gif->lzw_keys  = (Uint32*) malloc(LZW_HASH_SIZE * sizeof(Uint32));
+    gif->lzw_codes = (Uint16*) malloc(LZW_HASH_SIZE * sizeof(Uint16));
+    gif->file      = NULL;
+    if (gif->frame && gif->pixels && gif->indices && gif->lzw_keys && gif->lzw_codes) {
+        gif->file = fopen(path, "wb");
+    }
+    if (!gif->file) {
+        free(gif->frame);
+        free(gif->pixels);
+        free(gif->indices);
+        free(gif->lzw_keys);
+        free(gif->lzw_codes);
+        return -1;
+    }
+
+    // The header and the logical screen, without a global color table.
+    fwrite("GIF89a", 1, 6, gif->file);
+    putShort(gif->file, width);
+    putShort(gif->file, height);
+    fputc(0, gif->file);
+    fputc(0, gif->file);
+    fputc(0, gif->file);
+
+    // The application extension which makes the animation play in a loop forever.
+    fputc(0x21, gif->file);
+    fputc(0xFF, gif->file);
+    fputc(11, gif->file);
+    fwrite("NETSCAPE2.0", 1, 11, gif->file);
+    fputc(3, gif->file);
+    fputc(1, gif->file);
+    putShort(gif->file, 0);
+    fputc(0, gif->file);
+
+    return ferror(gif->file) ? -1 : 0;
+}
+
+
+int gifWriterFrame(GifWriter* gif, const void* pixels, int pitch, Uint32 time)
+{
+    SDL_Rect changes;
+    int      y;
+
+    // The first frame is written whole.
+    if (!gif->started) {
+        for (y = 0; y < gif->height; ++y) {
+            memcpy(gif->frame + (size_t) y * gif->width, (const Uint8*) pixels + (size_t) y * pitch,
+                   (size_t) gif->width * sizeof(Uint32));
+        }
+        gif->box.x   = 0;
+        gif->box.y   = 0;
+        gif->box.w   = gif->width;
+        gif->box.h   = gif->height;
+        gif->time    = time;
+        gif->started = 1;
+        return 0;
+    }
+
+    // Nothing changed, so the last frame is just shown for longer.
+    if (!findChanges(gif, pixels, pitch, &changes)) {
+        return 0;
+    }
+
+    if (time - gif->time >= GIF_MIN_DELAY_MS) {
+	// The last frame is written, now that it is known how long it is shown.
+	// The delay is rounded the same way for every frame, so the rounding errors do not add up.
+        Uint32 delay = time / 10 - gif->time / 10;
+
+        writeFrame(gif, (delay > 0xFFFF) ? 0xFFFF : delay);
+        gif->box  = changes;
+        gif->time = time;
+    } else {
+	// The last frame was shown too briefly, so it is left out, and the changes of this one
+	// are written together with its own, from the time it came on.
+        int right  = SDL_max(gif->box.x + gif->box.w, changes.x + changes.w);
+        int bottom = SDL_max(gif->box.y + gif->box.h, changes.y + changes.h);
+
+        gif->box.x = SDL_min(gif->box.x, changes.x);
+        gif->box.y = SDL_min(gif->box.y, changes.y);
+        gif->box.w = right - gif->box.x;
+        gif->box.h = bottom - gif->box.y;
+    }
+
+    // Only the rows and the columns which changed are copied.
+    for (y = changes.y; y < changes.y + changes.h; ++y) {
+        memcpy(gif->frame + (size_t) y * gif->width + changes.x,
+               (const Uint8*) pixels + (size_t) y * pitch + (size_t) changes.x * sizeof(Uint32),
+               (size_t) changes.w * sizeof(Uint32));
+    }
+
+    if (ferror(gif->file)) {
+        gif->failed = 1;
+    }
+    return gif->failed ? -1 : 0;
+}
+
+
+int gifWriterClose(GifWriter* gif, Uint32 time)
+{
+    int failed;
+
+    if (gif->started) {
+        Uint32 delay = time / 10 - gif->time / 10;
+        writeFrame(gif, (delay > 0xFFFF) ? 0xFFFF : delay);
+    }
+
+    // The trailer.
+    fputc(0x3B, gif->file);
+
+    failed = gif->failed || ferror(gif->file);
+    if (fclose(gif->file) != 0) {
+        failed = 1;
+    }
+    gif->file = NULL;
+
+    free(gif->frame);
+    free(gif->pixels);
+    free(gif->indices);
+    free(gif->lzw_keys);
+    free(gif->lzw_codes);
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file    recursion_visualized_gif.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the animated GIF exporter, which writes the frames
+ * that are drawn into an animated GIF file as they are presented, so the animation can be
+ * handed out as a video that any web browser plays.
+ *
+ * Only the last frame is kept in memory. Each new frame is compared against it,
+ * and only the smallest rectangle around the pixels that changed is written into the file,
+ * on top of what the frames before it left behind. Since one step of the animation only
+ * changes a stack frame or two, the file grows, and the time taken grows, with the number of
+ * stack frames that change, not with the number of frames times the size of the window.
+ * The comparison goes 4 pixels at a time with SSE2, wherever it is available.
+ *
+ * A frame is written once the next different frame comes, since only then it is known
+ * how long it is shown. Frames which are shown for less than GIF_MIN_DELAY_MS
+ * are left out, since web browsers do not show frames that short anyway.
+ *
+ * Every frame has a color table of its own, made of the colors in its rectangle.
+ * The program draws with only a few colors, so the tables are small and the colors exact.
+ * A rectangle with more than 256 colors is drawn with the nearest colors of a color cube instead.
+ */
+
+#ifndef RECURSION_VISUALIZED_GIF_H
+#define RECURSION_VISUALIZED_GIF_H
+
+#include "SDL.h"    // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>  // C standard input/output - for FILE
+
+
+/* The shortest time a frame is shown for, in milliseconds. Shorter frames are left out. */
+#define GIF_MIN_DELAY_MS 20
+
+
+/**
+ * An animated GIF file being written.
+ *
+ * @field FILE* file - The open file.
+ *
+ * @field int width, height - The size of the frames, in pixels.
+ *
+ * @field Uint32* frame - The last frame given, in ARGB8888, without padding between the rows.
+ *
+ * @field SDL_Rect box - The rectangle of the last frame which still has to be written,
+ *                       since it differs from what the frames written so far show.
+ *
+ * @field Uint32 time - When the last frame was given, in milliseconds.
+ *
+ * @field int started - Nonzero once the first frame was given.
+ *
+ * @field Uint32* pixels - Room for one frame, for the caller to read the pixels of the next frame into.
+ *
+ * @field Uint8* indices - The color indices of the rectangle being written.
+ *
+ * @field Uint32* lzw_keys, Uint16* lzw_codes - The hash table of the LZW dictionary.
+ *
+ * @field Uint64 count - How many frames have been written.
+ *
+ * @field int failed - Nonzero if writing to the file failed.
+ */
+typedef struct GifWriter {
+    FILE*    file;
+    int      width;
+    int      height;
+    Uint32*  frame;
+    SDL_Rect box;
+    Uint32   time;
+    int      started;
+    Uint32*  pixels;
+    Uint8*   indices;
+    Uint32*  lzw_keys;
+    Uint16*  lzw_codes;
+    Uint64   count;
+    int      failed;
+} GifWriter;
+
+
+/**
+ * This function creates an animated GIF file, which plays in a loop, and writes its header.
+ *
+ * @param GifWriter* gif - A pointer to the writer to initialize.
+ *
+ * @param const char* path - The path of the file to create. An existing file is overwritten.
+ *
+ * @param int width, int height - The size of the frames, in pixels.
+ *
+ * @return int - 0 on success, -1 if the file could not be created or the memory could not be had.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int gifWriterOpen(GifWriter* gif, const char* path, int width, int height);
+
+
+/**
+ * This function gives the writer the next frame. The frame before it is written into the file
+ * if anything changed, otherwise it is just shown for longer.
+ *
+ * @param GifWriter* gif - A pointer to the writer.
+ *
+ * @param const void* pixels - The pixels of the frame, in ARGB8888.
+ *
+ * @param int pitch - The length of a row of pixels in bytes, including any padding.
+ *
+ * @param Uint32 time - When the frame is shown, in milliseconds from any starting point.
+ *
+ * @return int - 0 on success, -1 if writing failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int gifWriterFrame(GifWriter* gif, const void* pixels, int pitch, Uint32 time);
+
+
+/**
+ * This function writes the last frame, and the end of the file, and closes it.
+ *
+ * @param GifWriter* gif - A pointer to the writer.
+ *
+ * @param Uint32 time - When the last frame stops being shown, in milliseconds.
+ *
+ * @return int - 0 on success, -1 if anything written to the file failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int gifWriterClose(GifWriter* gif, Uint32 time);
+
+#endif /* RECURSION_VISUALIZED_GIF_H */
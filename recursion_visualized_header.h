@@ -13,45 +13,110 @@
  * Here also is documentation about what they do.
  */
 
+#ifndef RECURSION_VISUALIZED_HEADER_H
+#define RECURSION_VISUALIZED_HEADER_H
+
 /* These constants define 8-bit rvalues representing the color codes. */
 /* There can be 8 total different color codes. */
 #define LIME 0x01  // 0000_0001
 #define PINK 0x02  // 0000_0010
+#define GOLD 0x04  // 0000_0100
+#define CYAN 0x08  // 0000_1000
+
+#include "recursion_visualized_ring.h"       // StackEvent, EventRing
+#include "recursion_visualized_scheduler.h"  // Scheduler
+#include "recursion_visualized_stackview.h"  // StackView
+#include "recursion_visualized_calltree.h"   // CallTree
+#include "recursion_visualized_timeline.h"   // Timeline
+#include "recursion_visualized_history.h"    // History
+#include "recursion_visualized_gif.h"        // GifWriter
+#include "recursion_visualized_font.h"       // GlyphAtlas
+#include "recursion_visualized_compare.h"    // Comparison
+#include "recursion_visualized_hud.h"        // FrameHud
+#include "recursion_visualized_raster.h"     // Raster
+#include "recursion_visualized_parallel.h"   // Parallel
+#include "recursion_visualized_memo.h"       // MemoMeter
 
 
 /**
  * The runtime stack of this recursive function is drawn to the screen.
- * This function goes up into recursion until rectangle-> y == 90,
+ * This function goes up into recursion until depth == max_depth,
  * then it comes back down and all the stack frames are popped off the runtime stack.
  *
- * Every single stack frame of the function is printed twice:
+ * bunny() runs on its own thread, separately from the rendering.
+ * Instead of drawing each stack frame itself, it emits a compact record into the ring buffer,
+ * and the render loop in main() plays those records back at its own pace.
+ * This way the recursion runs at native speed and never waits for the screen.
+ *
+ * Every single stack frame of the function is recorded twice:
  *   First time on entrance into the recursive function call,
  *   when the stack frame is pushed onto the runtime stack.
  *   Second time just before exit out of the recursive function call,
  *   when the stack frame is just about to be pushed into the stack.
  *
- * When a new stack frame is pushed onto the function call stack, it is drawn in LIME,
+ * When a new stack frame is pushed onto the function call stack, it is recorded in LIME,
  * and when the recursion comes back down, it is being popped of the function call stack,
- * so it is drawn in PINK.
- *
- * The function bunny() handles events recieved by the window by calling handleEvents().
- * Events are handled just before the current stack frame is drawn going up,
- * and just after the stack frame is drawn going down.
+ * so it is recorded in PINK.
  *
- * @param SDL_Renderer* renderer - Pointer to the renderer is needed for drawing shapes onto
- *                                 the screen.
- *          It is also passed to the handleEvents() function to destroy the renderer in case
- *          the program closes unexpectedly.
- *
- * @param SDL_Window* window - Pointer to the window is passed to the handleEvents() function
- *                             to destroy the window in case the program closes unexpectedly.
+ * @param EventRing* ring - The ring buffer into which the push/pop records are emitted.
+ *                          bunny() is its only producer.
  *
  * @param SDL_Rect* rectangle - It is a graphical representation of the current stack frame.
  *                       When a new stack frame is pushed onto the stack, y is decremented, going up.
  *                       When the stack frame is popped off the stack, y is incremented, going up.
  *
- * @param SDL_Event* event - This is the master structure which is used for event handling.
- *                           It is passed into handleEvents().
+ * @param Uint32 depth - The number of stack frames of bunny() on the runtime stack,
+ *                       counting this one. The first call is made with depth 1.
+ *
+ * @param Uint32 max_depth - The depth of the base case.
+ *
+ * @param Uint64 stack_base - Where the runtime stack of the recursion starts: the stack pointer
+ *                            of the caller of the first call, as given by traceStackPointer(),
+ *                            so every record can tell how many bytes of the stack are in use.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void bunny(EventRing* ring, SDL_Rect* rectangle, Uint32 depth, Uint32 max_depth, Uint64 stack_base);
+
+
+/* The default depth of the base case. With the stack frames 50 pixels apart,
+   this is the deepest stack that fits into the window without scrolling or zooming. */
+#define DEFAULT_MAX_DEPTH 11
+
+/* A generous estimate of the size of one stack frame of bunny(), in bytes,
+   used to give the recursion thread a big enough runtime stack for deep recursions. */
+#define BUNNY_FRAME_BYTES 256
+
+
+/**
+ * The arguments handed over to the recursion thread.
+ *
+ * @field EventRing* ring - The ring buffer shared with the render loop.
+ *
+ * @field SDL_Rect box - The initial stack frame, passed by pointer into bunny().
+ *
+ * @field Uint32 max_depth - The depth of the base case of bunny().
+ */
+typedef struct RecursionArgs {
+    EventRing* ring;
+    SDL_Rect   box;
+    Uint32     max_depth;
+} RecursionArgs;
+
+
+/**
+ * This is the entry point of the recursion thread, as required by SDL_CreateThread().
+ *
+ * It starts the recursion by calling bunny(), and when the recursion has finished,
+ * it emits an EVENT_END record so the render loop knows that the animation is over.
+ *
+ * @param void* data - A pointer to the RecursionArgs structure.
+ *
+ * @return int - Always 0.
  *
  * The preprocessor directive is used if we would want to mix C and C++ code together.
  * extern "C" tells the C++ compiler to not mangle the names of functions.
@@ -59,7 +124,114 @@
 #ifdef __cplusplus
   extern "C"
 #endif
-void bunny(SDL_Renderer* renderer, SDL_Window* window, SDL_Rect* rectangle, SDL_Event* event);
+int recursionThread(void* data);
+
+
+/**
+ * Everything the program needs to put pixels somewhere.
+ *
+ * In the normal windowed mode the renderer draws into a visible window.
+ * In the headless mode there is no window at all: SDL runs on its dummy video driver,
+ * and a software renderer draws into an offscreen SDL_Surface in main memory.
+ * This lets the program run on machines without a display or a GPU, such as a render farm or CI.
+ *
+ * @field SDL_Window* window - The visible window, or NULL in the headless mode.
+ *
+ * @field SDL_Renderer* renderer - The renderer into which the back buffer is drawn.
+ *
+ * @field SDL_Surface* surface - The offscreen framebuffer in the headless mode, or NULL otherwise.
+ *
+ * @field int headless - Nonzero in the headless mode. Then the render loop does not pace the
+ *                       animation, every step is drawn, and every presented frame has its
+ *                       pixels hashed and printed to stdout.
+ *
+ * @field Uint32 frame - The number of frames presented so far.
+ *
+ * @field StackView view - The model of the runtime stack, and the viewport it is drawn through.
+ *
+ * @field SDL_Texture* backbuffer - A persistent render target the stack is drawn into, which
+ *                                  keeps its contents from one frame to the next, so only the
+ *                                  stack frames that changed have to be redrawn. It is NULL if
+ *                                  the renderer does not support render targets.
+ *
+ * @field CallTree tree - The tree of every call made so far, for branching recursion.
+ *
+ * @field int show_tree - Nonzero if the call tree is drawn instead of the stack view.
+ *
+ * @field Timeline* timeline - The timeline of the trace file being replayed, or NULL.
+ *
+ * @field History* history - The history of the live run, which can be rewound like a timeline, or NULL.
+ *
+ * @field int dirty - Nonzero if the next frame has to be drawn even though no records
+ *                    were played back, because the viewport moved or the timeline jumped.
+ *
+ * @field Scheduler* scheduler - The scheduler which paces the animation, or NULL.
+ *                               The keyboard pauses, steps, speeds up and slows it down.
+ *
+ * @field GifWriter* gif - The animated GIF file every presented frame is exported into, or NULL.
+ *
+ * @field GlyphAtlas* labels - The glyph atlas the labels of the stack frames are drawn with,
+ *                             or NULL if it could not be made.
+ *
+ * @field int show_labels - Nonzero if the labels of the stack frames are drawn.
+ *
+ * @field Comparison* comparison - The iterative version drawn next to the recursion, or NULL.
+ *                                 Then the stack view takes up the left pane of the window.
+ *
+ * @field FrameHud* hud - The timings of the frames, and their overlay, or NULL if they are not kept.
+ *
+ * @field Raster* raster - In the headless mode, a software raster in main memory which the stack
+ *                         is drawn into instead of the backbuffer texture, and which is then copied
+ *                         into the offscreen surface, or NULL to draw with the renderer.
+ *
+ * @field Parallel* parallel - The parallel run whose workers are drawn in lanes side by side, or NULL.
+ *                             Then the stack view only holds the viewport that the lanes follow.
+ *
+ * @field MemoMeter* memo - The counters of the memoization cache of the run, drawn on top, or NULL.
+ */
+typedef struct Visualizer {
+    SDL_Window*   window;
+    SDL_Renderer* renderer;
+    SDL_Surface*  surface;
+    int           headless;
+    Uint32        frame;
+    StackView     view;
+    SDL_Texture*  backbuffer;
+    CallTree      tree;
+    int           show_tree;
+    Timeline*     timeline;
+    History*      history;
+    int           dirty;
+    Scheduler*    scheduler;
+    GifWriter*    gif;
+    GlyphAtlas*   labels;
+    int           show_labels;
+    Comparison*   comparison;
+    FrameHud*     hud;
+    Raster*       raster;
+    Parallel*     parallel;
+    MemoMeter*    memo;
+} Visualizer;
+
+
+/**
+ * This function deallocates everything owned by the Visualizer:
+ * the backbuffer SDL_Texture, the glyph atlas, the SDL_Renderer, the SDL_Window and the offscreen SDL_Surface,
+ * whichever of them exist, the memory of the stack view and of the call tree,
+ * the checkpoints of the timeline, the history with its temporary file, the comparison, the parallel run,
+ * the software raster, and the frame timings, which are written into their CSV file first, if they have one.
+ * The animated GIF being exported is finished and closed,
+ * so that it is complete even if the window is closed in the middle of the animation.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer to tear down.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void destroyVisualizer(Visualizer* vis);
 
 
 /**
@@ -71,14 +243,45 @@ void bunny(SDL_Renderer* renderer, SDL_Window* window, SDL_Rect* rectangle, SDL_
  * Event handling is also required by the OS.
  * This is necessary to keep the OS from marking the program as unresponsive.
  *
- * This function is called each twice for each recursive call of bunny(),
- * once on entrance into the recursive function call, and once on exit.
+ * The keyboard and the mouse wheel move the viewport of the stack view:
+ *   Up, Down, mouse wheel  scroll along the stack
+ *   Page Up, Page Down     scroll by a whole window
+ *   +, -                   zoom in and out
+ *   Home, F                fit the whole stack into the window
+ *   End                    go back to the top of the stack
+ *   B                      switch between drawing the stack frames alike and in proportion
+ *                          to their real size, with the stack in use shown in the title
+ *   T                      switch between the stack view and the call tree
+ *   H                      show and hide the overlay of the frame timings
  *
- * @param SDL_Renderer* renderer - In case the program is closed unexpectedly, we need to
- *                                 dealoccate the dynamic SDL_Renderer object.
+ * The keyboard also controls the pace of the animation:
+ *   Space                  pause and resume
+ *   Period                 pause, and play one step forwards
+ *   Z, X                   halve and double the animation rate
  *
- * @param SDL_Window* window - In case the program is closed unexpectedly, we need to
- *                             dealoccate the dynamic SDL_Window object.
+ * While a trace file is replayed, or a live run keeps its history, the keyboard and the mouse
+ * also scrub along its timeline. A live run goes on from where its history ends:
+ *   Comma, Period          pause, and go one step back or forwards
+ *   [, ]                   a hundredth of the trace back or forwards
+ *   0 to 9                 jump to 0% to 90% of the trace
+ *   Left mouse button      jump to the step under the mouse, from the start on the left
+ *                          to the end on the right, also while dragging
+ *
+ * While the call tree is shown, the keys move its viewport instead:
+ *   Left, Right, mouse wheel  scroll sideways along the tree
+ *   +, -                      zoom in and out around the active call
+ *   Home, F                   fit the whole tree into the window
+ *   End                       follow the active call
+ *
+ * When the contents of the window are lost, because it was resized or exposed,
+ * or the renderer lost its render targets, the next frame is redrawn in full.
+ *
+ * This function is called by the render loop in main() on the main thread,
+ * once before each frame is drawn, and as soon as an event ends the wait between two frames.
+ * The time it takes is added to the events stage of the next frame.
+ *
+ * @param Visualizer* vis - In case the program is closed unexpectedly, we need to
+ *                          dealoccate the dynamic SDL_Window and SDL_Renderer objects.
  *
  * @param SDL_Event* event - A pointer to the event handler master structure.
  *        Because sizeof(SDL_Event) == 56, I do not want to create a local variable on the runtime stack.
@@ -89,24 +292,113 @@ void bunny(SDL_Renderer* renderer, SDL_Window* window, SDL_Rect* rectangle, SDL_
 #ifdef __cplusplus
   extern "C"
 #endif
-void handleEvents(SDL_Renderer* renderer, SDL_Window* window, SDL_Event* event);
+void handleEvents(Visualizer* vis, SDL_Event* event);
+
+
+/**
+ * This function holds the frame on the screen before or after the recursion
+ * for the time given by schedulerHoldTime(), or for as long as the animation is paused,
+ * until it is stepped or resumed. Events are handled as soon as they arrive meanwhile,
+ * and the frame is redrawn if they moved the viewport.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer, which has a scheduler.
+ *
+ * @param SDL_Event* event - A pointer to the event handler master structure.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void holdFrame(Visualizer* vis, SDL_Event* event);
 
 
 /**
  * This function updates the scene on the screen.
  *
- * It draws the current stack frame that function bunny() is currently in
- * relatively proportional to other stack frames in the call stack.
+ * It draws the stack frames of bunny() which are on the runtime stack right now,
+ * relatively proportional to each other, as seen through the viewport of the stack view.
+ * Deep stacks are drawn with less detail, see recursion_visualized_stackview.h.
+ * If the call tree is shown instead, every call made so far is drawn as a tree,
+ * see recursion_visualized_calltree.h, and the whole frame is always redrawn.
+ *
+ * If the Visualizer has a backbuffer texture, the stack is drawn into it incrementally:
+ * only the stack frames that were pushed, recolored or popped since the last frame are redrawn.
+ * The whole backbuffer is cleared and redrawn only when the viewport moved, or the contents were lost.
+ * The backbuffer is then copied onto the screen.
+ *
+ * If the Visualizer has a software raster, the stack and its labels are drawn the same way,
+ * into the raster instead of the backbuffer texture, and the raster is copied into the offscreen
+ * surface, without going through the renderer. The call tree and the overlay of the frame timings
+ * are still drawn with the renderer.
+ *
+ * While the stack frames are drawn in proportion to their real size, the title of the window
+ * also shows how many bytes of the runtime stack are in use.
+ *
+ * The title of the window also tells while the animation is paused, and at what rate it plays.
+ *
+ * In the comparison mode, the stack view is drawn into the left pane, and the iterative version
+ * into the right one, with the counters of both on top, see recursion_visualized_compare.h.
+ *
+ * In the parallel mode, the runtime stacks of the workers are drawn instead, in lanes side by side,
+ * scrolled and zoomed like the stack view, with the counters of each worker on top,
+ * see recursion_visualized_parallel.h.
+ *
+ * If the run looks its calls up in a memoization cache, the counters of the cache are drawn
+ * across the top of the window, see recursion_visualized_memo.h.
+ *
+ * Every stage of the frame is timed into the HUD, and the overlay of the timings is drawn
+ * on top of everything while it is shown, see recursion_visualized_hud.h.
+ *
+ * It does not sleep. The pace of the animation is decided by the Scheduler in the render loop.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer whose stack view is drawn
+ *                          into the back buffer of its renderer.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void drawStack(Visualizer* vis);
+
+
+/**
+ * This function presents the back buffer onto the front buffer.
+ *
+ * In the headless mode there is nothing to look at, so instead it hashes the pixels
+ * of the offscreen framebuffer and prints one line per frame to stdout:
+ *   frame <number> <64-bit hash in hexadecimal>
+ * Comparing these lines between two runs catches rendering regressions.
+ *
+ * If an animated GIF is being exported, the frame is also given to it, before it is presented.
+ * A windowed frame is shown for as long as it really was on the screen. Nobody watches
+ * a headless run, so there each frame is shown for one step at the animation rate.
+ *
+ * @param Visualizer* vis - A pointer to the Visualizer to present.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void presentFrame(Visualizer* vis);
+
+
+/**
+ * This function computes a fast 64-bit hash of the pixels of a surface.
  *
- * @param SDL_Renderer* renderer - A pointer to the renderer into which the
- *                                 back buffer is going to be drawn.
+ * It is the FNV-1a hash, except that it consumes 8 bytes at a time instead of 1,
+ * which makes it fast enough to hash thousands of frames per second.
+ * The padding at the end of each row (pitch - width * bytes per pixel) is not hashed.
  *
- * @param const SDL_Rect* rectangle - A pointer to the rectangle object, which represents
- *                                    the stack frame and its dimensions.
+ * @param const SDL_Surface* surface - The surface whose pixels are hashed.
+ *                                     It must not need locking, like a software surface.
  *
- * @param Uint8 color - Specifies the color to draw the box in.
- *                      LIME if the stack frame is being popped onto the runtime stack.
- *                      PINK if the stack frame if being popped off the runtime stack.
+ * @return Uint64 - The hash of the pixels.
  *
  * The preprocessor directive is used if we would want to mix C and C++ code together.
  * extern "C" tells the C++ compiler to not mangle the names of functions.
@@ -114,5 +406,6 @@ void handleEvents(SDL_Renderer* renderer, SDL_Window* window, SDL_Event* event);
 #ifdef __cplusplus
   extern "C"
 #endif
-void drawStack(SDL_Renderer* renderer, const SDL_Rect* rectangle, Uint8 color);
+Uint64 hashFrame(const SDL_Surface* surface);
 
+#endif /* RECURSION_VISUALIZED_HEADER_H */
@@ -0,0 +1,600 @@
+/**
+ * @file    recursion_visualized_history.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the history functions.
+ */
+
+#include "SDL.h"      // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>    // C standard input/output - for tmpfile(), fileno(), fclose()
+#include <stdlib.h>   // C standard library - for malloc(), realloc(), free()
+#include <string.h>   // C strings - for memcpy(), memset()
+#include <unistd.h>   // POSIX - for pread(), pwrite()
+#include <sys/types.h>  // POSIX - for off_t, ssize_t
+
+#include "recursion_visualized_history.h"
+#include "recursion_visualized_timeline.h"   // ColorRun, TIMELINE_CATCH_UP
+#include "recursion_visualized_tracefile.h"  // traceEncode(), traceDecode()
+
+
+/* The run_count of a chunk whose stack did not fit into it. */
+#define HISTORY_NO_CHECKPOINT 0xFFFFFFFFu
+
+/* The most runs the checkpoint of a chunk may take, a quarter of the chunk. */
+#define HISTORY_MAX_RUNS ((Uint32) (HISTORY_CHUNK_SIZE / 4 / sizeof(ColorRun)))
+
+/* A page which does not hold any chunk. */
+#define HISTORY_NO_CHUNK 0xFFFFFFFFu
+
+
+/**
+ * The start of every chunk. It is followed by the runs of its checkpoint, and then by the records.
+ *
+ * @field Uint64 step, Uint64 calls - The number of records and of pushes before the chunk.
+ *
+ * @field StackEvent last - The record just before the chunk.
+ *
+ * @field Uint32 depth - The depth of the stack at the start of the chunk.
+ *
+ * @field Uint32 run_count - The number of runs of colors and sizes of the stack frames,
+ *                           or HISTORY_NO_CHECKPOINT if there were too many of them.
+ *
+ * @field Uint32 records - Where the records start in the chunk.
+ *
+ * @field Uint32 size - Where the records end in the chunk.
+ */
+typedef struct ChunkHeader {
+    Uint64     step;
+    Uint64     calls;
+    StackEvent last;
+    Uint32     depth;
+    Uint32     run_count;
+    Uint32     records;
+    Uint32     size;
+} ChunkHeader;
+
+
+/**
+ * This function writes the oldest chunk still in memory to the end of the temporary file,
+ * and gives its memory back to the pool. The chunk being appended to is never written out.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @return int - 0 on success, -1 if there is no chunk to write out, or writing failed.
+ */
+static int spillChunk(History* history)
+{
+    Uint32       index = history->spilled;
+    Uint8*       chunk;
+    const Uint8* data;
+    size_t       size;
+    off_t        offset;
+
+    if (history->failed || index + 1 >= history->chunk_count) {
+        return -1;
+    }
+
+    if (!history->file) {
+        history->file = tmpfile();
+        if (!history->file) {
+            history->failed = 1;
+            return -1;
+        }
+    }
+
+    // Every chunk has a place of its own in the file, so it can be found without an index.
+    // Only the part of it which is used is written, which is all of it but a record or so.
+    chunk  = history->chunks[index];
+    data   = chunk;
+    size   = ((const ChunkHeader*) chunk)->size;
+    offset = (off_t) index * HISTORY_CHUNK_SIZE;
+    while (size > 0) {
+        ssize_t written = pwrite(fileno(history->file), data, size, offset);
+        if (written <= 0) {
+            history->failed = 1;
+            return -1;
+        }
+        data   += written;
+        size   -= (size_t) written;
+        offset += written;
+    }
+
+    history->chunks[index] = NULL;
+    history->pool[history->pool_count++] = chunk;
+    ++history->spilled;
+
+    return 0;
+}
+
+
+/**
+ * This function takes a chunk of memory out of the pool. If the pool is empty, a new one is
+ * allocated while the budget allows, otherwise the oldest chunk in memory is written out for it.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @return Uint8* - The chunk of memory, or NULL if there is none.
+ */
+static Uint8* takeChunk(History* history)
+{
+    Uint8* chunk;
+
+    if (history->pool_count == 0) {
+        if (history->allocated < history->budget) {
+            chunk = (Uint8*) malloc(HISTORY_CHUNK_SIZE);
+            if (chunk) {
+                ++history->allocated;
+            }
+            return chunk;
+        }
+        if (spillChunk(history) != 0) {
+            return NULL;
+        }
+    }
+
+    return history->pool[--history->pool_count];
+}
+
+
+/**
+ * This function finds the memory of a chunk. A chunk which was written out is read back
+ * into the page which was used the longest time ago, unless it is in one already.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param Uint32 index - The index of the chunk.
+ *
+ * @return const Uint8* - The memory of the chunk, which stays valid until the next call,
+ *                        or NULL if it could not be read back.
+ */
+static const Uint8* chunkData(History* history, Uint32 index)
+{
+    Uint8*  page;
+    size_t  size = HISTORY_CHUNK_SIZE;
+    off_t   offset;
+    int     slot = 0;
+    int     i;
+
+    if (index >= history->spilled) {
+        return history->chunks[index];
+    }
+
+    ++history->uses;
+    for (i = 0; i < HISTORY_PAGES; ++i) {
+        if (history->pages[i] && history->paged[i] == index) {
+            history->used[i] = history->uses;
+            return history->pages[i];
+        }
+        if (history->used[i] < history->used[slot]) {
+            slot = i;
+        }
+    }
+
+    if (!history->pages[slot]) {
+        history->pages[slot] = takeChunk(history);
+        if (!history->pages[slot]) {
+            return NULL;
+        }
+    }
+    page   = history->pages[slot];
+    offset = (off_t) index * HISTORY_CHUNK_SIZE;
+    history->paged[slot] = HISTORY_NO_CHUNK;
+
+    // The last chunk written out may end before its place in the file does.
+    while (size > 0) {
+        ssize_t got = pread(fileno(history->file), page + (HISTORY_CHUNK_SIZE - size), size, offset);
+        if (got < 0) {
+            history->failed = 1;
+            return NULL;
+        }
+        if (got == 0) {
+            break;
+        }
+        size   -= (size_t) got;
+        offset += got;
+    }
+    if (HISTORY_CHUNK_SIZE - size < sizeof(ChunkHeader) ||
+        ((const ChunkHeader*) page)->size > HISTORY_CHUNK_SIZE - size) {
+        history->failed = 1;
+        return NULL;
+    }
+
+    history->paged[slot] = index;
+    history->used[slot]  = history->uses;
+
+    return page;
+}
+
+
+/**
+ * This function starts a new chunk, with a checkpoint of the stack view at the end of the history.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param const StackView* view - The stack view, after every record in the history.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated or the file could not be written.
+ */
+static int openChunk(History* history, const StackView* view)
+{
+    ChunkHeader* header;
+    ColorRun*    runs;
+    Uint8*       chunk;
+    Uint32       run_count = 0;
+    Uint32       frame;
+
+    if (history->chunk_count == history->chunk_capacity) {
+        Uint32  capacity = (history->chunk_capacity > 0) ? history->chunk_capacity * 2 : 64;
+        Uint8** chunks   = (Uint8**) realloc(history->chunks, capacity * sizeof(Uint8*));
+        Uint64* steps;
+        if (!chunks) {
+            return -1;
+        }
+        history->chunks = chunks;
+        steps = (Uint64*) realloc(history->steps, capacity * sizeof(Uint64));
+        if (!steps) {
+            return -1;
+        }
+        history->steps          = steps;
+        history->chunk_capacity = capacity;
+    }
+
+    chunk = takeChunk(history);
+    if (!chunk) {
+        return -1;
+    }
+
+    // Save the colors and sizes of the stack frames run-length encoded, like the timeline does,
+    // unless there are so many runs that they would crowd out the records.
+    header = (ChunkHeader*) chunk;
+    runs   = (ColorRun*) (chunk + sizeof(ChunkHeader));
+    for (frame = 0; frame < view->depth; ++frame) {
+        Uint8  color = view->colors[frame];
+        Uint64 bytes = (frame > 0) ? view->stack[frame] - view->stack[frame - 1] : view->stack[0];
+
+        if (run_count > 0 && runs[run_count - 1].color == color && runs[run_count - 1].bytes == bytes) {
+            ++runs[run_count - 1].length;
+        } else if (run_count < HISTORY_MAX_RUNS) {
+            runs[run_count].bytes  = bytes;
+            runs[run_count].length = 1;
+            runs[run_count].color  = color;
+            ++run_count;
+        } else {
+            run_count = HISTORY_NO_CHECKPOINT;
+            break;
+        }
+    }
+
+    header->step      = history->count;
+    header->calls     = history->calls;
+    header->last      = history->last;
+    header->depth     = view->depth;
+    header->run_count = run_count;
+    header->records   = (Uint32) sizeof(ChunkHeader);
+    if (run_count != HISTORY_NO_CHECKPOINT) {
+        header->records += run_count * (Uint32) sizeof(ColorRun);
+    }
+    header->size = header->records;
+
+    history->chunks[history->chunk_count] = chunk;
+    history->steps[history->chunk_count]  = history->count;
+    ++history->chunk_count;
+
+    return 0;
+}
+
+
+/**
+ * This function reads the record after a cursor, and moves the cursor past it.
+ * There must be a record after it.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param HistoryCursor* cursor - The cursor.
+ *
+ * @param StackEvent* event - Receives the record.
+ *
+ * @return int - 0 on success, -1 if the chunk could not be read back, or the record is damaged.
+ */
+static int readRecord(History* history, HistoryCursor* cursor, StackEvent* event)
+{
+    const Uint8*       chunk  = chunkData(history, cursor->chunk);
+    const ChunkHeader* header = (const ChunkHeader*) chunk;
+
+    if (!chunk) {
+        return -1;
+    }
+    if (cursor->offset >= header->size) {
+        ++cursor->chunk;
+        chunk  = chunkData(history, cursor->chunk);
+        header = (const ChunkHeader*) chunk;
+        if (!chunk) {
+            return -1;
+        }
+        cursor->offset = header->records;
+    }
+
+    if (!traceDecode(chunk, header->size, &cursor->offset, &cursor->last)) {
+        return -1;
+    }
+    *event = cursor->last;
+
+    return 0;
+}
+
+
+/**
+ * This function points a cursor at the first record of the history.
+ *
+ * @param History* history - A pointer to the history, which has a chunk.
+ *
+ * @param HistoryCursor* cursor - The cursor.
+ *
+ * @return int - 0 on success, -1 if the first chunk could not be read back.
+ */
+static int firstRecord(History* history, HistoryCursor* cursor)
+{
+    const Uint8*       chunk = chunkData(history, 0);
+    const ChunkHeader* header;
+
+    if (!chunk) {
+        return -1;
+    }
+    header = (const ChunkHeader*) chunk;
+
+    cursor->chunk  = 0;
+    cursor->offset = header->records;
+    cursor->last   = header->last;
+
+    return 0;
+}
+
+
+/**
+ * This function plays one record back into the stack view, and into the call tree
+ * unless it is still catching up.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree, or NULL while it is not shown.
+ *
+ * @param const StackEvent* event - The record.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int playRecord(History* history, StackView* view, CallTree* tree, const StackEvent* event)
+{
+    // Like in the render loop, an EVENT_END record does not change the stack view.
+    if (event->type != EVENT_END && stackViewApply(view, event) != 0) {
+        return -1;
+    }
+    if (tree && history->tree_step == history->step) {
+        if (callTreeApply(tree, event) != 0) {
+            return -1;
+        }
+        ++history->tree_step;
+    }
+    ++history->step;
+
+    return 0;
+}
+
+
+void historyInit(History* history, size_t budget)
+{
+    memset(history, 0, sizeof(*history));
+
+    // A few chunks are needed whatever the budget: the one being appended to,
+    // the pages to read written out chunks back into, and one to write out.
+    history->budget = (Uint32) (budget / HISTORY_CHUNK_SIZE);
+    if (history->budget < HISTORY_PAGES + 2) {
+        history->budget = HISTORY_PAGES + 2;
+    }
+}
+
+
+void historyDestroy(History* history)
+{
+    Uint32 i;
+
+    for (i = history->spilled; i < history->chunk_count; ++i) {
+        free(history->chunks[i]);
+    }
+    for (i = 0; i < history->pool_count; ++i) {
+        free(history->pool[i]);
+    }
+    for (i = 0; i < HISTORY_PAGES; ++i) {
+        free(history->pages[i]);
+    }
+    free(history->chunks);
+    free(history->steps);
+    free(history->pool);
+
+    // A temporary file is deleted as soon as it is closed.
+    if (history->file) {
+        fclose(history->file);
+    }
+
+    memset(history, 0, sizeof(*history));
+}
+
+
+int historyRecord(History* history, StackView* view, CallTree* tree, const StackEvent* event)
+{
+    Uint8        record[TRACE_RECORD_MAX_BYTES];
+    size_t       size   = traceEncode(record, event, &history->last);
+    Uint8*       chunk  = NULL;
+    ChunkHeader* header = NULL;
+
+    if (!history->pool) {
+        history->pool = (Uint8**) malloc(history->budget * sizeof(Uint8*));
+        if (!history->pool) {
+            return -1;
+        }
+    }
+
+    // A record never straddles two chunks, so a chunk can be decoded on its own.
+    if (history->chunk_count > 0) {
+        chunk  = history->chunks[history->chunk_count - 1];
+        header = (ChunkHeader*) chunk;
+    }
+    if (!header || header->size + size > HISTORY_CHUNK_SIZE) {
+        if (openChunk(history, view) != 0) {
+            return -1;
+        }
+        chunk  = history->chunks[history->chunk_count - 1];
+        header = (ChunkHeader*) chunk;
+    }
+
+    memcpy(chunk + header->size, record, size);
+    header->size += (Uint32) size;
+    history->last = *event;
+    ++history->count;
+    if (event->type == EVENT_PUSH) {
+        ++history->calls;
+    }
+
+    // The playback stays at the end of the history.
+    history->cursor.chunk  = history->chunk_count - 1;
+    history->cursor.offset = header->size;
+    history->cursor.last   = *event;
+
+    return playRecord(history, view, tree, event);
+}
+
+
+int historyStep(History* history, StackView* view, CallTree* tree, StackEvent* event)
+{
+    if (history->step >= history->count) {
+        return 0;
+    }
+    if (readRecord(history, &history->cursor, event) != 0 || playRecord(history, view, tree, event) != 0) {
+        return -1;
+    }
+
+    return 1;
+}
+
+
+int historyCatchUp(History* history, CallTree* tree)
+{
+    StackEvent event;
+    Uint32     played = 0;
+
+    // A call tree which was never shown starts from the first record.
+    if (history->tree_step == 0 && history->step > 0 && firstRecord(history, &history->tree_cursor) != 0) {
+        return 0;
+    }
+
+    while (history->tree_step < history->step && played < TIMELINE_CATCH_UP) {
+        if (readRecord(history, &history->tree_cursor, &event) != 0 || callTreeApply(tree, &event) != 0) {
+            break;
+        }
+        ++history->tree_step;
+        ++played;
+    }
+
+    return played > 0;
+}
+
+
+int historySeek(History* history, StackView* view, CallTree* tree, Uint64 step)
+{
+    const Uint8*       chunk;
+    const ChunkHeader* header;
+    const ColorRun*    runs;
+    StackEvent         event;
+    Uint32             low   = 0;
+    Uint32             high;
+    Uint32             frame = 0;
+    Uint64             used  = 0;
+    Uint32             run;
+
+    history->scrubbed = 1;
+    if (history->chunk_count == 0) {
+        return 0;
+    }
+    if (step > history->count) {
+        step = history->count;
+    }
+
+    // Binary search for the last chunk which starts at or before the step.
+    high = history->chunk_count - 1;
+    while (low < high) {
+        Uint32 middle = low + (high - low + 1) / 2;
+        if (history->steps[middle] <= step) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    // If the stack was too big to save at the start of the chunk, start from a chunk before it.
+    // The first chunk always starts with an empty stack.
+    for (;;) {
+        chunk = chunkData(history, low);
+        if (!chunk) {
+            return -1;
+        }
+        header = (const ChunkHeader*) chunk;
+        if (header->run_count != HISTORY_NO_CHECKPOINT || low == 0) {
+            break;
+        }
+        --low;
+    }
+
+    // The call tree has already seen the start of the chunk, so it is wound back to it.
+    // If it merged the calls from before the chunk, it starts over and catches up from the start.
+    // Otherwise it keeps catching up from wherever it was.
+    if (history->tree_step >= header->step) {
+        if (callTreeRewind(tree, header->calls, &header->last) == 0) {
+            history->tree_step = header->step;
+        } else {
+            callTreeClear(tree);
+            history->tree_step = 0;
+        }
+    } else if (history->tree_step == history->step) {
+        history->tree_cursor = history->cursor;
+    }
+
+    // Restore the stack from the checkpoint at the start of the chunk.
+    if (stackViewResize(view, header->depth) != 0) {
+        return -1;
+    }
+    runs = (const ColorRun*) (chunk + sizeof(ChunkHeader));
+    for (run = 0; run < header->run_count; ++run) {
+        const ColorRun* current = &runs[run];
+        Uint32          end     = frame + current->length;
+
+        memset(view->colors + frame, current->color, current->length);
+        for (; frame < end; ++frame) {
+            used += current->bytes;
+            view->stack[frame] = used;
+        }
+    }
+    view->address = header->last.address;
+
+    history->cursor.chunk  = low;
+    history->cursor.offset = header->records;
+    history->cursor.last   = header->last;
+    history->step          = header->step;
+
+    // And play back the records between the start of the chunk and the step.
+    while (history->step < step) {
+        int played = historyStep(history, view, tree, &event);
+        if (played <= 0) {
+            return played;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file    recursion_visualized_history.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the history, which keeps every push/pop record of a
+ * live run as it is played back, so that the run can be rewound and scrubbed like a replayed
+ * trace file, however long it has been running, in a bounded amount of memory.
+ *
+ * The records are encoded the same way as in a trace file, about 11 bytes each, into chunks
+ * of HISTORY_CHUNK_SIZE bytes. The chunks are taken from a pool and given back to it, so there
+ * is no allocation per record, and none at all once the pool is full. The pool holds at most
+ * as many chunks as fit into the budget of memory. When it runs out, the oldest chunk in memory
+ * is written to a temporary file, at the end of what was written before, and its memory is reused.
+ * The file is only ever written sequentially, and it is deleted when the program ends.
+ *
+ * Every chunk starts with a checkpoint: the colors and sizes of the stack frames at that step,
+ * run-length encoded like the checkpoints of the timeline. A jump finds the chunk with the step,
+ * reads it back from the file if it was written out, restores the stack from its checkpoint, and
+ * plays back the records in it up to the step. Only a few chunks are read back into memory at
+ * a time, so jumping around does not take any more memory either. What stays in memory for
+ * every chunk is its first step and where it is, 16 bytes for about 20000 records.
+ *
+ * The call tree is only played back into while it is shown. While it is hidden it falls behind,
+ * and catches up from the history once it is shown again, so it takes no memory either until
+ * then, and at most its own budget of calls after that.
+ *
+ * Writing to the temporary file needs a POSIX system.
+ */
+
+#ifndef RECURSION_VISUALIZED_HISTORY_H
+#define RECURSION_VISUALIZED_HISTORY_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"       // StackEvent
+#include "recursion_visualized_stackview.h"  // StackView
+#include "recursion_visualized_calltree.h"   // CallTree
+
+
+/* The size of one chunk of the history, in bytes. */
+#define HISTORY_CHUNK_SIZE (256 * 1024)
+
+/* How much of the history is kept in memory by default, in megabytes. */
+#define HISTORY_DEFAULT_BUDGET 64
+
+/* How many chunks which were written out can be read back into memory at once. */
+#define HISTORY_PAGES 2
+
+
+/**
+ * A position in the history, from which the records after it are read.
+ *
+ * @field Uint32 chunk - The index of the chunk.
+ *
+ * @field size_t offset - Where the next record starts in the chunk.
+ *
+ * @field StackEvent last - The record before it.
+ */
+typedef struct HistoryCursor {
+    Uint32     chunk;
+    size_t     offset;
+    StackEvent last;
+} HistoryCursor;
+
+
+/**
+ * The history of a live run.
+ *
+ * @field Uint8** chunks - chunks[i] is the memory of chunk i, or NULL once it was written out.
+ *
+ * @field Uint64* steps - steps[i] is the number of records before chunk i.
+ *
+ * @field Uint32 chunk_count, chunk_capacity - The number of chunks, and the room in chunks and steps.
+ *
+ * @field Uint32 spilled - The chunks below this index were written out into the file.
+ *
+ * @field Uint8** pool, Uint32 pool_count - The chunks of memory which are not in use.
+ *
+ * @field Uint32 allocated - The number of chunks of memory allocated so far.
+ *
+ * @field Uint32 budget - The most chunks of memory to allocate.
+ *
+ * @field FILE* file - The temporary file, or NULL until the first chunk is written out.
+ *
+ * @field Uint8* pages[HISTORY_PAGES] - The chunks of memory that written out chunks are read back into.
+ *
+ * @field Uint32 paged[HISTORY_PAGES] - The index of the chunk read back into each, if any.
+ *
+ * @field Uint64 used[HISTORY_PAGES] - When each was last used, to find the one to read the next chunk into.
+ *
+ * @field Uint64 uses - A counter of uses of the chunks which were read back.
+ *
+ * @field Uint64 count, calls - The number of records and of pushes in the history.
+ *
+ * @field StackEvent last - The last record in the history.
+ *
+ * @field Uint64 step - The number of records played back into the stack view.
+ *                      It is less than count after jumping back.
+ *
+ * @field HistoryCursor cursor - Where the next record to play back is, while step < count.
+ *
+ * @field Uint64 tree_step, HistoryCursor tree_cursor - Where the call tree is, while it is catching up
+ *                      after a jump forwards. It is caught up when tree_step == step.
+ *
+ * @field int failed - Nonzero if writing to or reading from the file failed.
+ *
+ * @field int scrubbed - Nonzero once the history was jumped along, so the run is not over when it ends.
+ */
+typedef struct History {
+    Uint8**       chunks;
+    Uint64*       steps;
+    Uint32        chunk_count;
+    Uint32        chunk_capacity;
+    Uint32        spilled;
+    Uint8**       pool;
+    Uint32        pool_count;
+    Uint32        allocated;
+    Uint32        budget;
+    FILE*         file;
+    Uint8*        pages[HISTORY_PAGES];
+    Uint32        paged[HISTORY_PAGES];
+    Uint64        used[HISTORY_PAGES];
+    Uint64        uses;
+    Uint64        count;
+    Uint64        calls;
+    StackEvent    last;
+    Uint64        step;
+    HistoryCursor cursor;
+    Uint64        tree_step;
+    HistoryCursor tree_cursor;
+    int           failed;
+    int           scrubbed;
+} History;
+
+
+/**
+ * This function sets up an empty history. Nothing is allocated until the first record.
+ *
+ * @param History* history - A pointer to the history to initialize.
+ *
+ * @param size_t budget - The most memory to keep the history in, in bytes.
+ *                        It is raised to a few chunks if it is smaller.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void historyInit(History* history, size_t budget);
+
+
+/**
+ * This function deallocates the chunks, and closes and deletes the temporary file.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void historyDestroy(History* history);
+
+
+/**
+ * This function appends a new record of the live run to the history, and plays it back into
+ * the stack view, and into the call tree unless it is still catching up. It must only be called
+ * while the history is played back up to its end.
+ * Like in the render loop, an EVENT_END record is played back into the call tree only.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree, or NULL while it is not shown, which leaves it behind.
+ *
+ * @param const StackEvent* event - The new record.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated or the file could not be written.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int historyRecord(History* history, StackView* view, CallTree* tree, const StackEvent* event);
+
+
+/**
+ * This function plays the next record of the history back into the stack view,
+ * and into the call tree unless it is still catching up, after a jump back.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree, or NULL while it is not shown, which leaves it behind.
+ *
+ * @param StackEvent* event - Receives the record.
+ *
+ * @return int - 1 if a record was played back, 0 at the end of the history,
+ *               -1 if the memory could not be allocated or the file could not be read.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int historyStep(History* history, StackView* view, CallTree* tree, StackEvent* event);
+
+
+/**
+ * This function lets the call tree catch up on at most TIMELINE_CATCH_UP of the records
+ * it skipped over when the history jumped forwards.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param CallTree* tree - The call tree.
+ *
+ * @return int - Nonzero if the call tree changed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int historyCatchUp(History* history, CallTree* tree);
+
+
+/**
+ * This function jumps to the given step of the history: the stack view shows the stack
+ * as it was after that many records. The stack view is redrawn in full the next time.
+ *
+ * @param History* history - A pointer to the history.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree.
+ *
+ * @param Uint64 step - The step to jump to. It is clamped to the end of the history.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated or the file could not be read.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int historySeek(History* history, StackView* view, CallTree* tree, Uint64 step);
+
+#endif /* RECURSION_VISUALIZED_HISTORY_H */
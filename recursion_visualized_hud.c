@@ -0,0 +1,283 @@
+/**
+ * @file    recursion_visualized_hud.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the frame timing HUD functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), free()
+#include <stdio.h>   // C standard input/output - for fopen(), fprintf(), fclose()
+#include <string.h>  // C strings - for memset(), memmove()
+
+#include "recursion_visualized_hud.h"
+
+
+/* The layout of the overlay: the graph is as tall as two frames of a 60 Hz display,
+   and the text above it has one line for the interval and one for every stage. */
+#define HUD_MARGIN       4
+#define HUD_GRAPH_HEIGHT 60
+#define HUD_TEXT_LINES   (HUD_STAGE_COUNT + 1)
+#define HUD_HEIGHT       (HUD_TEXT_LINES * GLYPH_HEIGHT + HUD_GRAPH_HEIGHT + 3 * HUD_MARGIN)
+
+/* The interval of a 60 Hz display, in seconds, drawn as a line across the graph. */
+#define HUD_REFRESH_INTERVAL (1.0 / 60.0)
+
+static const char* STAGE_NAMES[HUD_STAGE_COUNT] = { "events", "clear", "fill", "labels", "present" };
+
+/* The color of every stage in the graph, and the color of the rest of the interval. */
+static const SDL_Color STAGE_COLORS[HUD_STAGE_COUNT] = {
+    { 255, 255,   0, 255 },  // events, yellow
+    { 160, 160, 160, 255 },  // clear, grey
+    {   0, 255, 100, 255 },  // fill, lime
+    {   0, 200, 255, 255 },  // labels, cyan
+    { 255, 100, 180, 255 }   // present, pink
+};
+static const SDL_Color WAIT_COLOR = { 60, 60, 60, 255 };
+
+
+void hudInit(FrameHud* hud, const char* csv_path)
+{
+    SDL_AtomicSet(&hud->head, 0);
+    memset(&hud->current, 0, sizeof(hud->current));
+    hud->last_present = 0;
+    hud->csv_path     = csv_path;
+    hud->shown        = 0;
+}
+
+
+void hudCommit(FrameHud* hud, Uint32 frame)
+{
+    // Only the render loop writes head, so it can read its own index without a barrier.
+    Uint32 head = (Uint32) SDL_AtomicGet(&hud->head);
+    Uint64 now  = SDL_GetPerformanceCounter();
+
+    hud->current.interval = (hud->last_present > 0) ? now - hud->last_present : 0;
+    hud->current.frame    = frame;
+    hud->last_present     = now;
+
+    hud->samples[head & HUD_MASK] = hud->current;
+
+    // The sample must be fully written before a reader is allowed to see it.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&hud->head, (int) (head + 1));
+
+    memset(&hud->current, 0, sizeof(hud->current));
+}
+
+
+Uint32 hudSamples(const FrameHud* hud, FrameSample* samples, Uint32 count)
+{
+    Uint32 head = (Uint32) SDL_AtomicGet((SDL_atomic_t*) &hud->head);
+    Uint32 first;
+    Uint32 stale;
+    Uint32 i;
+
+    // The samples must not be read before the writer has published them.
+    SDL_MemoryBarrierAcquire();
+
+    if (count > HUD_CAPACITY) {
+        count = HUD_CAPACITY;
+    }
+    if (count > head) {
+        count = head;
+    }
+    first = head - count;
+    for (i = 0; i < count; ++i) {
+        samples[i] = hud->samples[(first + i) & HUD_MASK];
+    }
+
+    // The writer may have gone on meanwhile, and be writing the sample after the newest one it
+    // published. Every sample up to HUD_CAPACITY before that one may have been overwritten.
+    SDL_MemoryBarrierAcquire();
+    head  = (Uint32) SDL_AtomicGet((SDL_atomic_t*) &hud->head);
+    stale = (head + 1 - first > HUD_CAPACITY) ? head + 1 - first - HUD_CAPACITY : 0;
+    if (stale >= count) {
+        return 0;
+    }
+    if (stale > 0) {
+        memmove(samples, samples + stale, (count - stale) * sizeof(FrameSample));
+    }
+
+    return count - stale;
+}
+
+
+/**
+ * This function sets the draw color of the renderer.
+ *
+ * @param SDL_Renderer* renderer - The renderer.
+ *
+ * @param SDL_Color color - The color.
+ */
+static void setColor(SDL_Renderer* renderer, SDL_Color color)
+{
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+}
+
+
+void hudDraw(FrameHud* hud, SDL_Renderer* renderer, GlyphAtlas* atlas)
+{
+    FrameSample samples[HUD_GRAPH_FRAMES];
+    SDL_Rect    bars[HUD_GRAPH_FRAMES];
+    SDL_Rect    panel;
+    Uint64      totals[HUD_STAGE_COUNT];
+    Uint64      interval_total = 0;
+    Uint64      interval_max   = 0;
+    Uint32      intervals      = 0;
+    Uint32      count;
+    Uint32      i;
+    double      frequency = (double) SDL_GetPerformanceFrequency();
+    double      scale     = HUD_GRAPH_HEIGHT / (2.0 * HUD_REFRESH_INTERVAL * frequency);
+    int         width;
+    int         height;
+    int         bottom;
+    int         stage;
+    char        text[64];
+
+    if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0) {
+        return;
+    }
+    count = hudSamples(hud, samples, HUD_GRAPH_FRAMES);
+
+    // The overlay is a black panel across the bottom of the window.
+    panel.x = 0;
+    panel.y = height - HUD_HEIGHT;
+    panel.w = width;
+    panel.h = HUD_HEIGHT;
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderFillRect(renderer, &panel);
+
+    // The graph is drawn one layer at a time, so that each layer is a single batch of bars.
+    // The intervals go first, in the color of the rest of the interval,
+    // and the stages are stacked up on top of them from the bottom.
+    bottom = height - HUD_MARGIN;
+    for (i = 0; i < count; ++i) {
+        int tall = (int) (samples[i].interval * scale + 0.5);
+
+        bars[i].x = HUD_MARGIN + (int) i * HUD_BAR_WIDTH;
+        bars[i].w = HUD_BAR_WIDTH;
+        bars[i].h = (tall < HUD_GRAPH_HEIGHT) ? tall : HUD_GRAPH_HEIGHT;
+        bars[i].y = bottom - bars[i].h;
+    }
+    setColor(renderer, WAIT_COLOR);
+    SDL_RenderFillRects(renderer, bars, (int) count);
+
+    for (i = 0; i < count; ++i) {
+        bars[i].y = bottom;
+        bars[i].h = 0;
+    }
+    for (stage = 0; stage < HUD_STAGE_COUNT; ++stage) {
+        for (i = 0; i < count; ++i) {
+            int top  = bars[i].y;
+            int tall = (int) (samples[i].stages[stage] * scale + 0.5);
+
+            // Every stage starts where the one below it ended, and the graph is clipped at the top.
+            if (tall > top - (bottom - HUD_GRAPH_HEIGHT)) {
+                tall = top - (bottom - HUD_GRAPH_HEIGHT);
+            }
+            bars[i].y = top - tall;
+            bars[i].h = tall;
+        }
+        setColor(renderer, STAGE_COLORS[stage]);
+        SDL_RenderFillRects(renderer, bars, (int) count);
+    }
+
+    // The line of a 60 Hz display, which every bar above it missed.
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDrawLine(renderer, HUD_MARGIN, bottom - HUD_GRAPH_HEIGHT / 2,
+                       HUD_MARGIN + HUD_GRAPH_FRAMES * HUD_BAR_WIDTH - 1, bottom - HUD_GRAPH_HEIGHT / 2);
+
+    if (!atlas) {
+        return;
+    }
+
+    // The averages over the frames in the graph, with the color of every stage in front of its name.
+    memset(totals, 0, sizeof(totals));
+    for (i = 0; i < count; ++i) {
+        for (stage = 0; stage < HUD_STAGE_COUNT; ++stage) {
+            totals[stage] += samples[i].stages[stage];
+        }
+        if (samples[i].interval > 0) {
+            interval_total += samples[i].interval;
+            ++intervals;
+            if (samples[i].interval > interval_max) {
+                interval_max = samples[i].interval;
+            }
+        }
+    }
+
+    panel.y += HUD_MARGIN;
+    SDL_snprintf(text, sizeof(text), "frame avg %.2f ms, max %.2f ms",
+                 (intervals > 0) ? interval_total * 1000.0 / frequency / intervals : 0.0,
+                 interval_max * 1000.0 / frequency);
+    glyphAtlasText(atlas, HUD_MARGIN, panel.y, text);
+
+    for (stage = 0; stage < HUD_STAGE_COUNT; ++stage) {
+        SDL_Rect key;
+
+        panel.y += GLYPH_HEIGHT;
+        key.x = HUD_MARGIN;
+        key.y = panel.y;
+        key.w = GLYPH_WIDTH - 1;
+        key.h = GLYPH_HEIGHT - 1;
+        setColor(renderer, STAGE_COLORS[stage]);
+        SDL_RenderFillRect(renderer, &key);
+
+        SDL_snprintf(text, sizeof(text), "%-8s %.3f ms", STAGE_NAMES[stage],
+                     (count > 0) ? totals[stage] * 1000.0 / frequency / count : 0.0);
+        glyphAtlasText(atlas, HUD_MARGIN + 2 * GLYPH_WIDTH, panel.y, text);
+    }
+    glyphAtlasFlush(atlas, renderer);
+}
+
+
+int hudWriteCsv(const FrameHud* hud, const char* path)
+{
+    FrameSample* samples = (FrameSample*) malloc(HUD_CAPACITY * sizeof(FrameSample));
+    double       to_us   = 1e6 / (double) SDL_GetPerformanceFrequency();
+    FILE*        out;
+    Uint32       count;
+    Uint32       i;
+    int          stage;
+    int          failed;
+
+    if (!samples) {
+        return -1;
+    }
+    out = fopen(path, "w");
+    if (!out) {
+        free(samples);
+        return -1;
+    }
+
+    count = hudSamples(hud, samples, HUD_CAPACITY);
+    fprintf(out, "frame,interval_us");
+    for (stage = 0; stage < HUD_STAGE_COUNT; ++stage) {
+        fprintf(out, ",%s_us", STAGE_NAMES[stage]);
+    }
+    fprintf(out, "\n");
+
+    for (i = 0; i < count; ++i) {
+        fprintf(out, "%lu,%.1f", (unsigned long) samples[i].frame, samples[i].interval * to_us);
+        for (stage = 0; stage < HUD_STAGE_COUNT; ++stage) {
+            fprintf(out, ",%.1f", samples[i].stages[stage] * to_us);
+        }
+        fprintf(out, "\n");
+    }
+
+    failed = ferror(out);
+    if (fclose(out) != 0) {
+        failed = 1;
+    }
+    free(samples);
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file    recursion_visualized_hud.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the frame timing HUD, an overlay which shows
+ * where the time of every frame goes, to find out why the animation stutters on a slow machine
+ * without a profiler.
+ *
+ * Every frame is timed in stages with SDL_GetPerformanceCounter():
+ *   events   handling the events with handleEvents(), every time it was called since the last frame
+ *   clear    clearing the background
+ *   fill     drawing the stack frames, or the call tree, and copying the backbuffer onto the window
+ *   labels   drawing the labels of the stack frames
+ *   present  exporting the frame into the animated GIF, if any, and presenting it
+ * and the interval from the frame before, from one present to the next, which also counts
+ * the time the render loop waited for the next step. The overlay itself is drawn outside the stages.
+ *
+ * The render loop is the only writer of the timings. Each frame is committed as one sample into
+ * a ring buffer of the last HUD_CAPACITY frames, which overwrites the oldest sample once it is full.
+ * Like the EventRing, it is lock-free: the writer publishes a sample by moving head on with a release
+ * barrier, and a reader, on any thread, copies the samples it wants out, and then reads head again
+ * to leave out the ones which were overwritten while it copied them.
+ *
+ * The overlay, which H switches on and off, draws a graph of the last HUD_GRAPH_FRAMES frames along
+ * the bottom of the window, with one bar per frame, as tall as its interval, stacked up from its
+ * stages, and the average time of every stage over those frames. The line across the graph is the
+ * interval of a 60 Hz display. The samples still in the ring buffer can be written into a CSV file
+ * when the program exits, one line per frame, in microseconds:
+ *   frame,interval_us,events_us,clear_us,fill_us,labels_us,present_us
+ */
+
+#ifndef RECURSION_VISUALIZED_HUD_H
+#define RECURSION_VISUALIZED_HUD_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_font.h"  // GlyphAtlas
+
+
+/* The stages of a frame, in the order they are stacked up in the graph and written out. */
+#define HUD_STAGE_EVENTS  0
+#define HUD_STAGE_CLEAR   1
+#define HUD_STAGE_FILL    2
+#define HUD_STAGE_LABELS  3
+#define HUD_STAGE_PRESENT 4
+#define HUD_STAGE_COUNT   5
+
+/* The number of frames the ring buffer keeps. It must be a power of two,
+   so that the indices can be wrapped around with a cheap bitwise AND. */
+#define HUD_CAPACITY 8192
+#define HUD_MASK     (HUD_CAPACITY - 1)
+
+/* The number of frames in the graph of the overlay, and the width of the bar of each of them. */
+#define HUD_GRAPH_FRAMES 140
+#define HUD_BAR_WIDTH    2
+
+
+/**
+ * The timings of one frame, in the ticks of SDL_GetPerformanceCounter().
+ *
+ * @field Uint64 interval - The time from the present of the frame before, or 0 for the first frame.
+ *
+ * @field Uint64 stages[HUD_STAGE_COUNT] - The time spent in each stage.
+ *
+ * @field Uint32 frame - The number of the frame, counted like Visualizer.frame.
+ */
+typedef struct FrameSample {
+    Uint64 interval;
+    Uint64 stages[HUD_STAGE_COUNT];
+    Uint32 frame;
+} FrameSample;
+
+
+/**
+ * The frame timings, and the state of the overlay.
+ *
+ * @field FrameSample samples[HUD_CAPACITY] - The ring buffer of the last frames.
+ *
+ * @field SDL_atomic_t head - The number of samples committed so far. Only the render loop writes it.
+ *                            The newest sample is at (head - 1) & HUD_MASK.
+ *
+ * @field FrameSample current - The timings of the frame being drawn, until it is committed.
+ *
+ * @field Uint64 last_present - When the frame before was presented, or 0 before the first one.
+ *
+ * @field const char* csv_path - The file the timings are written into when the program exits, or NULL.
+ *
+ * @field int shown - Nonzero if the overlay is drawn.
+ */
+typedef struct FrameHud {
+    FrameSample  samples[HUD_CAPACITY];
+    SDL_atomic_t head;
+    FrameSample  current;
+    Uint64       last_present;
+    const char*  csv_path;
+    int          shown;
+} FrameHud;
+
+
+/**
+ * This function adds the time since start to a stage of the frame being drawn.
+ * It is inline, since it is called a few times for every frame.
+ *
+ * @param FrameHud* hud - A pointer to the HUD, or NULL to only read the clock.
+ *
+ * @param int stage - The HUD_STAGE_* constant of the stage.
+ *
+ * @param Uint64 start - When the stage started, as given by SDL_GetPerformanceCounter().
+ *
+ * @return Uint64 - The time now, which is when the next stage starts.
+ */
+SDL_FORCE_INLINE Uint64 hudTime(FrameHud* hud, int stage, Uint64 start)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (hud) {
+        hud->current.stages[stage] += now - start;
+    }
+
+    return now;
+}
+
+
+/**
+ * This function sets the HUD to no frames timed yet, with the overlay hidden.
+ *
+ * @param FrameHud* hud - A pointer to the HUD to initialize.
+ *
+ * @param const char* csv_path - The file to write the timings into when the program exits, or NULL.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void hudInit(FrameHud* hud, const char* csv_path);
+
+
+/**
+ * This function commits the timings of the frame which was just presented into the ring buffer,
+ * and starts timing the next one.
+ *
+ * @param FrameHud* hud - A pointer to the HUD.
+ *
+ * @param Uint32 frame - The number of the frame.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void hudCommit(FrameHud* hud, Uint32 frame);
+
+
+/**
+ * This function copies the newest samples out of the ring buffer, without waiting for the writer.
+ *
+ * @param const FrameHud* hud - A pointer to the HUD.
+ *
+ * @param FrameSample* samples - Receives the samples, from the oldest to the newest.
+ *
+ * @param Uint32 count - The most samples to copy, at most HUD_CAPACITY.
+ *
+ * @return Uint32 - The number of samples copied. Samples which the writer overwrote
+ *                  while they were copied are left out.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint32 hudSamples(const FrameHud* hud, FrameSample* samples, Uint32 count);
+
+
+/**
+ * This function draws the overlay along the bottom of the current render target:
+ * the graph of the last frames, and the average time of every stage over them.
+ *
+ * @param FrameHud* hud - A pointer to the HUD.
+ *
+ * @param SDL_Renderer* renderer - The renderer.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with, or NULL to draw only the graph.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void hudDraw(FrameHud* hud, SDL_Renderer* renderer, GlyphAtlas* atlas);
+
+
+/**
+ * This function writes the samples still in the ring buffer into a CSV file, with a header line.
+ *
+ * @param const FrameHud* hud - A pointer to the HUD.
+ *
+ * @param const char* path - The path of the CSV file to create.
+ *
+ * @return int - 0 on success, -1 if the file could not be written.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int hudWriteCsv(const FrameHud* hud, const char* path);
+
+#endif /* RECURSION_VISUALIZED_HUD_H */
@@ -0,0 +1,34 @@
+/**
+ * @file    recursion_visualized_instrumented.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definition of the recursive function which is traced by compiling it
+ * with -finstrument-functions. Nothing else may go into this file, since every function in it
+ * is recorded.
+ */
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_instrumented.h"
+
+
+Sint64 triangular(Sint64 n)
+{
+    Sint64 result;
+
+    if (n <= 0) {
+	// base case.
+        result = 0;
+    } else {
+        result = n + triangular(n - 1);
+    }
+
+    return result;
+}
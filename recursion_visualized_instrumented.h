@@ -0,0 +1,41 @@
+/**
+ * @file    recursion_visualized_instrumented.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declaration of a recursive function which is not traced by hand.
+ * It is compiled with -finstrument-functions instead, so that the hooks defined in
+ * recursion_visualized_trace.c record its calls into the Tracer given to traceSetActive().
+ */
+
+#ifndef RECURSION_VISUALIZED_INSTRUMENTED_H
+#define RECURSION_VISUALIZED_INSTRUMENTED_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+
+/**
+ * This function adds up the numbers from 1 to n by linear recursion, the way code that
+ * knows nothing about the recursion tracing API would. Its calls are only recorded if
+ * recursion_visualized_instrumented.c is compiled with -finstrument-functions, as the Makefile does,
+ * and only their addresses are known, not their arguments.
+ *
+ * @param Sint64 n - The last number to add, at least 0.
+ *
+ * @return Sint64 - 1 + 2 + ... + n.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Sint64 triangular(Sint64 n);
+
+#endif /* RECURSION_VISUALIZED_INSTRUMENTED_H */
@@ -15,13 +15,70 @@
  * This animation displays the real state of the function call stack at any given moment.
  * A rectangle representing the currently running stack frame goes up and down the call stack.
  * The program uses an actual runtime stack to generate the animation.
+ * The recursion runs on its own thread, or as a coroutine, and this file's render loop plays it back.
+ *
+ * Command-line options:
+ *   --headless  Render offscreen on SDL's dummy video driver, without a window or a GPU,
+ *               as fast as possible, and print a hash of every frame's pixels to stdout.
+ *   --speed N   Play the animation back at N steps per second, from 0.1 up. The default is 1.
+ *               Space pauses it, Period steps it, and Z and X halve and double the rate.
+ *   --depth N   Recurse N stack frames deep. The default is 11, which fits into the window.
+ *               Deeper stacks can be scrolled and zoomed, and are drawn with less detail.
+ *   --trace F N Animate the traced recursive function F for the problem size N instead of bunny().
+ *               F is one of factorial, fibonacci, hanoi, quicksort, ackermann or mergesort,
+ *               or instrumented for a function compiled with -finstrument-functions instead.
+ *   --tree      Start with the call tree shown instead of the runtime stack. T switches between them.
+ *               The stack frames are labeled with their calls, which L switches on and off.
+ *   --bytes     Draw the stack frames as tall as they really are on the runtime stack, in proportion
+ *               to their size in bytes, with a gauge of the stack in use. B switches this on and off.
+ *   --coroutine Run the recursion as a coroutine on the main thread, on a runtime stack of its own,
+ *               instead of on a thread of its own. The render loop runs it one record at a time.
+ *   --gif F     Export the animation into the animated GIF file F as it plays, frame by frame.
+ *               Together with --headless, it is exported as fast as possible, at the rate of --speed.
+ *   --record F  Record the run into the trace file F as fast as possible, instead of animating it.
+ *   --replay F  Animate the run recorded in the trace file F, instead of running the recursion again.
+ *               The replay can be scrubbed back and forth with the mouse and the keyboard.
+ *   --chrome F  Export the run into the Chrome trace F as fast as possible, instead of animating it,
+ *               for chrome://tracing or Perfetto. Together with --replay, the trace file is exported.
+ *   --history N Keep at most N megabytes of the history of a live run in memory, and the rest of it
+ *               in a temporary file. A live run can be scrubbed like a replay, however long it runs.
+ *               The default is 64. 0 does not keep the history, so a live run only goes forwards.
+ *   --compare F N
+ *               Animate the traced recursive function F for the problem size N next to an iterative
+ *               version of it, which keeps its stack frames in an array, with what each of them costs.
+ *               Together with --headless, only the costs are measured, and written to stdout as CSV.
+ *   --parallel F N
+ *               Sort N elements with the parallel version of F, mergesort or quicksort, on every core,
+ *               with a work-stealing scheduler, and animate the runtime stack of every worker in a lane
+ *               of its own. Together with --headless, only the sort is timed, with 1, 2, 4 and so on
+ *               up to every worker, and the costs are written to stdout as CSV.
+ *   --workers N Run the parallel sort on N workers instead of one per core.
+ *   --memo P    Look the calls of the traced example up in a memoization cache with the policy P,
+ *               unbounded, lru or fixed, so every call is only made once, as far as the cache holds.
+ *               The calls answered from the cache are drawn in CYAN, with its counters on top.
+ *               Together with --headless, only the runs without the cache and with every policy
+ *               are measured, and written to stdout as CSV.
+ *   --memo-capacity N
+ *               Hold at most N entries in the cache, or start with room for N if it is unbounded.
+ *               The default is 1024.
+ *   --hud       Start with the overlay of the frame timings shown. H shows and hides it.
+ *   --timings F Write the timings of the last frames into the CSV file F when the program exits.
+ *   --raster    Together with --headless, draw the stack frames and their labels straight into the
+ *               offscreen framebuffer with the SIMD software rasterizer, instead of with SDL's
+ *               software renderer. The frames come out the same, pixel for pixel.
  */
 
 #include "SDL.h"     // Simple DirectMedia Layer API structures and functions
 #include <stdlib.h>  // C standard library - for exit(), EXIT_SUCCESS, EXIT_FAILURE, NULL
 #include <stdio.h>   // C standard input/output - for fprintf(), stderr
+#include <string.h>  // C strings - for strcmp(), memset()
+
+#include <sys/resource.h>  // POSIX - for getrlimit(), RLIMIT_STACK
 
 #include "recursion_visualized_header.h"
+#include "recursion_visualized_examples.h"   // ExampleArgs, exampleThread(), findExample()
+#include "recursion_visualized_tracefile.h"  // TraceWriter, TraceReader
+#include "recursion_visualized_chrome.h"     // ChromeWriter
 
 
 /**
@@ -49,31 +106,383 @@ int main(int argc, char* argv[])
 {
     /* This chunk of code is responsible for setting up the infrastructure used by the program. */
 
+    Visualizer vis;
+    vis.window   = NULL;
+    vis.renderer = NULL;
+    vis.surface  = NULL;
+    vis.headless = 0;
+    vis.frame    = 0;
+    vis.backbuffer = NULL;
+    memset(&vis.view, 0, sizeof(vis.view));
+    memset(&vis.tree, 0, sizeof(vis.tree));
+    vis.show_tree = 0;
+    vis.timeline  = NULL;
+    vis.history   = NULL;
+    vis.dirty     = 0;
+    vis.scheduler = NULL;
+    vis.gif       = NULL;
+    vis.labels    = NULL;
+    vis.show_labels = 1;
+    vis.comparison  = NULL;
+    vis.hud         = NULL;
+    vis.raster      = NULL;
+    vis.parallel    = NULL;
+    vis.memo        = NULL;
+
+    // The depth of the base case of the recursion.
+    Uint32 max_depth = DEFAULT_MAX_DEPTH;
+
+    // The traced example to animate instead of bunny(), if any, and its problem size.
+    int    example   = -1;
+    Sint64 example_n = 0;
+
+    // Nonzero to compare the traced example with its iterative version.
+    int compare = 0;
+
+    // Nonzero to sort in parallel with the traced example, and the number of workers asked for, or 0 for every core.
+    int parallel_mode = 0;
+    int workers       = 0;
+
+    // The policy of the memoization cache to look the calls of the traced example up in, if any, and its capacity.
+    int    memo_policy   = MEMO_NONE;
+    Uint32 memo_capacity = MEMO_DEFAULT_CAPACITY;
+
+    // The trace file to record the run into, or to replay it from, if any.
+    const char* record_path = NULL;
+    const char* replay_path = NULL;
+
+    // The Chrome trace to export the run into, if any.
+    const char* chrome_path = NULL;
+
+    // The animated GIF file to export the animation into, if any.
+    const char* gif_path = NULL;
+
+    // The CSV file to write the frame timings into, if any, and nonzero to show their overlay.
+    const char* timings_path = NULL;
+    int         show_hud     = 0;
+
+    // Nonzero to draw with the software rasterizer in the headless mode.
+    int use_raster = 0;
+
+    // The animation rate in steps per second. One step per second by default.
+    double speed = 1.0;
+
+    // Nonzero to draw the stack frames in proportion to their real size.
+    int show_bytes = 0;
+
+    // Nonzero to run the recursion as a coroutine instead of on a thread.
+    int use_coroutine = 0;
+
+    // The most memory to keep the history of a live run in, in megabytes, or 0 to not keep it.
+    long history_budget = HISTORY_DEFAULT_BUDGET;
+
+    /* Read the command-line options. */
+    int i;
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            vis.headless = 1;
+        } else if (strcmp(argv[i], "--tree") == 0) {
+            vis.show_tree = 1;
+        } else if (strcmp(argv[i], "--bytes") == 0) {
+            show_bytes = 1;
+        } else if (strcmp(argv[i], "--coroutine") == 0) {
+            use_coroutine = 1;
+        } else if (strcmp(argv[i], "--hud") == 0) {
+            show_hud = 1;
+        } else if (strcmp(argv[i], "--raster") == 0) {
+            use_raster = 1;
+        } else if (strcmp(argv[i], "--timings") == 0 && i + 1 < argc) {
+            timings_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--chrome") == 0 && i + 1 < argc) {
+            chrome_path = argv[++i];
+        } else if (strcmp(argv[i], "--gif") == 0 && i + 1 < argc) {
+            gif_path = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc && atol(argv[i + 1]) >= 0) {
+            history_budget = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            max_depth = (Uint32) atol(argv[++i]);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 2 < argc && findExample(argv[i + 1]) >= 0) {
+            example   = findExample(argv[++i]);
+            example_n = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc && findExample(argv[i + 1]) >= 0) {
+            example   = findExample(argv[++i]);
+            example_n = atol(argv[++i]);
+            compare   = 1;
+        } else if (strcmp(argv[i], "--parallel") == 0 && i + 2 < argc &&
+                   (findExample(argv[i + 1]) == FUNCTION_MERGESORT || findExample(argv[i + 1]) == FUNCTION_QUICKSORT)) {
+            example       = findExample(argv[++i]);
+            example_n     = atol(argv[++i]);
+            parallel_mode = 1;
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--memo") == 0 && i + 1 < argc && memoFindPolicy(argv[i + 1]) != MEMO_NONE) {
+            memo_policy = memoFindPolicy(argv[++i]);
+        } else if (strcmp(argv[i], "--memo-capacity") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0 &&
+                   atol(argv[i + 1]) <= MEMO_MAX_CAPACITY) {
+            memo_capacity = (Uint32) atol(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--headless] [--tree] [--bytes] [--speed steps_per_second]\n"
+                            "       [--depth max_depth]\n"
+                            "       [--trace factorial|fibonacci|hanoi|quicksort|ackermann|mergesort|instrumented n]\n"
+                            "       [--coroutine] [--gif gif_file] [--history megabytes]\n"
+                            "       [--hud] [--timings csv_file] [--raster]\n"
+                            "       [--record trace_file | --replay trace_file] [--chrome json_file]\n"
+                            "       [--compare factorial|fibonacci|hanoi|quicksort|ackermann|mergesort n]\n"
+                            "       [--parallel mergesort|quicksort n] [--workers workers]\n"
+                            "       [--memo unbounded|lru|fixed] [--memo-capacity entries]\n",
+                    argv[0]);
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    // factorial(0), fibonacci(0), hanoi(0) and ackermann(2, 0) are all defined, but an empty array is no sort.
+    if (example >= 0 &&
+        (example_n < 0 || (example_n < 1 && (example == FUNCTION_QUICKSORT || example == FUNCTION_MERGESORT)))) {
+        fprintf(stderr, "error - The size n of the example must be at least 0, or at least 1 for a sort\n");
+	exit(EXIT_FAILURE);
+    }
+    if (record_path && replay_path) {
+        fprintf(stderr, "error - A run cannot be recorded and replayed at the same time\n");
+	exit(EXIT_FAILURE);
+    }
+    if (compare && example == FUNCTION_INSTRUMENTED) {
+        fprintf(stderr, "error - The instrumented function has no iterative version to compare with\n");
+	exit(EXIT_FAILURE);
+    }
+    if (compare && (record_path || replay_path || chrome_path || use_coroutine)) {
+        fprintf(stderr, "error - A comparison is animated live, on threads, and is not recorded or replayed\n");
+	exit(EXIT_FAILURE);
+    }
+    if (parallel_mode && (compare || record_path || replay_path || chrome_path || use_coroutine)) {
+        fprintf(stderr, "error - A parallel run is animated live, from the records of its workers, "
+                        "and is not compared, recorded or replayed\n");
+	exit(EXIT_FAILURE);
+    }
+    if (memo_policy != MEMO_NONE && (example < 0 || !memoSupported(example) || compare || parallel_mode ||
+                                      replay_path)) {
+        fprintf(stderr, "error - Only a live run of factorial, fibonacci, hanoi or ackermann with --trace "
+                        "can be memoized\n");
+	exit(EXIT_FAILURE);
+    }
+    if (use_raster && !vis.headless) {
+        fprintf(stderr, "error - The software rasterizer draws into the offscreen framebuffer of --headless\n");
+	exit(EXIT_FAILURE);
+    }
+
+    /* A headless comparison only measures both versions, at full speed, and draws nothing.
+       The recursive version gets a runtime stack as big as the animated one would. */
+    if (compare && vis.headless) {
+        size_t bench_stack = (size_t) exampleMaxDepth(example, example_n) * BUNNY_FRAME_BYTES + 1024 * 1024;
+
+        if (compareBenchmark(example, example_n, bench_stack, stdout) != 0) {
+            fprintf(stderr, "error - Measuring the comparison failed\n");
+	    exit(EXIT_FAILURE);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    /* A headless memoized run only measures the example without the cache and with every policy,
+       at full speed, and draws nothing. */
+    if (memo_policy != MEMO_NONE && vis.headless) {
+        size_t bench_stack = (size_t) exampleMaxDepth(example, example_n) * BUNNY_FRAME_BYTES + 1024 * 1024;
+
+        if (memoBenchmark(example, example_n, memo_capacity, bench_stack, stdout) != 0) {
+            fprintf(stderr, "error - Measuring the memoization cache failed\n");
+	    exit(EXIT_FAILURE);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    /* A headless parallel run only times the sort with more and more workers, and draws nothing. */
+    int worker_count = parallelWorkerCount(workers);
+    if (parallel_mode && vis.headless) {
+        size_t bench_stack = (size_t) exampleMaxDepth(example, example_n) * BUNNY_FRAME_BYTES + 1024 * 1024;
+
+        if (parallelBenchmark(example, example_n, worker_count, bench_stack, stdout) != 0) {
+            fprintf(stderr, "error - Timing the parallel sort failed\n");
+	    exit(EXIT_FAILURE);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // A comparison puts the iterative version into a second pane, as wide as the first, to its right.
+    // A parallel run puts the lanes of its workers side by side.
+    int window_width = compare ? 2 * 300 : 300;
+    if (parallel_mode) {
+        window_width = worker_count * parallelLaneWidth(worker_count);
+    }
+
+    /* In the headless mode there is no display, so SDL must use its dummy video driver.
+       This has to be decided before the SDL Video subsystem is initialized. */
+    if (vis.headless) {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    }
+
     /* Initialize the SDL Video subsystem and check for errors. */
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         fprintf(stderr, "error - Initialization of SDL subsystems failed: %s\n", SDL_GetError());
 	exit(EXIT_FAILURE);
     }
 
-    SDL_Window*   window   = NULL;
-    SDL_Renderer* renderer = NULL;
+    if (vis.headless) {
+	/* Allocate dynamic memory for the offscreen SDL_Surface and check for errors. */
+        vis.surface = SDL_CreateRGBSurfaceWithFormat(0, 300, 640, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!vis.surface) {
+            fprintf(stderr, "error - Creating offscreen surface failed: %s\n", SDL_GetError());
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+
+	/* Allocate dynamic memory for the software SDL_Renderer and check for errors. */
+        vis.renderer = SDL_CreateSoftwareRenderer(vis.surface);
+        if (!vis.renderer) {
+            fprintf(stderr, "error - Creating software renderer failed: %s\n", SDL_GetError());
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    } else {
+	/* Allocate dynamic memory for the SDL_Window and check for errors. */
+        vis.window = SDL_CreateWindow("Recursion Visualized", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                      window_width, 640, 0);
+        if (!vis.window) {
+            fprintf(stderr, "error - Creating window failed: %s\n", SDL_GetError());
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+
+	/* Allocate dynamic memory for the SDL_Renderer and check for errors. */
+        vis.renderer = SDL_CreateRenderer(vis.window, -1, SDL_RENDERER_ACCELERATED);
+        if (!vis.renderer) {
+            fprintf(stderr, "error - Creating renderer failed: %s\n", SDL_GetError());
+	    // Since the SDL_Window was created successfully,
+	    // we need to destroy it anyway to avoid memory leak.
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+
 
-    /* Allocate dynamic memory for the SDL_Window and check for errors. */
-    window = SDL_CreateWindow("Recursion Visualized", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                              300, 640, 0);
-    if (!window) {
-        fprintf(stderr, "error - Creating window failed: %s\n", SDL_GetError());
+    // A traced example recurses as deep as its problem size makes it.
+    if (example >= 0) {
+        max_depth = exampleMaxDepth(example, example_n);
+    }
+
+    /* Map the trace file to replay and check for errors.
+       Only its header is read here, the records are decoded as they are played back. */
+    TraceReader reader;
+    if (replay_path) {
+        if (traceReaderOpen(&reader, replay_path) != 0) {
+            fprintf(stderr, "error - Opening the trace file %s failed\n", replay_path);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        if (reader.max_depth > 0) {
+            max_depth = reader.max_depth;
+        }
+    }
+
+    /* Allocate dynamic memory for the model of the runtime stack and check for errors. */
+    if (stackViewInit(&vis.view, 300, 640, max_depth) != 0) {
+        fprintf(stderr, "error - Allocating the stack view failed\n");
+	destroyVisualizer(&vis);
 	SDL_Quit();
 	exit(EXIT_FAILURE);
     }
+    if (show_bytes) {
+        stackViewShowBytes(&vis.view, 1);
+    }
 
-    /* Allocate dynamic memory for the SDL_Renderer and check for errors. */
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
-        fprintf(stderr, "error - Creating renderer failed: %s\n", SDL_GetError());
-	// Since the SDL_Window was created successfully,
-	// we need to destroy it anyway to avoid memory leak.
-	SDL_DestroyWindow(window);
+    /* Allocate dynamic memory for the call tree and check for errors. */
+    if (callTreeInit(&vis.tree, 300, 640) != 0) {
+        fprintf(stderr, "error - Allocating the call tree failed\n");
+	destroyVisualizer(&vis);
+	SDL_Quit();
+	exit(EXIT_FAILURE);
+    }
+
+    /* Create the animated GIF file to export the animation into, and check for errors. */
+    GifWriter gif;
+    if (gif_path) {
+        if (gifWriterOpen(&gif, gif_path, window_width, 640) != 0) {
+            fprintf(stderr, "error - Creating the animated GIF file %s failed\n", gif_path);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        vis.gif = &gif;
+    }
+
+    /* Start indexing the timeline of the trace file to replay, and check for errors. */
+    Timeline timeline;
+    if (replay_path) {
+        if (timelineInit(&timeline, &reader) != 0) {
+            fprintf(stderr, "error - Indexing the trace file %s failed\n", replay_path);
+	    traceReaderClose(&reader);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        vis.timeline = &timeline;
+    }
+
+    /* Keep the history of a live run which is watched, so it can be rewound.
+       Its memory is only allocated as the records come.
+       A comparison plays back two runs in lockstep, and a parallel run one per worker,
+       which cannot be rewound together. */
+    History history;
+    if (!replay_path && !record_path && !chrome_path && !vis.headless && !compare && !parallel_mode &&
+        history_budget > 0) {
+        historyInit(&history, (size_t) history_budget * 1024 * 1024);
+        vis.history = &history;
+    }
+
+
+    /* Allocate dynamic memory for the software raster and check for errors.
+       It keeps the stack from one frame to the next in main memory, so it takes the place of the backbuffer. */
+    if (use_raster) {
+        vis.raster = (Raster*) malloc(sizeof(Raster));
+        if (!vis.raster || rasterInit(vis.raster, 300, 640, RASTER_KERNEL_AUTO) != 0) {
+            fprintf(stderr, "error - Allocating the software raster failed\n");
+	    free(vis.raster);
+	    vis.raster = NULL;
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Allocate dynamic memory for the persistent backbuffer, if the renderer supports it.
+       Without it, every frame is simply drawn from scratch. */
+    if (!vis.raster && SDL_RenderTargetSupported(vis.renderer)) {
+        vis.backbuffer = SDL_CreateTexture(vis.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                           SDL_TEXTUREACCESS_TARGET, 300, 640);
+    }
+
+    /* Draw the font of the labels into its atlas texture, once and for all.
+       Without it, the stack frames are simply not labeled. */
+    GlyphAtlas atlas;
+    if (glyphAtlasInit(&atlas, vis.renderer) == 0) {
+        vis.labels = &atlas;
+    }
+
+    /* Allocate dynamic memory for the frame timings, which are too large to be put on the runtime stack.
+       Without it, the frames are simply not timed, unless their CSV file was asked for. */
+    vis.hud = (FrameHud*) malloc(sizeof(FrameHud));
+    if (vis.hud) {
+        hudInit(vis.hud, timings_path);
+        vis.hud->shown = show_hud;
+    } else if (timings_path) {
+        fprintf(stderr, "error - Allocating the frame timings failed\n");
+	destroyVisualizer(&vis);
 	SDL_Quit();
 	exit(EXIT_FAILURE);
     }
@@ -81,40 +490,434 @@ int main(int argc, char* argv[])
 
     /* The following code is responsible for animation and drawing objects on the screen. */
 
+    // The scheduler paces the animation to the requested rate and the refresh rate of the display.
+    SDL_DisplayMode mode;
+    mode.refresh_rate = 0;
+    if (vis.window) {
+        SDL_GetWindowDisplayMode(vis.window, &mode);
+    }
+    Scheduler sched;
+    schedulerInit(&sched, speed, mode.refresh_rate);
+    vis.scheduler = &sched;
+
+    // Used for event handling.
+    SDL_Event e;
+
     // Draw the main function, without the stack.
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
-    SDL_RenderClear(renderer);
-    SDL_RenderPresent(renderer);
-    SDL_Delay(1000);
+    drawStack(&vis);
+    if (!vis.headless) {
+        holdFrame(&vis, &e);
+    }
+
+    // The ring buffer which carries the push/pop records from the recursion thread
+    // to this render loop. It is too large to be put on the runtime stack.
+    // A replayed run reads its records out of the trace file instead.
+    EventRing* ring = NULL;
+    if (!replay_path) {
+        ring = (EventRing*) malloc(sizeof(EventRing));
+        if (!ring) {
+            fprintf(stderr, "error - Allocating the event ring buffer failed\n");
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        ringInit(ring);
+    }
+
+    // The trace file the run is recorded into.
+    TraceWriter writer;
+    if (record_path && traceWriterOpen(&writer, record_path) != 0) {
+        fprintf(stderr, "error - Creating the trace file %s failed\n", record_path);
+	free(ring);
+	destroyVisualizer(&vis);
+	SDL_Quit();
+	exit(EXIT_FAILURE);
+    }
+
+    // The Chrome trace the run is exported into.
+    ChromeWriter chrome;
+    if (chrome_path && chromeWriterOpen(&chrome, chrome_path) != 0) {
+        fprintf(stderr, "error - Creating the Chrome trace %s failed\n", chrome_path);
+        if (record_path) {
+            traceWriterClose(&writer);
+        }
+	free(ring);
+	destroyVisualizer(&vis);
+	SDL_Quit();
+	exit(EXIT_FAILURE);
+    }
 
     // This box is a visual representaion of a stack frame.
     // Define its initial x and y positions, and its dimensions.
-    SDL_Rect box = {125, 590, 50, 50};
+    RecursionArgs args;
+    args.ring = ring;
+    args.box.x = 125;
+    args.box.y = 590;
+    args.box.w = 50;
+    args.box.h = 50;
+    args.max_depth = max_depth;
 
-    // Used for event handling.
-    SDL_Event e;
+    ExampleArgs example_args;
+    example_args.ring     = ring;
+    example_args.function = example;
+    example_args.n        = example_n;
+    example_args.memo     = NULL;
+
+    // The memoization cache the example looks its calls up in, and its counters on top of the window,
+    // unless the run is only recorded or exported.
+    Memo      memo;
+    MemoMeter meter;
+    memo.entries = NULL;
+    if (memo_policy != MEMO_NONE) {
+        if (memoInit(&memo, memo_policy, memo_capacity) != 0) {
+            fprintf(stderr, "error - Allocating the memoization cache failed\n");
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        example_args.memo = &memo;
+        if (!record_path && !chrome_path) {
+            memoMeterInit(&meter, &memo, example, example_n);
+            vis.memo = &meter;
+        }
+    }
 
     // Start the recursion process:
-    // This recursive function draws the function call stack as each recursive
-    // function call happens.
-    bunny(renderer, window, &box, &e);
+    // The recursive function runs on its own thread and records each recursive
+    // function call into the ring buffer as it happens.
+    // As a coroutine, it runs on the main thread instead, whenever the render loop
+    // wants the next record, and yields back to it after every record.
+    // The recursion thread, or the coroutine, gets as big a runtime stack as RLIMIT_STACK allows the main thread,
+    // which is what a thread gets by default, or a bigger one if a deep recursion needs more.
+    // The stack view measures the stack in use against it.
+    // A traced example runs instead of bunny() if one was asked for.
+    size_t        stack_size = (size_t) max_depth * BUNNY_FRAME_BYTES + 1024 * 1024;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+        limit.rlim_cur > stack_size) {
+        stack_size = (size_t) limit.rlim_cur;
+    }
+    vis.view.stack_limit = stack_size;
+    // What a whole run costs with and without the memoization cache is measured on a thread of its own,
+    // so the animation does not wait for it.
+    SDL_Thread* measure_thread = NULL;
+    if (vis.memo) {
+        measure_thread = SDL_CreateThreadWithStackSize(memoMeterThread, "memo-measure", stack_size, &meter);
+        if (!measure_thread) {
+            fprintf(stderr, "error - Creating the thread which measures the memoization cache failed: %s\n",
+                    SDL_GetError());
+	    memoDestroy(&memo);
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+    // A replayed run has nothing to run, its records are already in the trace file.
+    // A comparison starts the threads of both versions itself.
+    // A parallel run sorts with its workers right away, and plays back their records afterwards.
+    SDL_Thread* thread = NULL;
+    Coroutine   coroutine;
+    Comparison  comparison;
+    Parallel    parallel;
+    coroutine.memory = NULL;
+    if (parallel_mode) {
+        if (parallelInit(&parallel, example, example_n, worker_count, 640, stack_size) != 0) {
+            fprintf(stderr, "error - Running the parallel sort failed: %s\n", SDL_GetError());
+	    parallelDestroy(&parallel);
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        vis.parallel = &parallel;
+    } else if (compare) {
+        if (comparisonInit(&comparison, ring, example, example_n, 300, 640, stack_size) != 0) {
+            fprintf(stderr, "error - Starting the comparison failed: %s\n", SDL_GetError());
+	    comparisonDestroy(&comparison);
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        if (show_bytes) {
+            stackViewShowBytes(&comparison.view, 1);
+        }
+        vis.comparison = &comparison;
+    } else if (!replay_path && use_coroutine) {
+        SDL_ThreadFunction function = (example >= 0) ? exampleThread : recursionThread;
+        void*              data     = (example >= 0) ? (void*) &example_args : (void*) &args;
+
+        if (coroutineInit(&coroutine, stack_size, function, data) != 0) {
+            fprintf(stderr, "error - Allocating the runtime stack of the coroutine failed\n");
+	    memoDestroy(&memo);
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+        ring->coroutine = &coroutine;
+    } else if (!replay_path) {
+        if (example >= 0) {
+            thread = SDL_CreateThreadWithStackSize(exampleThread, "example", stack_size, &example_args);
+        } else {
+            thread = SDL_CreateThreadWithStackSize(recursionThread, "bunny", stack_size, &args);
+        }
+        if (!thread) {
+            fprintf(stderr, "error - Creating the recursion thread failed: %s\n", SDL_GetError());
+	    memoDestroy(&memo);
+	    free(ring);
+	    destroyVisualizer(&vis);
+	    SDL_Quit();
+	    exit(EXIT_FAILURE);
+        }
+    }
+
+    StackEvent event;
+    int        finished  = 0;
+    int        live_done = 0;
+
+    // When recording or exporting, the records are written into the trace file, the Chrome trace
+    // or both as fast as the recursion thread makes them, and nothing is drawn.
+    while ((record_path || chrome_path) && !replay_path && !finished) {
+        handleEvents(&vis, &e);
+
+        if (!ringPop(ring, &event)) {
+            SDL_Delay(1);
+            continue;
+        }
+        do {
+            if (record_path) {
+                traceWriterWrite(&writer, &event);
+            }
+            if (chrome_path) {
+                chromeWriterWrite(&chrome, &event);
+            }
+            finished = (event.type == EVENT_END);
+        } while (!finished && ringPop(ring, &event));
+    }
+    if (record_path) {
+        if (traceWriterClose(&writer) != 0) {
+            fprintf(stderr, "error - Writing the trace file %s failed\n", record_path);
+        } else {
+            printf("recorded %llu records into %s\n", (unsigned long long) writer.count, record_path);
+        }
+    }
+
+    // A trace file is exported through a reader of its own, since the timeline indexes the other one.
+    if (chrome_path && replay_path) {
+        TraceReader source;
+
+        if (traceReaderOpen(&source, replay_path) != 0) {
+            chrome.failed = 1;
+        } else {
+            while (traceReaderNext(&source, &event) && event.type != EVENT_END) {
+                if (chromeWriterWrite(&chrome, &event) != 0) {
+                    break;
+                }
+            }
+            traceReaderClose(&source);
+        }
+        finished = 1;
+    }
+    if (chrome_path) {
+        if (chromeWriterClose(&chrome) != 0) {
+            fprintf(stderr, "error - Writing the Chrome trace %s failed\n", chrome_path);
+        } else {
+            printf("exported %llu records into %s\n", (unsigned long long) chrome.count, chrome_path);
+        }
+    }
+
+    // The render loop plays the recorded push/pop records back at the pace of the scheduler,
+    // until the recursion thread says that there are no more records.
+    // When several steps are due at once, all of them are played back,
+    // but only the last one is drawn.
+    // In the headless mode nobody is watching, so every step is drawn without any pacing.
+    // Between two frames the scheduler waits for events, so input is handled as soon as it arrives.
+    // A replay with a window does not end with the trace file, so it can still be scrubbed,
+    // until the window is closed. Neither does a live run which keeps its history, once it was
+    // jumped along or while it is paused. Once it was rewound, it plays back its history,
+    // and goes on live at the end of it.
+    // Without a history to catch up from, the call tree of a live run is built as the records come,
+    // if it is shown, or could be shown by pressing T. Headless, it is only built with --tree.
+    int live_tree = vis.show_tree || !vis.headless;
+
+    schedulerAdvance(&sched);
+    while (!finished) {
+        handleEvents(&vis, &e);
+
+        Uint32 steps = vis.headless ? 1 : schedulerAdvance(&sched);
+        int    drawn = 0;
+
+        while (steps > 0 && replay_path) {
+            int played = timelineStep(&timeline, &vis.view, vis.show_tree ? &vis.tree : NULL, &event);
+
+            if (played < 0) {
+                fprintf(stderr, "error - Growing the stack view or the call tree failed\n");
+                finished = 1;
+                break;
+            }
+            if (played == 0 || event.type == EVENT_END) {
+                finished = vis.headless;
+                break;
+            }
+            drawn = 1;
+            --steps;
+        }
+
+        while (steps > 0 && vis.history && vis.history->step < vis.history->count) {
+            if (historyStep(vis.history, &vis.view, vis.show_tree ? &vis.tree : NULL, &event) < 0) {
+                fprintf(stderr, "error - Reading back the history failed\n");
+                finished = 1;
+                break;
+            }
+            drawn = 1;
+            --steps;
+        }
+
+        while (steps > 0 && !replay_path && !live_done && !finished) {
+	    // A comparison takes one record of each version at every step.
+	    // A parallel run plays back the next record of any worker, into the lane of that worker.
+            int popped = vis.parallel ? parallelStep(vis.parallel, &event) :
+                         vis.comparison ? comparisonStep(vis.comparison, ring, &event) : ringPop(ring, &event);
+
+            if (popped < 0) {
+                fprintf(stderr, "error - Growing the stack view of the comparison or of a lane failed\n");
+                finished = 1;
+                break;
+            }
+            if (!popped) {
+                break;
+            }
+
+            // The counters of the memoization cache count the records as they are played back.
+            if (vis.memo) {
+                memoMeterApply(vis.memo, &event);
+            }
+
+            // The history keeps every record it plays back.
+            if (vis.history) {
+                if (historyRecord(vis.history, &vis.view, vis.show_tree ? &vis.tree : NULL, &event) != 0) {
+                    fprintf(stderr, "error - Growing the stack view, the call tree or the history failed\n");
+                    finished = 1;
+                    break;
+                }
+            } else if (event.type == EVENT_END) {
+                if (live_tree) {
+                    callTreeApply(&vis.tree, &event);
+                }
+            } else if (!vis.parallel && (stackViewApply(&vis.view, &event) != 0 ||
+                                         (live_tree && callTreeApply(&vis.tree, &event) != 0))) {
+                fprintf(stderr, "error - Growing the stack view or the call tree failed\n");
+                finished = 1;
+                break;
+            }
+
+            if (event.type == EVENT_END) {
+                live_done = 1;
+                break;
+            }
+            drawn = 1;
+            --steps;
+        }
+
+        // A live run is over once its last record was played back, unless the user is still going
+        // along its history: it was jumped along, or it is paused.
+        if (live_done && (!vis.history || (!vis.history->scrubbed && !sched.paused &&
+                                           vis.history->step == vis.history->count))) {
+            finished = 1;
+        }
+
+        // After a jump forwards along the timeline, or once it is shown, the call tree catches up a bit every frame.
+        if (vis.timeline && vis.show_tree && timelineCatchUp(vis.timeline, &vis.tree)) {
+            vis.dirty = 1;
+        }
+        if (vis.history && vis.show_tree && historyCatchUp(vis.history, &vis.tree)) {
+            vis.dirty = 1;
+        }
+
+        // The frame is also redrawn when the viewport moved, or the timeline jumped.
+        if (drawn || vis.dirty) {
+            drawStack(&vis);
+            schedulerFrameDrawn(&sched);
+            vis.dirty = 0;
+        }
+
+        if (!vis.headless) {
+            schedulerWait(&sched);
+        } else if (!drawn && !finished) {
+	    // The recursion thread has not caught up yet, wait a little.
+            SDL_Delay(1);
+        }
+    }
+
+    if (thread) {
+        SDL_WaitThread(thread, NULL);
+    }
+    // Measuring the memoization cache may take longer than the animation did,
+    // so the window keeps handling the user's input until it is done.
+    if (measure_thread) {
+        while (SDL_AtomicGet(&meter.measured) == 0) {
+            handleEvents(&vis, &e);
+            if (vis.dirty) {
+                drawStack(&vis);
+                vis.dirty = 0;
+            }
+            SDL_Delay(10);
+        }
+        SDL_WaitThread(measure_thread, NULL);
+    }
+    coroutineDestroy(&coroutine);
+    free(ring);
+
+    // Tell what the memoization cache saved.
+    if (memo.entries) {
+        printf("memo %s: %llu hits of %llu lookups, %lu entries, %llu evicted, %llu rejected, %llu bytes\n",
+               memoPolicyName(memo.policy), (unsigned long long) memo.hits,
+               (unsigned long long) (memo.hits + memo.misses), (unsigned long) memo.count,
+               (unsigned long long) memo.evictions, (unsigned long long) memo.rejected,
+               (unsigned long long) ((Uint64) memo.slots * sizeof(MemoEntry)));
+        memoDestroy(&memo);
+    }
+
+    // Tell how close the recursion came to running out of runtime stack.
+    if (vis.parallel) {
+        for (i = 0; i < parallel.count; ++i) {
+            if (parallel.workers[i].lane.bytes) {
+                printf("worker %d peak stack use %llu of %llu bytes\n", i,
+                       (unsigned long long) parallel.workers[i].lane.peak,
+                       (unsigned long long) parallel.workers[i].lane.stack_limit);
+            }
+        }
+    } else if (vis.view.bytes) {
+        printf("peak stack use %llu of %llu bytes\n", (unsigned long long) vis.view.peak,
+               (unsigned long long) vis.view.stack_limit);
+    }
+    if (replay_path) {
+        timelineDestroy(&timeline);
+        vis.timeline = NULL;
+        traceReaderClose(&reader);
+    }
+    if (vis.history) {
+        historyDestroy(&history);
+        vis.history = NULL;
+    }
 
     // Draw the main function, without the stack.
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
-    SDL_RenderClear(renderer);
-    SDL_RenderPresent(renderer);
-    SDL_Delay(1000);
+    drawStack(&vis);
+    if (!vis.headless) {
+        holdFrame(&vis, &e);
+    }
 
 
     /* This chunk of code is responsible for safely exiting the program. */
 
-    /* Deallocate dynamic memory for the window and the renderer. */
-    SDL_DestroyWindow(window);
-    SDL_DestroyRenderer(renderer);
+    /* Deallocate dynamic memory for the window, the renderer and the offscreen surface. */
+    destroyVisualizer(&vis);
 
     /* Quit the SDL subsystems and free up any additional used resources. */
     SDL_Quit();
 
     return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,698 @@
+/**
+ * @file    recursion_visualized_memo.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the memoization cache functions, and of its counters.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for calloc(), free()
+#include <string.h>  // C strings - for strcmp(), memset()
+
+#include "recursion_visualized_memo.h"
+#include "recursion_visualized_trace.h"     // Tracer, FUNCTION_*, CYAN
+#include "recursion_visualized_examples.h"  // runExample()
+
+
+/* The names of the policies, indexed by their MEMO_* constants. */
+static const char* const POLICY_NAMES[MEMO_POLICY_COUNT] = { "unbounded", "lru", "fixed" };
+
+/* The height of the counters on top of the window: 6 lines of text and a margin. */
+#define COUNTERS_MARGIN 4
+#define COUNTERS_HEIGHT (6 * GLYPH_HEIGHT + 2 * COUNTERS_MARGIN)
+
+
+/**
+ * The arguments of the thread of memoBenchmark().
+ *
+ * @field int function - The FUNCTION_* constant of the example.
+ *
+ * @field Sint64 n - The problem size.
+ *
+ * @field Uint32 capacity - The capacity of the cache.
+ *
+ * @field MemoCost costs[MEMO_POLICY_COUNT + 1] - Receive the cost without the cache, and with each policy.
+ */
+typedef struct MemoBenchmarkArgs {
+    int      function;
+    Sint64   n;
+    Uint32   capacity;
+    MemoCost costs[MEMO_POLICY_COUNT + 1];
+} MemoBenchmarkArgs;
+
+
+/**
+ * This function hashes the key of a call: the function and its arguments.
+ *
+ * @param Uint16 function - The FUNCTION_* constant of the call.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @return Uint64 - The hash, whose low bits pick the slot.
+ */
+static Uint64 hashKey(Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2)
+{
+    Uint64 hash = (Uint64) a0 * 0x9E3779B97F4A7C15ULL + (Uint64) a1 * 0xC2B2AE3D27D4EB4FULL +
+                  (Uint64) a2 * 0x165667B19E3779F9ULL + function;
+
+    // The finalizer of MurmurHash3, so that every bit of the key moves the low bits.
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+
+/**
+ * This function finds the slot of a call: the one holding its entry, or the empty one where its
+ * entry would go. The table is never more than half full, so there always is an empty slot.
+ *
+ * @param const Memo* memo - A pointer to the cache.
+ *
+ * @param Uint16 function - The FUNCTION_* constant of the call.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @return Uint32 - The slot.
+ */
+static Uint32 findSlot(const Memo* memo, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2)
+{
+    Uint32 mask = memo->slots - 1;
+    Uint32 slot = (Uint32) hashKey(function, a0, a1, a2) & mask;
+
+    for (;;) {
+        const MemoEntry* entry = &memo->entries[slot];
+
+        if (!entry->used || (entry->function == function && entry->args[0] == a0 &&
+                             entry->args[1] == a1 && entry->args[2] == a2)) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+
+/**
+ * This function takes an entry out of the list from the most to the least recently used.
+ *
+ * @param Memo* memo - A pointer to the cache, whose policy is MEMO_LRU.
+ *
+ * @param Uint32 slot - The slot of the entry.
+ */
+static void unlinkEntry(Memo* memo, Uint32 slot)
+{
+    MemoEntry* entry = &memo->entries[slot];
+
+    if (entry->newer != MEMO_END) {
+        memo->entries[entry->newer].older = entry->older;
+    } else {
+        memo->newest = entry->older;
+    }
+    if (entry->older != MEMO_END) {
+        memo->entries[entry->older].newer = entry->newer;
+    } else {
+        memo->oldest = entry->newer;
+    }
+}
+
+
+/**
+ * This function puts an entry at the front of the list, as the most recently used one.
+ *
+ * @param Memo* memo - A pointer to the cache, whose policy is MEMO_LRU.
+ *
+ * @param Uint32 slot - The slot of the entry, which is not in the list.
+ */
+static void linkNewest(Memo* memo, Uint32 slot)
+{
+    MemoEntry* entry = &memo->entries[slot];
+
+    entry->newer = MEMO_END;
+    entry->older = memo->newest;
+    if (memo->newest != MEMO_END) {
+        memo->entries[memo->newest].newer = slot;
+    } else {
+        memo->oldest = slot;
+    }
+    memo->newest = slot;
+}
+
+
+/**
+ * This function moves an entry into another slot, and points its neighbours in the list at it.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ *
+ * @param Uint32 from - The slot of the entry.
+ *
+ * @param Uint32 to - The empty slot to move it into.
+ */
+static void moveEntry(Memo* memo, Uint32 from, Uint32 to)
+{
+    MemoEntry* entry = &memo->entries[to];
+
+    *entry = memo->entries[from];
+    memo->entries[from].used = 0;
+
+    if (memo->policy != MEMO_LRU) {
+        return;
+    }
+    if (entry->newer != MEMO_END) {
+        memo->entries[entry->newer].older = to;
+    } else {
+        memo->newest = to;
+    }
+    if (entry->older != MEMO_END) {
+        memo->entries[entry->older].newer = to;
+    } else {
+        memo->oldest = to;
+    }
+}
+
+
+/**
+ * This function removes an entry. The entries after it which were pushed past its slot by
+ * collisions are shifted back, so that every entry can still be found from its own slot.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ *
+ * @param Uint32 hole - The slot of the entry.
+ */
+static void removeEntry(Memo* memo, Uint32 hole)
+{
+    Uint32 mask = memo->slots - 1;
+    Uint32 slot = hole;
+
+    if (memo->policy == MEMO_LRU) {
+        unlinkEntry(memo, hole);
+    }
+    memo->entries[hole].used = 0;
+    --memo->count;
+
+    for (;;) {
+        const MemoEntry* entry;
+        Uint32           home;
+
+        slot  = (slot + 1) & mask;
+        entry = &memo->entries[slot];
+        if (!entry->used) {
+            break;
+        }
+
+	// The entry may move into the hole only if the hole lies between its own slot and where it is.
+        home = (Uint32) hashKey(entry->function, entry->args[0], entry->args[1], entry->args[2]) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            moveEntry(memo, slot, hole);
+            hole = slot;
+        }
+    }
+}
+
+
+/**
+ * This function doubles the hash table of an unbounded cache, as often as it takes
+ * for one more entry to fit, and puts the entries into their slots in the new one.
+ *
+ * @param Memo* memo - A pointer to the cache, whose policy is MEMO_UNBOUNDED.
+ *
+ * @return int - 0 on success, -1 if the new table could not be allocated.
+ */
+static int growTable(Memo* memo)
+{
+    Uint64     slots = memoSlots(memo->policy, memo->capacity, (Uint64) memo->count + 1);
+    MemoEntry* old   = memo->entries;
+    Uint32     count = memo->slots;
+    Uint32     i;
+
+    if (slots > 0x80000000ULL) {
+        return -1;
+    }
+    memo->entries = (MemoEntry*) calloc((size_t) slots, sizeof(MemoEntry));
+    if (!memo->entries) {
+        memo->entries = old;
+        return -1;
+    }
+    memo->slots = (Uint32) slots;
+
+    for (i = 0; i < count; ++i) {
+        if (old[i].used) {
+            memo->entries[findSlot(memo, old[i].function, old[i].args[0], old[i].args[1], old[i].args[2])] = old[i];
+        }
+    }
+    free(old);
+
+    return 0;
+}
+
+
+/**
+ * This function publishes the counters of a cache shared with another thread, which
+ * memoReadCounters() reads. The version is odd while they are written.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ */
+static void publishCounters(Memo* memo)
+{
+    SDL_AtomicAdd(&memo->version, 1);
+    SDL_MemoryBarrierRelease();
+    memo->published.entries   = memo->count;
+    memo->published.evictions = memo->evictions;
+    memo->published.rejected  = memo->rejected;
+    memo->published.bytes     = (Uint64) memo->slots * sizeof(MemoEntry);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicAdd(&memo->version, 1);
+}
+
+
+int memoFindPolicy(const char* name)
+{
+    int policy;
+
+    for (policy = 0; policy < MEMO_POLICY_COUNT; ++policy) {
+        if (strcmp(name, POLICY_NAMES[policy]) == 0) {
+            return policy;
+        }
+    }
+
+    return MEMO_NONE;
+}
+
+
+const char* memoPolicyName(int policy)
+{
+    return (policy >= 0 && policy < MEMO_POLICY_COUNT) ? POLICY_NAMES[policy] : "none";
+}
+
+
+int memoSupported(int function)
+{
+    return function == FUNCTION_FACTORIAL || function == FUNCTION_FIBONACCI ||
+           function == FUNCTION_HANOI || function == FUNCTION_ACKERMANN;
+}
+
+
+Uint64 memoSlots(int policy, Uint32 capacity, Uint64 entries)
+{
+    Uint64 slots = MEMO_MIN_SLOTS;
+
+    // The table is kept at most half full, so that the probes stay short.
+    while (slots < 2 * (Uint64) capacity) {
+        slots *= 2;
+    }
+    while (policy == MEMO_UNBOUNDED && slots < 2 * entries) {
+        slots *= 2;
+    }
+
+    return slots;
+}
+
+
+int memoInit(Memo* memo, int policy, Uint32 capacity)
+{
+    memo->slots   = (Uint32) memoSlots(policy, capacity, 0);
+    memo->entries = (MemoEntry*) calloc(memo->slots, sizeof(MemoEntry));
+    if (!memo->entries) {
+        return -1;
+    }
+
+    memo->capacity  = capacity;
+    memo->count     = 0;
+    memo->policy    = policy;
+    memo->newest    = MEMO_END;
+    memo->oldest    = MEMO_END;
+    memo->hits      = 0;
+    memo->misses    = 0;
+    memo->evictions = 0;
+    memo->rejected  = 0;
+    memo->shared    = 0;
+    SDL_AtomicSet(&memo->version, 0);
+    memset(&memo->published, 0, sizeof(memo->published));
+
+    return 0;
+}
+
+
+void memoDestroy(Memo* memo)
+{
+    free(memo->entries);
+    memo->entries = NULL;
+    memo->slots   = 0;
+    memo->count   = 0;
+}
+
+
+int memoFind(Memo* memo, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2, Sint64* value)
+{
+    Uint32 slot = findSlot(memo, function, a0, a1, a2);
+
+    if (!memo->entries[slot].used) {
+        ++memo->misses;
+        return 0;
+    }
+
+    ++memo->hits;
+    if (memo->policy == MEMO_LRU && memo->newest != slot) {
+        unlinkEntry(memo, slot);
+        linkNewest(memo, slot);
+    }
+    *value = memo->entries[slot].value;
+
+    return 1;
+}
+
+
+void memoStore(Memo* memo, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2, Sint64 value)
+{
+    Uint32     slot = findSlot(memo, function, a0, a1, a2);
+    MemoEntry* entry;
+
+    // A result which is already there is only updated.
+    if (memo->entries[slot].used) {
+        memo->entries[slot].value = value;
+        return;
+    }
+
+    // Otherwise the policy decides where the room for it comes from.
+    if (memo->policy == MEMO_UNBOUNDED && 2 * ((Uint64) memo->count + 1) > memo->slots) {
+        if (growTable(memo) != 0) {
+            ++memo->rejected;
+            if (memo->shared) {
+                publishCounters(memo);
+            }
+            return;
+        }
+        slot = findSlot(memo, function, a0, a1, a2);
+    } else if (memo->policy == MEMO_FIXED && memo->count >= memo->capacity) {
+        ++memo->rejected;
+        if (memo->shared) {
+            publishCounters(memo);
+        }
+        return;
+    } else if (memo->policy == MEMO_LRU && memo->count >= memo->capacity) {
+        removeEntry(memo, memo->oldest);
+        ++memo->evictions;
+        slot = findSlot(memo, function, a0, a1, a2);
+    }
+
+    entry = &memo->entries[slot];
+    entry->args[0]  = a0;
+    entry->args[1]  = a1;
+    entry->args[2]  = a2;
+    entry->value    = value;
+    entry->function = function;
+    entry->used     = 1;
+    ++memo->count;
+
+    if (memo->policy == MEMO_LRU) {
+        linkNewest(memo, slot);
+    }
+    if (memo->shared) {
+        publishCounters(memo);
+    }
+}
+
+
+void memoReadCounters(const Memo* memo, MemoCounters* counters)
+{
+    int version;
+
+    do {
+        version = SDL_AtomicGet((SDL_atomic_t*) &memo->version);
+        SDL_MemoryBarrierAcquire();
+        *counters = memo->published;
+        SDL_MemoryBarrierAcquire();
+    } while ((version & 1) || SDL_AtomicGet((SDL_atomic_t*) &memo->version) != version);
+}
+
+
+/**
+ * This function runs an example once with a Tracer which keeps nothing, and measures it.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param int policy - The policy of the cache, or MEMO_NONE to run without one.
+ *
+ * @param Uint32 capacity - The capacity of the cache.
+ *
+ * @param MemoCost* cost - Receives the cost of the run.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ */
+static int measureRun(int function, Sint64 n, int policy, Uint32 capacity, MemoCost* cost)
+{
+    Tracer tracer;
+    Memo   memo;
+    Sint64 result;
+    int    status;
+    Uint64 start;
+    Uint64 ticks;
+
+    if (tracerInit(&tracer, 0, NULL) != 0) {
+        return -1;
+    }
+    if (policy != MEMO_NONE) {
+        if (memoInit(&memo, policy, capacity) != 0) {
+            tracerDestroy(&tracer);
+            return -1;
+        }
+        tracer.memo = &memo;
+    }
+
+    start  = SDL_GetPerformanceCounter();
+    status = runExample(&tracer, function, n, &result);
+    ticks  = SDL_GetPerformanceCounter() - start;
+
+    // Without a ring buffer or room to keep them, the records are only counted.
+    memset(cost, 0, sizeof(*cost));
+    cost->calls       = tracer.dropped / 2;
+    cost->nanoseconds = (Uint64) ((double) ticks * 1e9 / SDL_GetPerformanceFrequency());
+    if (tracer.memo) {
+        cost->hits      = memo.hits;
+        cost->entries   = memo.count;
+        cost->evictions = memo.evictions;
+        cost->rejected  = memo.rejected;
+        cost->bytes     = (Uint64) memo.slots * sizeof(MemoEntry);
+        memoDestroy(&memo);
+    }
+    tracerDestroy(&tracer);
+
+    return status;
+}
+
+
+/**
+ * This function measures an example MEMO_RUNS times, and keeps the fastest run.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param int policy - The policy of the cache, or MEMO_NONE to run without one.
+ *
+ * @param Uint32 capacity - The capacity of the cache.
+ *
+ * @param MemoCost* cost - Receives the cost of the fastest run.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ */
+static int measureFastest(int function, Sint64 n, int policy, Uint32 capacity, MemoCost* cost)
+{
+    MemoCost run_cost;
+    int      run;
+
+    for (run = 0; run < MEMO_RUNS; ++run) {
+        if (measureRun(function, n, policy, capacity, &run_cost) != 0) {
+            return -1;
+        }
+        if (run == 0 || run_cost.nanoseconds < cost->nanoseconds) {
+            *cost = run_cost;
+        }
+    }
+
+    return 0;
+}
+
+
+int memoMeasure(int function, Sint64 n, int policy, Uint32 capacity, MemoCost* costs)
+{
+    if (measureFastest(function, n, MEMO_NONE, capacity, &costs[0]) != 0) {
+        return -1;
+    }
+
+    return measureFastest(function, n, policy, capacity, &costs[1]);
+}
+
+
+void memoMeterInit(MemoMeter* meter, Memo* memo, int function, Sint64 n)
+{
+    memset(meter, 0, sizeof(*meter));
+    meter->function = function;
+    meter->n        = n;
+    meter->policy   = memo->policy;
+    meter->capacity = memo->capacity;
+    meter->memo     = memo;
+    SDL_AtomicSet(&meter->measured, 0);
+
+    memo->shared = 1;
+    publishCounters(memo);
+}
+
+
+int memoMeterThread(void* data)
+{
+    MemoMeter* meter  = (MemoMeter*) data;
+    int        status = memoMeasure(meter->function, meter->n, meter->policy, meter->capacity, meter->costs);
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&meter->measured, (status == 0) ? 1 : -1);
+
+    return status;
+}
+
+
+void memoMeterApply(MemoMeter* meter, const StackEvent* event)
+{
+    if (event->type == EVENT_PUSH) {
+        ++meter->calls;
+        if (event->color == CYAN) {
+            ++meter->hits;
+        }
+    }
+}
+
+
+void memoMeterDraw(const MemoMeter* meter, SDL_Renderer* renderer, GlyphAtlas* atlas, int width)
+{
+    const MemoCost* costs = meter->costs;
+    MemoCounters    counters;
+    SDL_Rect        band;
+    int             x = COUNTERS_MARGIN;
+    int             y = COUNTERS_MARGIN;
+    char            text[64];
+
+    // The entries, and what was evicted or not stored, are read from the cache itself.
+    memoReadCounters(meter->memo, &counters);
+
+    band.x = 0;
+    band.y = 0;
+    band.w = width;
+    band.h = COUNTERS_HEIGHT;
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderFillRect(renderer, &band);
+
+    SDL_snprintf(text, sizeof(text), "memo %s, capacity %lu", memoPolicyName(meter->policy),
+                 (unsigned long) meter->capacity);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "calls %llu, hits %llu (%.1f%%)", (unsigned long long) meter->calls,
+                 (unsigned long long) meter->hits, (meter->calls > 0) ? 100.0 * meter->hits / meter->calls : 0.0);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "entries %llu, evicted %llu, rejected %llu",
+                 (unsigned long long) counters.entries, (unsigned long long) counters.evictions,
+                 (unsigned long long) counters.rejected);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "memory %llu bytes", (unsigned long long) counters.bytes);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    // What a whole run costs at full speed is known once it was measured.
+    if (SDL_AtomicGet((SDL_atomic_t*) &meter->measured) == 0) {
+        glyphAtlasText(atlas, x, y, "measuring...");
+        glyphAtlasFlush(atlas, renderer);
+        return;
+    }
+    if (SDL_AtomicGet((SDL_atomic_t*) &meter->measured) < 0) {
+        glyphAtlasText(atlas, x, y, "measuring failed");
+        glyphAtlasFlush(atlas, renderer);
+        return;
+    }
+    SDL_MemoryBarrierAcquire();
+
+    SDL_snprintf(text, sizeof(text), "run %llu calls, uncached %llu",
+                 (unsigned long long) costs[1].calls, (unsigned long long) costs[0].calls);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "run %.3f ms, uncached %.3f ms", costs[1].nanoseconds / 1e6,
+                 costs[0].nanoseconds / 1e6);
+    glyphAtlasText(atlas, x, y, text);
+
+    glyphAtlasFlush(atlas, renderer);
+}
+
+
+/**
+ * This is the entry point of the thread of memoBenchmark(), as required by SDL_CreateThread().
+ *
+ * @param void* data - A pointer to the MemoBenchmarkArgs, whose costs receive the measurements.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ */
+static int benchmarkThread(void* data)
+{
+    MemoBenchmarkArgs* args = (MemoBenchmarkArgs*) data;
+    int                policy;
+
+    for (policy = MEMO_NONE; policy < MEMO_POLICY_COUNT; ++policy) {
+        if (measureFastest(args->function, args->n, policy, args->capacity, &args->costs[policy + 1]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+int memoBenchmark(int function, Sint64 n, Uint32 capacity, size_t stack_size, FILE* out)
+{
+    MemoBenchmarkArgs args;
+    SDL_Thread*       thread;
+    int               result = -1;
+    int               policy;
+
+    memset(&args, 0, sizeof(args));
+    args.function = function;
+    args.n        = n;
+    args.capacity = capacity;
+
+    thread = SDL_CreateThreadWithStackSize(benchmarkThread, "benchmark", stack_size, &args);
+    if (!thread) {
+        return -1;
+    }
+    SDL_WaitThread(thread, &result);
+    if (result != 0) {
+        return -1;
+    }
+
+    fprintf(out, "memo,capacity,calls,hits,hit_rate,entries,evictions,rejected,bytes,nanoseconds,speedup\n");
+    for (policy = MEMO_NONE; policy < MEMO_POLICY_COUNT; ++policy) {
+        const MemoCost* cost = &args.costs[policy + 1];
+
+        fprintf(out, "%s,%lu,%llu,%llu,%.4f,%llu,%llu,%llu,%llu,%llu,%.2f\n", memoPolicyName(policy),
+                (policy == MEMO_NONE) ? 0UL : (unsigned long) capacity, (unsigned long long) cost->calls,
+                (unsigned long long) cost->hits, (cost->calls > 0) ? (double) cost->hits / cost->calls : 0.0,
+                (unsigned long long) cost->entries, (unsigned long long) cost->evictions,
+                (unsigned long long) cost->rejected, (unsigned long long) cost->bytes,
+                (unsigned long long) cost->nanoseconds,
+                (cost->nanoseconds > 0) ? (double) args.costs[0].nanoseconds / cost->nanoseconds : 0.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,512 @@
+/**
+ * @file    recursion_visualized_memo.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the memoization cache, which a traced recursive function
+ * can look its calls up in, so that a call which was already made returns its result right away
+ * instead of recursing again. Tree recursion like fibonacci() makes an exponential number of calls,
+ * most of them over and over with the same arguments. With the cache, each of them is made once.
+ *
+ * The cache is an open-addressing hash table with linear probing, keyed on the function and its
+ * arguments. It is kept at most half full, so a lookup rarely probes more than one or two slots,
+ * and entries are removed by shifting the ones after them back, so no tombstones pile up.
+ * How it behaves when it holds as many entries as its capacity depends on its policy:
+ *   MEMO_UNBOUNDED  The table grows, so every result is kept. The capacity is only its initial size.
+ *   MEMO_LRU        The least recently used entry is evicted to make room for the new one.
+ *   MEMO_FIXED      Nothing more is stored, and the entries it already holds are kept.
+ *
+ * The cache is opt-in. A Tracer without one looks nothing up, and a traced function which uses it,
+ * see TRACE_MEMO_HIT() in recursion_visualized_trace.h, runs the same as one which does not.
+ * A call which is answered from the cache is recorded as a push and a pop in CYAN, so it is
+ * drawn as a short-circuited stack frame, and the call tree shows how the recursion collapses.
+ *
+ * The MemoMeter counts the calls and the hits from the records as they are played back, so they
+ * stay in step with the animation. The entries, the results evicted or not stored and the memory
+ * are the cache's own counters, which it publishes for the render loop every time it stores a result,
+ * so they can be ahead of the animation by the records still in the ring buffer. What a whole run costs with and
+ * without the cache at full speed is measured on a thread of its own, memoMeterThread(), while the
+ * animation plays, MEMO_RUNS times, taking the fastest run.
+ * They are drawn on a black band across the top of the window.
+ *
+ * In the headless mode, only the measurements are made, without the cache and with every policy,
+ * and written to stdout as CSV:
+ *   memo,capacity,calls,hits,hit_rate,entries,evictions,rejected,bytes,nanoseconds,speedup
+ */
+
+#ifndef RECURSION_VISUALIZED_MEMO_H
+#define RECURSION_VISUALIZED_MEMO_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"  // StackEvent, STACK_EVENT_ARGS
+#include "recursion_visualized_font.h"  // GlyphAtlas
+
+
+/* The policies of the cache. MEMO_NONE runs without a cache, to measure what it saves. */
+#define MEMO_NONE         (-1)
+#define MEMO_UNBOUNDED    0
+#define MEMO_LRU          1
+#define MEMO_FIXED        2
+#define MEMO_POLICY_COUNT 3
+
+/* The default capacity of the cache, in entries, and the greatest one it can be given. */
+#define MEMO_DEFAULT_CAPACITY 1024
+#define MEMO_MAX_CAPACITY     (1 << 28)
+
+/* The fewest slots the hash table has. */
+#define MEMO_MIN_SLOTS 16
+
+/* Marks the end of the list of entries from the most to the least recently used. */
+#define MEMO_END 0xFFFFFFFF
+
+/* How many times each run is measured. The fastest run counts. */
+#define MEMO_RUNS 5
+
+
+/**
+ * One slot of the hash table.
+ *
+ * @field Sint64 args[STACK_EVENT_ARGS] - The arguments of the call, the rest of the key.
+ *
+ * @field Sint64 value - What the call returned.
+ *
+ * @field Uint32 newer, older - The slots of the entries used right after and right before this one,
+ *                              or MEMO_END. Only the MEMO_LRU policy keeps them.
+ *
+ * @field Uint16 function - The FUNCTION_* constant of the call, the first part of the key.
+ *
+ * @field Uint16 used - Nonzero if the slot holds an entry.
+ */
+typedef struct MemoEntry {
+    Sint64 args[STACK_EVENT_ARGS];
+    Sint64 value;
+    Uint32 newer;
+    Uint32 older;
+    Uint16 function;
+    Uint16 used;
+} MemoEntry;
+
+
+/**
+ * The counters of the cache which change when it stores a result.
+ *
+ * @field Uint64 entries - The number of entries.
+ *
+ * @field Uint64 evictions - How many entries were evicted to make room for new ones.
+ *
+ * @field Uint64 rejected - How many results were not stored, because the cache was full.
+ *
+ * @field Uint64 bytes - The size of the hash table.
+ */
+typedef struct MemoCounters {
+    Uint64 entries;
+    Uint64 evictions;
+    Uint64 rejected;
+    Uint64 bytes;
+} MemoCounters;
+
+
+/**
+ * The memoization cache.
+ *
+ * @field MemoEntry* entries - The hash table.
+ *
+ * @field Uint32 slots - The number of slots, a power of 2.
+ *
+ * @field Uint32 capacity - The most entries the cache holds, or its initial size for MEMO_UNBOUNDED.
+ *
+ * @field Uint32 count - The number of entries.
+ *
+ * @field int policy - MEMO_UNBOUNDED, MEMO_LRU or MEMO_FIXED.
+ *
+ * @field Uint32 newest, oldest - The slots of the most and the least recently used entries, or MEMO_END.
+ *
+ * @field Uint64 hits, misses - How many lookups found an entry, and how many did not.
+ *
+ * @field Uint64 evictions - How many entries were evicted to make room for new ones.
+ *
+ * @field Uint64 rejected - How many results were not stored, because the cache was full.
+ *
+ * @field int shared - Nonzero if the counters are published for another thread, see memoReadCounters().
+ *
+ * @field SDL_atomic_t version - Odd while the published counters are being written.
+ *
+ * @field MemoCounters published - The counters as they were last published.
+ */
+typedef struct Memo {
+    MemoEntry*   entries;
+    Uint32       slots;
+    Uint32       capacity;
+    Uint32       count;
+    int          policy;
+    Uint32       newest;
+    Uint32       oldest;
+    Uint64       hits;
+    Uint64       misses;
+    Uint64       evictions;
+    Uint64       rejected;
+    int          shared;
+    SDL_atomic_t version;
+    MemoCounters published;
+} Memo;
+
+
+/**
+ * What a whole run of an example costs, with or without the cache.
+ *
+ * @field Uint64 calls - The number of calls, those answered from the cache included.
+ *
+ * @field Uint64 hits - How many calls were answered from the cache.
+ *
+ * @field Uint64 entries, evictions, rejected - The entries the cache held at the end,
+ *                                              and how many it evicted and did not store.
+ *
+ * @field Uint64 bytes - The size of the hash table at the end.
+ *
+ * @field Uint64 nanoseconds - The wall time of the fastest run.
+ */
+typedef struct MemoCost {
+    Uint64 calls;
+    Uint64 hits;
+    Uint64 entries;
+    Uint64 evictions;
+    Uint64 rejected;
+    Uint64 bytes;
+    Uint64 nanoseconds;
+} MemoCost;
+
+
+/**
+ * The counters of the cache of a live run, which are drawn on top of the window.
+ *
+ * @field int function - The FUNCTION_* constant of the example.
+ *
+ * @field Sint64 n - The problem size.
+ *
+ * @field int policy - The policy of the cache.
+ *
+ * @field Uint32 capacity - The capacity of the cache.
+ *
+ * @field Memo* memo - The cache, whose published counters are drawn.
+ *
+ * @field Uint64 calls, hits - The calls and the hits played back so far.
+ *
+ * @field MemoCost costs[2] - What a whole run costs without the cache, and with it, once measured is set.
+ *
+ * @field SDL_atomic_t measured - Set by memoMeterThread() once it measured both, to 1,
+ *                                or to -1 if measuring them failed.
+ */
+typedef struct MemoMeter {
+    int          function;
+    Sint64       n;
+    int          policy;
+    Uint32       capacity;
+    Memo*        memo;
+    Uint64       calls;
+    Uint64       hits;
+    MemoCost     costs[2];
+    SDL_atomic_t measured;
+} MemoMeter;
+
+
+/**
+ * This function looks up a policy by the name it is given on the command line:
+ * "unbounded", "lru" or "fixed".
+ *
+ * @param const char* name - The name of the policy.
+ *
+ * @return int - The MEMO_* constant of the policy, or MEMO_NONE if there is no such policy.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoFindPolicy(const char* name);
+
+
+/**
+ * This function gives the name of a policy.
+ *
+ * @param int policy - A MEMO_* constant.
+ *
+ * @return const char* - The name of the policy, "none" for MEMO_NONE.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+const char* memoPolicyName(int policy);
+
+
+/**
+ * This function tells whether the results of a traced function can be cached.
+ * Only the ones which return the same result for the same arguments, and change nothing else,
+ * can be: factorial, fibonacci, hanoi and ackermann. The sorts sort their arrays in place.
+ *
+ * @param int function - The FUNCTION_* constant of the function.
+ *
+ * @return int - Nonzero if the function can be memoized.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoSupported(int function);
+
+
+/**
+ * This function computes how many slots the hash table of a cache has while it holds some entries.
+ * It is at least twice the capacity, and for MEMO_UNBOUNDED at least twice the entries as well.
+ *
+ * @param int policy - The policy of the cache.
+ *
+ * @param Uint32 capacity - The capacity of the cache.
+ *
+ * @param Uint64 entries - The number of entries.
+ *
+ * @return Uint64 - The number of slots.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint64 memoSlots(int policy, Uint32 capacity, Uint64 entries);
+
+
+/**
+ * This function sets up an empty cache.
+ *
+ * @param Memo* memo - A pointer to the cache to initialize.
+ *
+ * @param int policy - MEMO_UNBOUNDED, MEMO_LRU or MEMO_FIXED.
+ *
+ * @param Uint32 capacity - The most entries to hold, from 1 to MEMO_MAX_CAPACITY.
+ *
+ * @return int - 0 on success, -1 if the hash table could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoInit(Memo* memo, int policy, Uint32 capacity);
+
+
+/**
+ * This function deallocates the hash table of a cache.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoDestroy(Memo* memo);
+
+
+/**
+ * This function looks up the result of a call in the cache.
+ * With the MEMO_LRU policy, an entry which is found becomes the most recently used one.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ *
+ * @param Uint16 function - The FUNCTION_* constant of the call.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @param Sint64* value - Receives the result, if it was found.
+ *
+ * @return int - 1 if the result was found, 0 if not.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoFind(Memo* memo, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2, Sint64* value);
+
+
+/**
+ * This function stores the result of a call into the cache, as far as its policy allows.
+ *
+ * @param Memo* memo - A pointer to the cache.
+ *
+ * @param Uint16 function - The FUNCTION_* constant of the call.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @param Sint64 value - The result.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoStore(Memo* memo, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2, Sint64 value);
+
+
+/**
+ * This function reads the counters which a cache shared with another thread published last.
+ * It is lock-free: it reads them again if they were being written meanwhile.
+ *
+ * @param const Memo* memo - A pointer to the cache.
+ *
+ * @param MemoCounters* counters - Receives the counters.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoReadCounters(const Memo* memo, MemoCounters* counters);
+
+
+/**
+ * This function measures what a whole run of an example costs without the cache, and with it.
+ * The example needs a runtime stack as deep as it recurses.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param int policy - The policy of the cache.
+ *
+ * @param Uint32 capacity - The capacity of the cache.
+ *
+ * @param MemoCost* costs - Receives the cost without the cache and with it.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoMeasure(int function, Sint64 n, int policy, Uint32 capacity, MemoCost* costs);
+
+
+/**
+ * This function sets up the counters of the cache of a live run, and has the cache publish its own.
+ * Its costs are not measured yet.
+ *
+ * @param MemoMeter* meter - A pointer to the counters to initialize.
+ *
+ * @param Memo* memo - The cache, which must not have been used yet.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoMeterInit(MemoMeter* meter, Memo* memo, int function, Sint64 n);
+
+
+/**
+ * This is the entry point of the thread which measures the costs of a MemoMeter,
+ * as required by SDL_CreateThread(). It runs alongside the recursion, so the animation starts
+ * right away, and needs a runtime stack as big as the one of the recursion thread.
+ *
+ * @param void* data - A pointer to the MemoMeter, whose costs receive the measurements.
+ *
+ * @return int - 0 on success, -1 if the example could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoMeterThread(void* data);
+
+
+/**
+ * This function counts one record that is played back into the counters.
+ * A push is a call, and a push in CYAN a hit.
+ *
+ * @param MemoMeter* meter - A pointer to the counters.
+ *
+ * @param const StackEvent* event - The record.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoMeterApply(MemoMeter* meter, const StackEvent* event);
+
+
+/**
+ * This function draws the counters on a black band across the top of the window.
+ *
+ * @param const MemoMeter* meter - A pointer to the counters.
+ *
+ * @param SDL_Renderer* renderer - The renderer.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with.
+ *
+ * @param int width - The width of the band, in pixels.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void memoMeterDraw(const MemoMeter* meter, SDL_Renderer* renderer, GlyphAtlas* atlas, int width);
+
+
+/**
+ * This function measures an example without the cache and with every policy, on a thread with a
+ * big enough runtime stack, and writes the costs as CSV, with a header line.
+ *
+ * @param int function - The FUNCTION_* constant of the example.
+ *
+ * @param Sint64 n - The problem size.
+ *
+ * @param Uint32 capacity - The capacity of the cache.
+ *
+ * @param size_t stack_size - The size of the runtime stack of the example.
+ *
+ * @param FILE* out - Where to write the CSV.
+ *
+ * @return int - 0 on success, -1 if the thread could not be created or the example could not be run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int memoBenchmark(int function, Sint64 n, Uint32 capacity, size_t stack_size, FILE* out);
+
+#endif /* RECURSION_VISUALIZED_MEMO_H */
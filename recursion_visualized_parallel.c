@@ -0,0 +1,840 @@
+/**
+ * @file    recursion_visualized_parallel.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the work-stealing scheduler, the parallel versions of the sorting examples,
+ * and the definitions of the parallel mode functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+#include <stdio.h>   // C standard input/output - for fprintf()
+#include <string.h>  // C strings - for memset()
+
+#include "recursion_visualized_parallel.h"
+#include "recursion_visualized_trace.h"     // Tracer, TRACE_ENTER(), TRACE_EXIT(), traceTicks()
+#include "recursion_visualized_examples.h"  // exampleArray(), quicksortPartition(), mergesortMerge()
+
+
+/* The height of the counters on top of each lane: 5 lines of text and a margin. */
+#define COUNTERS_MARGIN 4
+#define COUNTERS_HEIGHT (5 * GLYPH_HEIGHT + 2 * COUNTERS_MARGIN)
+
+
+/**
+ * Records the entrance into a parallel sort on the worker running it, like TRACE_ENTER() does.
+ * The buffer of the worker is grown first if it is full, and the first call of a stolen task is
+ * recolored GOLD. It has to be a macro, so that the stack frame of the sort itself is recorded.
+ */
+#define PARALLEL_ENTER(worker, function, low, high)                          \
+    do {                                                                     \
+        if ((worker)->tracer->count == (worker)->tracer->capacity) {         \
+            growRecords(worker);                                             \
+        }                                                                    \
+        TRACE_ENTER((worker)->tracer, (function), (low), (high), 0);         \
+        if ((worker)->stolen) {                                              \
+            markStolen(worker);                                              \
+        }                                                                    \
+    } while (0)
+
+/**
+ * Records the exit out of a parallel sort, like TRACE_EXIT() does.
+ */
+#define PARALLEL_EXIT(worker, function, low, high)                           \
+    do {                                                                     \
+        if ((worker)->tracer->count == (worker)->tracer->capacity) {         \
+            growRecords(worker);                                             \
+        }                                                                    \
+        TRACE_EXIT((worker)->tracer, (function), (low), (high), 0);          \
+    } while (0)
+
+
+static void runTask(ParallelWorker* self, ParallelTask* task);
+
+
+/**
+ * This function doubles the buffer of the records of a worker. Only the worker itself calls it,
+ * so it needs no lock. If there is no memory for it, the records which do not fit are dropped.
+ *
+ * @param ParallelWorker* self - The worker.
+ */
+static void growRecords(ParallelWorker* self)
+{
+    Tracer*     tracer   = self->tracer;
+    Uint64      capacity = (tracer->capacity > 0) ? tracer->capacity * 2 : PARALLEL_TRACE_CAPACITY;
+    StackEvent* events   = (StackEvent*) realloc(tracer->events, capacity * sizeof(StackEvent));
+
+    if (events) {
+        tracer->events   = events;
+        tracer->capacity = capacity;
+    }
+}
+
+
+/**
+ * This function recolors the record just made, the first call of a stolen task, GOLD.
+ *
+ * @param ParallelWorker* self - The worker, which has just stolen the task.
+ */
+static void markStolen(ParallelWorker* self)
+{
+    Tracer* tracer = self->tracer;
+
+    if (tracer->count > 0 && tracer->events[tracer->count - 1].type == EVENT_PUSH) {
+        tracer->events[tracer->count - 1].color = GOLD;
+    }
+    self->stolen = 0;
+}
+
+
+/**
+ * This function pushes a task onto the bottom of the deque of the worker, where thieves can take it.
+ * If the deque is full, the task is run right away instead.
+ *
+ * @param ParallelWorker* self - The worker which spawns the task.
+ *
+ * @param ParallelTask* task - The task.
+ */
+static void spawnTask(ParallelWorker* self, ParallelTask* task)
+{
+    int pushed = 0;
+
+    SDL_AtomicLock(&self->lock);
+    if (self->bottom - self->top < PARALLEL_DEQUE_CAPACITY) {
+        self->tasks[self->bottom & PARALLEL_DEQUE_MASK] = task;
+        ++self->bottom;
+        pushed = 1;
+    }
+    SDL_AtomicUnlock(&self->lock);
+
+    if (!pushed) {
+        runTask(self, task);
+    }
+}
+
+
+/**
+ * This function pops the newest task off the bottom of the deque of the worker.
+ *
+ * @param ParallelWorker* self - The worker.
+ *
+ * @return ParallelTask* - The task, or NULL if the deque is empty.
+ */
+static ParallelTask* popTask(ParallelWorker* self)
+{
+    ParallelTask* task = NULL;
+
+    SDL_AtomicLock(&self->lock);
+    if (self->bottom != self->top) {
+        --self->bottom;
+        task = self->tasks[self->bottom & PARALLEL_DEQUE_MASK];
+    }
+    SDL_AtomicUnlock(&self->lock);
+
+    return task;
+}
+
+
+/**
+ * This function steals the oldest task off the top of the deque of another worker. The workers are
+ * tried one after the other, starting from one picked at random, so the thieves spread out.
+ *
+ * @param ParallelWorker* self - The thief.
+ *
+ * @return ParallelTask* - The task, or NULL if every other deque is empty.
+ */
+static ParallelTask* stealTask(ParallelWorker* self)
+{
+    Parallel* parallel = self->parallel;
+    int       first;
+    int       i;
+
+    self->seed = self->seed * 1103515245u + 12345u;
+    first      = (int) ((self->seed >> 16) % (Uint32) parallel->count);
+
+    for (i = 0; i < parallel->count; ++i) {
+        ParallelWorker* victim = &parallel->workers[(first + i) % parallel->count];
+        ParallelTask*   task   = NULL;
+
+        if (victim == self) {
+            continue;
+        }
+
+        SDL_AtomicLock(&victim->lock);
+        if (victim->bottom != victim->top) {
+            task = victim->tasks[victim->top & PARALLEL_DEQUE_MASK];
+            ++victim->top;
+        }
+        SDL_AtomicUnlock(&victim->lock);
+
+        if (task) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * This function makes one attempt to steal a task, and runs it if there was one.
+ * The time the attempt took is counted as the cost of the steal, or as idle time if nothing was found.
+ *
+ * @param ParallelWorker* self - The thief.
+ */
+static void helpOut(ParallelWorker* self)
+{
+    Uint64        start = traceTicks();
+    ParallelTask* task  = stealTask(self);
+
+    if (!task) {
+	// Gives the core to a worker which has something to do, if the cores are shared.
+        ++self->failed_steals;
+        SDL_Delay(0);
+        self->idle_ticks += traceTicks() - start;
+        return;
+    }
+
+    self->steal_ticks += traceTicks() - start;
+    ++self->steals;
+    self->stolen = 1;
+    runTask(self, task);
+}
+
+
+/**
+ * This function waits until a task that the worker spawned has been run. If it is still in the deque,
+ * the worker runs it itself. Otherwise it was stolen, and the worker steals other tasks until the
+ * thief has finished it.
+ *
+ * @param ParallelWorker* self - The worker which spawned the task.
+ *
+ * @param ParallelTask* task - The task.
+ */
+static void syncTask(ParallelWorker* self, ParallelTask* task)
+{
+    int local = 0;
+
+    if (SDL_AtomicGet(&task->done)) {
+        SDL_MemoryBarrierAcquire();
+        return;
+    }
+
+    // Everything spawned after the task was synced already, so if it was not stolen, it is at the bottom.
+    SDL_AtomicLock(&self->lock);
+    if (self->bottom != self->top && self->tasks[(self->bottom - 1) & PARALLEL_DEQUE_MASK] == task) {
+        --self->bottom;
+        local = 1;
+    }
+    SDL_AtomicUnlock(&self->lock);
+
+    if (local) {
+        runTask(self, task);
+        return;
+    }
+
+    while (!SDL_AtomicGet(&task->done)) {
+        helpOut(self);
+    }
+    SDL_MemoryBarrierAcquire();
+}
+
+
+/**
+ * This function sets up a task of sorting array[low..high].
+ *
+ * @param ParallelTask* task - The task.
+ *
+ * @param int* array, int* scratch - The array, and the scratch array of mergesort.
+ *
+ * @param Sint64 low, Sint64 high - The range to sort.
+ */
+static void taskInit(ParallelTask* task, int* array, int* scratch, Sint64 low, Sint64 high)
+{
+    task->array   = array;
+    task->scratch = scratch;
+    task->low     = low;
+    task->high    = high;
+    SDL_AtomicSet(&task->done, 0);
+}
+
+
+/**
+ * The parallel versions of mergesort() and quicksort(). Each of them spawns the first half
+ * of its range as a task, sorts the second half itself, and syncs with the task,
+ * unless the range is shorter than PARALLEL_GRAIN elements.
+ *
+ * @param ParallelWorker* self - The worker running the call.
+ */
+static void parallelMergesort(ParallelWorker* self, int* array, int* scratch, Sint64 low, Sint64 high)
+{
+    PARALLEL_ENTER(self, FUNCTION_MERGESORT, low, high);
+
+    if (low < high) {
+        Sint64 middle = low + (high - low) / 2;
+
+        if (high - low + 1 >= PARALLEL_GRAIN) {
+            ParallelTask left;
+
+            taskInit(&left, array, scratch, low, middle);
+            spawnTask(self, &left);
+            parallelMergesort(self, array, scratch, middle + 1, high);
+            syncTask(self, &left);
+        } else {
+            parallelMergesort(self, array, scratch, low, middle);
+            parallelMergesort(self, array, scratch, middle + 1, high);
+        }
+        mergesortMerge(array, scratch, low, middle, high);
+    }
+
+    PARALLEL_EXIT(self, FUNCTION_MERGESORT, low, high);
+}
+
+
+static void parallelQuicksort(ParallelWorker* self, int* array, Sint64 low, Sint64 high)
+{
+    PARALLEL_ENTER(self, FUNCTION_QUICKSORT, low, high);
+
+    if (low < high) {
+        Sint64 store = quicksortPartition(array, low, high);
+
+        if (high - low + 1 >= PARALLEL_GRAIN) {
+            ParallelTask left;
+
+            taskInit(&left, array, NULL, low, store - 1);
+            spawnTask(self, &left);
+            parallelQuicksort(self, array, store + 1, high);
+            syncTask(self, &left);
+        } else {
+            parallelQuicksort(self, array, low, store - 1);
+            parallelQuicksort(self, array, store + 1, high);
+        }
+    }
+
+    PARALLEL_EXIT(self, FUNCTION_QUICKSORT, low, high);
+}
+
+
+/**
+ * This function runs a task on a worker, and marks it done. Once the whole array is sorted,
+ * it tells the workers to stop.
+ *
+ * @param ParallelWorker* self - The worker.
+ *
+ * @param ParallelTask* task - The task.
+ */
+static void runTask(ParallelWorker* self, ParallelTask* task)
+{
+    Parallel* parallel = self->parallel;
+    int       root     = (task == parallel->root);
+    Uint64    start    = traceTicks();
+
+    ++self->tasks_run;
+    if (parallel->function == FUNCTION_MERGESORT) {
+        parallelMergesort(self, task->array, task->scratch, task->low, task->high);
+    } else {
+        parallelQuicksort(self, task->array, task->low, task->high);
+    }
+
+    // The task is in the stack frame of the call which spawned it, and is gone as soon as it is done.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&task->done, 1);
+    if (root) {
+        parallel->sort_ticks = traceTicks() - start;
+        SDL_AtomicSet(&parallel->finished, 1);
+    }
+}
+
+
+/**
+ * This is the entry point of the thread of a worker, as required by SDL_CreateThread().
+ * The worker runs the tasks of its own deque, and steals from the others when it is empty,
+ * until the whole array is sorted.
+ *
+ * @param void* data - A pointer to the ParallelWorker.
+ *
+ * @return int - Always 0.
+ */
+static int workerThread(void* data)
+{
+    ParallelWorker* self     = (ParallelWorker*) data;
+    Parallel*       parallel = self->parallel;
+
+    self->start_ticks = traceTicks();
+    while (!SDL_AtomicGet(&parallel->finished)) {
+        ParallelTask* task = popTask(self);
+
+        if (task) {
+            runTask(self, task);
+        } else {
+            helpOut(self);
+        }
+    }
+    self->end_ticks = traceTicks();
+
+    return 0;
+}
+
+
+/**
+ * This function allocates the workers of a parallel run and their traces.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run, which is zeroed first.
+ *
+ * @param int function - FUNCTION_MERGESORT or FUNCTION_QUICKSORT.
+ *
+ * @param Sint64 n - The number of elements to sort.
+ *
+ * @param int workers - The number of workers.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int allocateWorkers(Parallel* parallel, int function, Sint64 n, int workers)
+{
+    int i;
+
+    memset(parallel, 0, sizeof(*parallel));
+    parallel->function = function;
+    parallel->n        = n;
+
+    parallel->workers = (ParallelWorker*) calloc(workers, sizeof(ParallelWorker));
+    if (!parallel->workers) {
+        return -1;
+    }
+    parallel->count = workers;
+
+    for (i = 0; i < workers; ++i) {
+        ParallelWorker* worker = &parallel->workers[i];
+
+        worker->parallel = parallel;
+        worker->id       = i;
+        worker->tracer   = (Tracer*) malloc(sizeof(Tracer));
+        if (!worker->tracer) {
+            return -1;
+        }
+        if (tracerInit(worker->tracer, PARALLEL_TRACE_CAPACITY, NULL) != 0) {
+            free(worker->tracer);
+            worker->tracer = NULL;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function sorts the pseudo-random numbers of exampleArray() once with all the workers,
+ * each of them tracing into its own buffer, which is emptied first.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run.
+ *
+ * @param size_t stack_size - The size of the runtime stack of every worker.
+ *
+ * @return int - 0 on success, -1 if the memory or the threads could not be had,
+ *               or records were dropped.
+ */
+static int runSort(Parallel* parallel, size_t stack_size)
+{
+    ParallelTask root;
+    int*         array   = exampleArray(parallel->n);
+    int*         scratch = (parallel->function == FUNCTION_MERGESORT) ? exampleArray(parallel->n) : NULL;
+    int          result  = 0;
+    int          i;
+
+    if (!array || (parallel->function == FUNCTION_MERGESORT && !scratch)) {
+        free(array);
+        free(scratch);
+        return -1;
+    }
+
+    for (i = 0; i < parallel->count; ++i) {
+        ParallelWorker* worker = &parallel->workers[i];
+
+        worker->top           = 0;
+        worker->bottom        = 0;
+        worker->lock          = 0;
+        worker->seed          = 2654435761u * (Uint32) (i + 1);
+        worker->stolen        = 0;
+        worker->tasks_run     = 0;
+        worker->steals        = 0;
+        worker->failed_steals = 0;
+        worker->steal_ticks   = 0;
+        worker->idle_ticks    = 0;
+        worker->tracer->count      = 0;
+        worker->tracer->dropped    = 0;
+        worker->tracer->depth      = 0;
+        worker->tracer->stack_base = 0;
+        worker->tracer->peak       = 0;
+    }
+
+    // The whole array is the first task, which the first worker finds in its deque.
+    taskInit(&root, array, scratch, 0, parallel->n - 1);
+    parallel->root                = &root;
+    parallel->sort_ticks          = 0;
+    parallel->workers[0].tasks[0] = &root;
+    parallel->workers[0].bottom   = 1;
+    SDL_AtomicSet(&parallel->finished, parallel->n <= 0);
+
+    for (i = 0; i < parallel->count; ++i) {
+        parallel->workers[i].thread = SDL_CreateThreadWithStackSize(workerThread, "worker", stack_size,
+                                                                    &parallel->workers[i]);
+        if (!parallel->workers[i].thread) {
+	    // The workers which did start are stopped, and nothing of the run counts.
+            SDL_AtomicSet(&parallel->finished, 1);
+            result = -1;
+            break;
+        }
+    }
+    for (i = 0; i < parallel->count; ++i) {
+        if (parallel->workers[i].thread) {
+            SDL_WaitThread(parallel->workers[i].thread, NULL);
+            parallel->workers[i].thread = NULL;
+        }
+        if (parallel->workers[i].tracer->dropped > 0) {
+            result = -1;
+        }
+    }
+    parallel->root = NULL;
+
+    free(array);
+    free(scratch);
+
+    return result;
+}
+
+
+/**
+ * This function merges the records of all the workers by their timestamps, into the order they are
+ * played back in, and makes a lane for every worker, as deep as its runtime stack got.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run, which has been run.
+ *
+ * @param int lane_height - The height of each lane, in pixels.
+ *
+ * @param size_t stack_size - The size of the runtime stack of every worker.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int mergeRecords(Parallel* parallel, int lane_height, size_t stack_size)
+{
+    Uint64 heads[PARALLEL_MAX_WORKERS];
+    Uint64 i;
+    int    w;
+
+    parallel->records = 0;
+    for (w = 0; w < parallel->count; ++w) {
+        const Tracer* tracer = parallel->workers[w].tracer;
+        Uint32        depth  = 1;
+
+        heads[w] = 0;
+        parallel->records += tracer->count;
+        for (i = 0; i < tracer->count; ++i) {
+            if (tracer->events[i].depth > depth) {
+                depth = tracer->events[i].depth;
+            }
+        }
+
+        if (stackViewInit(&parallel->workers[w].lane, parallel->lane_width, lane_height, depth) != 0) {
+            return -1;
+        }
+        parallel->workers[w].lane.stack_limit = stack_size;
+    }
+
+    parallel->order = (Uint8*) malloc(parallel->records > 0 ? parallel->records : 1);
+    if (!parallel->order) {
+        return -1;
+    }
+
+    // There are only a few workers, so the earliest of their next records is simply searched for.
+    // The records of each worker are in the order they were made in, so this is a k-way merge.
+    for (i = 0; i < parallel->records; ++i) {
+        int    earliest = -1;
+        Uint64 ticks    = 0;
+
+        for (w = 0; w < parallel->count; ++w) {
+            const Tracer* tracer = parallel->workers[w].tracer;
+
+            if (heads[w] < tracer->count && (earliest < 0 || tracer->events[heads[w]].ticks < ticks)) {
+                earliest = w;
+                ticks    = tracer->events[heads[w]].ticks;
+            }
+        }
+        parallel->order[i] = (Uint8) earliest;
+        ++heads[earliest];
+    }
+
+    return 0;
+}
+
+
+int parallelWorkerCount(int requested)
+{
+    int count = (requested > 0) ? requested : SDL_GetCPUCount();
+
+    if (count < 1) {
+        count = 1;
+    }
+    if (count > PARALLEL_MAX_WORKERS) {
+        count = PARALLEL_MAX_WORKERS;
+    }
+
+    return count;
+}
+
+
+int parallelLaneWidth(int workers)
+{
+    int width = PARALLEL_MAX_WIDTH / ((workers > 0) ? workers : 1);
+
+    return (width < PARALLEL_LANE_WIDTH) ? width : PARALLEL_LANE_WIDTH;
+}
+
+
+int parallelInit(Parallel* parallel, int function, Sint64 n, int workers, int lane_height, size_t stack_size)
+{
+    if (allocateWorkers(parallel, function, n, workers) != 0) {
+        return -1;
+    }
+    parallel->lane_width  = parallelLaneWidth(workers);
+    parallel->lane_height = lane_height;
+
+    if (runSort(parallel, stack_size) != 0) {
+        return -1;
+    }
+    parallel->ticks_per_ns = traceTicksPerSecond(parallel->workers[0].tracer) / 1e9;
+
+    return mergeRecords(parallel, lane_height, stack_size);
+}
+
+
+void parallelDestroy(Parallel* parallel)
+{
+    int i;
+
+    for (i = 0; i < parallel->count; ++i) {
+        ParallelWorker* worker = &parallel->workers[i];
+
+        if (worker->tracer) {
+            tracerDestroy(worker->tracer);
+            free(worker->tracer);
+            worker->tracer = NULL;
+        }
+        stackViewDestroy(&worker->lane);
+    }
+
+    free(parallel->workers);
+    parallel->workers = NULL;
+    parallel->count   = 0;
+    free(parallel->order);
+    parallel->order = NULL;
+}
+
+
+int parallelStep(Parallel* parallel, StackEvent* event)
+{
+    ParallelWorker* worker;
+    int             i;
+
+    if (parallel->step >= parallel->records) {
+        memset(event, 0, sizeof(*event));
+        event->type = EVENT_END;
+        for (i = 0; i < parallel->count; ++i) {
+            stackViewApply(&parallel->workers[i].lane, event);
+        }
+        return 1;
+    }
+
+    worker = &parallel->workers[parallel->order[parallel->step++]];
+    *event = worker->tracer->events[worker->next++];
+    if (event->type == EVENT_PUSH) {
+        ++worker->calls_played;
+        if (event->color == GOLD) {
+            ++worker->steals_played;
+        }
+    }
+
+    return (stackViewApply(&worker->lane, event) != 0) ? -1 : 1;
+}
+
+
+/**
+ * This function writes the counters of one worker on top of its lane.
+ *
+ * @param const Parallel* parallel - A pointer to the parallel run.
+ *
+ * @param const ParallelWorker* worker - The worker.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with.
+ */
+static void writeCounters(const Parallel* parallel, const ParallelWorker* worker, GlyphAtlas* atlas)
+{
+    int    x     = worker->id * parallel->lane_width + COUNTERS_MARGIN;
+    int    y     = COUNTERS_MARGIN;
+    Uint64 total = worker->end_ticks - worker->start_ticks;
+    char   text[64];
+
+    SDL_snprintf(text, sizeof(text), "worker %d", worker->id);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "calls %llu", (unsigned long long) worker->calls_played);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "steals %llu", (unsigned long long) worker->steals_played);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    // How the worker spent the whole run is known from the start.
+    SDL_snprintf(text, sizeof(text), "busy %.0f%%",
+                 (total > 0) ? 100.0 * (total - worker->steal_ticks - worker->idle_ticks) / total : 0.0);
+    glyphAtlasText(atlas, x, y, text);
+    y += GLYPH_HEIGHT;
+
+    SDL_snprintf(text, sizeof(text), "%.0f ns/steal",
+                 (worker->steals > 0) ? worker->steal_ticks / parallel->ticks_per_ns / worker->steals : 0.0);
+    glyphAtlasText(atlas, x, y, text);
+}
+
+
+void parallelDraw(Parallel* parallel, const StackView* viewport, SDL_Renderer* renderer,
+                  GlyphAtlas* atlas, int labels)
+{
+    SDL_Rect pane;
+    int      i;
+
+    pane.y = 0;
+    pane.w = parallel->lane_width;
+    pane.h = parallel->lane_height;
+
+    // Every lane is scrolled and zoomed along with the stack view, and drawn in full, into its own pane.
+    for (i = 0; i < parallel->count; ++i) {
+        StackView* lane = &parallel->workers[i].lane;
+
+        if (lane->bytes != viewport->bytes) {
+            stackViewShowBytes(lane, viewport->bytes);
+        }
+        lane->scroll       = viewport->scroll;
+        lane->fit          = viewport->fit;
+        lane->frame_height = viewport->frame_height;
+
+        pane.x = i * parallel->lane_width;
+        SDL_RenderSetViewport(renderer, &pane);
+        stackViewDraw(lane, renderer);
+        if (atlas && labels) {
+            stackViewDrawLabels(lane, renderer, atlas);
+        }
+    }
+    SDL_RenderSetViewport(renderer, NULL);
+
+    // A black line between every two lanes.
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    for (i = 1; i < parallel->count; ++i) {
+        SDL_RenderDrawLine(renderer, i * parallel->lane_width, 0, i * parallel->lane_width, parallel->lane_height - 1);
+    }
+
+    if (!atlas) {
+        return;
+    }
+
+    // The counters go on a black band across the top of every lane, in one batch.
+    pane.x = 0;
+    pane.w = parallel->count * parallel->lane_width;
+    pane.h = COUNTERS_HEIGHT;
+    SDL_RenderFillRect(renderer, &pane);
+    for (i = 0; i < parallel->count; ++i) {
+        writeCounters(parallel, &parallel->workers[i], atlas);
+    }
+    glyphAtlasFlush(atlas, renderer);
+}
+
+
+int parallelBenchmark(int function, Sint64 n, int workers, size_t stack_size, FILE* out)
+{
+    Parallel parallel;
+    double   single = 0.0;
+    int      count  = 1;
+
+    fprintf(out, "workers,calls,tasks,steals,failed_steals,nanoseconds,speedup,"
+                 "busy_min_percent,busy_max_percent,ns_per_steal\n");
+
+    for (;;) {
+        Uint64 best        = 0;
+        Uint64 calls       = 0;
+        Uint64 tasks       = 0;
+        Uint64 steals      = 0;
+        Uint64 failed      = 0;
+        Uint64 steal_ticks = 0;
+        double busy_min    = 0.0;
+        double busy_max    = 0.0;
+        double nanoseconds;
+        int    run;
+        int    i;
+
+        if (allocateWorkers(&parallel, function, n, count) != 0) {
+            parallelDestroy(&parallel);
+            return -1;
+        }
+
+        // The counters are the ones of the fastest run.
+        for (run = 0; run < PARALLEL_RUNS; ++run) {
+            if (runSort(&parallel, stack_size) != 0) {
+                parallelDestroy(&parallel);
+                return -1;
+            }
+            if (run > 0 && parallel.sort_ticks >= best) {
+                continue;
+            }
+
+            best        = parallel.sort_ticks;
+            calls       = 0;
+            tasks       = 0;
+            steals      = 0;
+            failed      = 0;
+            steal_ticks = 0;
+            busy_min    = 100.0;
+            busy_max    = 0.0;
+            for (i = 0; i < count; ++i) {
+                const ParallelWorker* worker = &parallel.workers[i];
+                Uint64                total  = worker->end_ticks - worker->start_ticks;
+                double                busy   = (total > 0) ?
+                                               100.0 * (total - worker->steal_ticks - worker->idle_ticks) / total : 0.0;
+
+                calls       += worker->tracer->count / 2;
+                tasks       += worker->tasks_run;
+                steals      += worker->steals;
+                failed      += worker->failed_steals;
+                steal_ticks += worker->steal_ticks;
+                busy_min     = SDL_min(busy_min, busy);
+                busy_max     = SDL_max(busy_max, busy);
+            }
+        }
+
+        parallel.ticks_per_ns = traceTicksPerSecond(parallel.workers[0].tracer) / 1e9;
+        nanoseconds = best / parallel.ticks_per_ns;
+        if (count == 1) {
+            single = nanoseconds;
+        }
+        fprintf(out, "%d,%llu,%llu,%llu,%llu,%.0f,%.2f,%.1f,%.1f,%.1f\n", count, (unsigned long long) calls,
+                (unsigned long long) tasks, (unsigned long long) steals, (unsigned long long) failed,
+                nanoseconds, (nanoseconds > 0.0) ? single / nanoseconds : 0.0, busy_min, busy_max,
+                (steals > 0) ? steal_ticks / parallel.ticks_per_ns / steals : 0.0);
+        parallelDestroy(&parallel);
+
+        // 1, 2, 4 and so on, and then the number of workers asked for, if it is not a power of 2.
+        if (count >= workers) {
+            break;
+        }
+        count = (count * 2 < workers) ? count * 2 : workers;
+    }
+
+    return 0;
+}
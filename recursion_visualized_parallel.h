@@ -0,0 +1,350 @@
+/**
+ * @file    recursion_visualized_parallel.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the parallel mode, which runs a divide-and-conquer
+ * example, mergesort or quicksort, on every core at once, and shows the runtime stack of
+ * every worker thread in a lane of its own.
+ *
+ * The workers share the calls with a work-stealing scheduler. Every worker has a deque of tasks.
+ * A call which splits its range in two spawns the first half as a task, pushing it onto the bottom
+ * of the deque of its worker, works on the second half itself, and then syncs with the task.
+ * If the task is still in the deque, the worker pops it back off and runs it as a plain call.
+ * A worker without anything to do steals the oldest task from the top of the deque of another
+ * worker, chosen at random, which is the biggest piece of work there. A worker which syncs with a
+ * task that was stolen helps out by stealing other tasks until the thief has finished, so the
+ * stolen calls pile up on its runtime stack, on top of the call waiting for them.
+ * Ranges shorter than PARALLEL_GRAIN elements are not worth a task, and are recursed into directly.
+ * Each deque is guarded by a spinlock, which the owner only contends for with thieves.
+ *
+ * Every call is traced, like the examples are, but into a buffer of its worker, which grows as
+ * needed, so the workers never touch each other's records. When the sort has finished, the records
+ * of all the workers are merged by their timestamps, the time stamp counter of the CPU, which is
+ * the same on every core. The animation plays the merged records back, each one into the lane of
+ * its worker. The first call of a task that was stolen is drawn in GOLD instead of LIME.
+ * On top of each lane are the counters of its worker: the calls and the steals played back so far,
+ * how much of the run the worker was busy, and what a steal cost it on average.
+ *
+ * In the headless mode, the sort is only run and timed, with 1, 2, 4 and so on up to every worker,
+ * and the costs are written to stdout as CSV:
+ *   workers,calls,tasks,steals,failed_steals,nanoseconds,speedup,busy_min_percent,busy_max_percent,ns_per_steal
+ * speedup is against the run with 1 worker, and the busy percentages are of the least and of
+ * the most busy worker, which tell how evenly the work was balanced.
+ */
+
+#ifndef RECURSION_VISUALIZED_PARALLEL_H
+#define RECURSION_VISUALIZED_PARALLEL_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"       // StackEvent
+#include "recursion_visualized_stackview.h"  // StackView
+#include "recursion_visualized_font.h"       // GlyphAtlas
+
+/* The Visualizer has a Parallel, and recursion_visualized_trace.h includes the header of the
+   Visualizer, so the Tracer can only be defined after it, and each worker only points to its own. */
+struct Tracer;
+
+/* The most workers a parallel run can have. */
+#define PARALLEL_MAX_WORKERS 64
+
+/* The most tasks a deque can hold. It must be a power of two. When it is full,
+   a task is run right away instead of being spawned. */
+#define PARALLEL_DEQUE_CAPACITY 1024
+#define PARALLEL_DEQUE_MASK     (PARALLEL_DEQUE_CAPACITY - 1)
+
+/* The shortest range of elements that a call spawns a task for. */
+#define PARALLEL_GRAIN 16
+
+/* How many records each worker makes room for at first. Its buffer doubles whenever it is full. */
+#define PARALLEL_TRACE_CAPACITY 4096
+
+/* The widest lane, and the widest the lanes of all the workers can be together, in pixels. */
+#define PARALLEL_LANE_WIDTH 150
+#define PARALLEL_MAX_WIDTH  1200
+
+/* How many times the sort is run with each number of workers in the headless mode. The fastest run counts. */
+#define PARALLEL_RUNS 3
+
+
+/**
+ * A piece of work of a parallel sort: sorting array[low..high].
+ * It is kept in the stack frame of the call which spawned it, until that call syncs with it.
+ *
+ * @field int* array, scratch - The array to sort, and the scratch array of mergesort.
+ *
+ * @field Sint64 low, high - The first and the last index of the range to sort.
+ *
+ * @field SDL_atomic_t done - Set once the task has been run.
+ */
+typedef struct ParallelTask {
+    int*         array;
+    int*         scratch;
+    Sint64       low;
+    Sint64       high;
+    SDL_atomic_t done;
+} ParallelTask;
+
+
+/**
+ * One worker thread of a parallel run, its deque, its trace and its counters,
+ * and its lane of the animation.
+ *
+ * @field ParallelTask* tasks[PARALLEL_DEQUE_CAPACITY] - The deque. Its owner pushes and pops at
+ *                  the bottom, and thieves steal from the top. The indices only ever grow,
+ *                  and are wrapped with PARALLEL_DEQUE_MASK on access.
+ *
+ * @field Uint32 top, bottom - The deque holds the tasks with indices in [top, bottom).
+ *
+ * @field SDL_SpinLock lock - Guards the deque.
+ *
+ * @field struct Parallel* parallel - The run the worker belongs to.
+ *
+ * @field int id - The index of the worker, from 0.
+ *
+ * @field Uint32 seed - The state of the random numbers the victims of steals are picked with.
+ *
+ * @field int stolen - Nonzero if the next call is the first one of a stolen task.
+ *
+ * @field SDL_Thread* thread - The thread of the worker while it runs.
+ *
+ * @field struct Tracer* tracer - The trace of the calls the worker made.
+ *
+ * @field Uint64 tasks_run, steals, failed_steals - How many tasks the worker ran, how many of them
+ *                  it stole, and how many times it found nothing to steal.
+ *
+ * @field Uint64 start_ticks, end_ticks - When the worker began and finished, in the ticks of traceTicks().
+ *
+ * @field Uint64 steal_ticks, idle_ticks - How long the worker spent on stealing tasks, and on looking
+ *                  for tasks without finding any. The rest of the time, it was busy.
+ *
+ * @field StackView lane - The runtime stack of the worker, as far as it was played back.
+ *
+ * @field Uint64 next - The index of the next record of the worker to play back.
+ *
+ * @field Uint64 calls_played, steals_played - The calls and the steals played back so far.
+ */
+typedef struct ParallelWorker {
+    ParallelTask*    tasks[PARALLEL_DEQUE_CAPACITY];
+    Uint32           top;
+    Uint32           bottom;
+    SDL_SpinLock     lock;
+    struct Parallel* parallel;
+    int              id;
+    Uint32           seed;
+    int              stolen;
+    SDL_Thread*      thread;
+    struct Tracer*   tracer;
+    Uint64           tasks_run;
+    Uint64           steals;
+    Uint64           failed_steals;
+    Uint64           start_ticks;
+    Uint64           end_ticks;
+    Uint64           steal_ticks;
+    Uint64           idle_ticks;
+    StackView        lane;
+    Uint64           next;
+    Uint64           calls_played;
+    Uint64           steals_played;
+} ParallelWorker;
+
+
+/**
+ * A parallel run of a divide-and-conquer example, and its animation.
+ *
+ * @field ParallelWorker* workers - The workers.
+ *
+ * @field int count - The number of workers.
+ *
+ * @field int function - FUNCTION_MERGESORT or FUNCTION_QUICKSORT.
+ *
+ * @field Sint64 n - The number of elements to sort.
+ *
+ * @field ParallelTask* root - The task of sorting the whole array, while the sort runs.
+ *
+ * @field SDL_atomic_t finished - Set once the whole array is sorted, which stops the workers.
+ *
+ * @field Uint64 sort_ticks - How long the whole array took to sort, in the ticks of traceTicks().
+ *
+ * @field double ticks_per_ns - The rate of traceTicks(), in ticks per nanosecond.
+ *
+ * @field Uint8* order - order[i] is the worker of the i-th record, when the records of all
+ *                       the workers are merged by their timestamps.
+ *
+ * @field Uint64 records, step - The number of records, and how many of them were played back.
+ *
+ * @field int lane_width, lane_height - The size of each lane in pixels.
+ *                                      The lanes are side by side, in the order of the workers.
+ */
+typedef struct Parallel {
+    ParallelWorker* workers;
+    int             count;
+    int             function;
+    Sint64          n;
+    ParallelTask*   root;
+    SDL_atomic_t    finished;
+    Uint64          sort_ticks;
+    double          ticks_per_ns;
+    Uint8*          order;
+    Uint64          records;
+    Uint64          step;
+    int             lane_width;
+    int             lane_height;
+} Parallel;
+
+
+/**
+ * This function tells how many workers a parallel run gets.
+ *
+ * @param int requested - The number of workers asked for, or 0 for one per core.
+ *
+ * @return int - The number of workers, from 1 to PARALLEL_MAX_WORKERS.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int parallelWorkerCount(int requested);
+
+
+/**
+ * This function tells how wide the lane of each worker is, so that all of them fit side by side
+ * into PARALLEL_MAX_WIDTH pixels.
+ *
+ * @param int workers - The number of workers.
+ *
+ * @return int - The width of a lane in pixels.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int parallelLaneWidth(int workers);
+
+
+/**
+ * This function sorts the pseudo-random numbers of exampleArray() with the workers, tracing every call,
+ * and then merges the records of all the workers by their timestamps, for the animation.
+ * It returns once the sort has finished.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run to initialize.
+ *
+ * @param int function - FUNCTION_MERGESORT or FUNCTION_QUICKSORT.
+ *
+ * @param Sint64 n - The number of elements to sort.
+ *
+ * @param int workers - The number of workers, as given by parallelWorkerCount().
+ *
+ * @param int lane_height - The height of each lane, in pixels. Its width is given by parallelLaneWidth().
+ *
+ * @param size_t stack_size - The size of the runtime stack of every worker.
+ *
+ * @return int - 0 on success, -1 if the memory or the threads could not be had,
+ *               or the records did not fit into memory.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int parallelInit(Parallel* parallel, int function, Sint64 n, int workers, int lane_height, size_t stack_size);
+
+
+/**
+ * This function deallocates the parallel run: the records and the lanes of all the workers.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void parallelDestroy(Parallel* parallel);
+
+
+/**
+ * This function plays back the next record of the parallel run, in the order of the timestamps,
+ * into the lane of the worker that made it, and counts it. After the last record, it hands out
+ * an EVENT_END record, which empties every lane.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run.
+ *
+ * @param StackEvent* event - Receives a copy of the record.
+ *
+ * @return int - 1 if a record was played back, -1 if a lane could not be grown.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int parallelStep(Parallel* parallel, StackEvent* event);
+
+
+/**
+ * This function draws the lanes of all the workers side by side, with the same viewport as
+ * the given stack view, and the counters of each worker on top of its lane.
+ * It does not clear the background and does not present.
+ *
+ * @param Parallel* parallel - A pointer to the parallel run.
+ *
+ * @param const StackView* viewport - The stack view whose scrolling and zooming the lanes follow.
+ *
+ * @param SDL_Renderer* renderer - The renderer.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas to write with, or NULL to leave out the counters and the labels.
+ *
+ * @param int labels - Nonzero to label the stack frames.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void parallelDraw(Parallel* parallel, const StackView* viewport, SDL_Renderer* renderer,
+                  GlyphAtlas* atlas, int labels);
+
+
+/**
+ * This function times the parallel sort with 1, 2, 4 and so on up to the given number of workers,
+ * and writes the costs as CSV, with a header line.
+ *
+ * @param int function - FUNCTION_MERGESORT or FUNCTION_QUICKSORT.
+ *
+ * @param Sint64 n - The number of elements to sort.
+ *
+ * @param int workers - The most workers to time it with.
+ *
+ * @param size_t stack_size - The size of the runtime stack of every worker.
+ *
+ * @param FILE* out - Where to write the CSV.
+ *
+ * @return int - 0 on success, -1 if a run could not be made.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int parallelBenchmark(int function, Sint64 n, int workers, size_t stack_size, FILE* out);
+
+#endif /* RECURSION_VISUALIZED_PARALLEL_H */
@@ -0,0 +1,318 @@
+/**
+ * @file    recursion_visualized_raster.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the span-fill kernels, and the definitions of the software rasterizer functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), free()
+#include <string.h>  // C strings - for memcpy()
+
+#include "recursion_visualized_raster.h"
+
+/* The SIMD kernels are compiled for their own instruction sets with the target attribute,
+   whatever the rest of the program is compiled for, so they can be picked at runtime. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RASTER_SIMD 1
+#include <immintrin.h>  // x86 intrinsics - for __m128i, __m256i, _mm_store_si128(), _mm256_store_si256()
+#endif
+
+
+static const char* KERNEL_NAMES[RASTER_KERNEL_COUNT] = { "scalar", "sse2", "avx2" };
+
+
+/**
+ * This function is the plain C span-fill kernel, which every CPU can run.
+ *
+ * @param Uint32* span - The first pixel of the span.
+ *
+ * @param int count - The number of pixels in the span.
+ *
+ * @param Uint32 color - The pixel to fill the span with.
+ */
+static void fillSpanScalar(Uint32* span, int count, Uint32 color)
+{
+    while (count-- > 0) {
+        *span++ = color;
+    }
+}
+
+
+#ifdef RASTER_SIMD
+/**
+ * This function is the SSE2 span-fill kernel, which stores 4 pixels at a time.
+ *
+ * @param Uint32* span - The first pixel of the span.
+ *
+ * @param int count - The number of pixels in the span.
+ *
+ * @param Uint32 color - The pixel to fill the span with.
+ */
+__attribute__((target("sse2")))
+static void fillSpanSse2(Uint32* span, int count, Uint32 color)
+{
+    __m128i wide = _mm_set1_epi32((int) color);
+
+    // The pixels up to the first 16-byte boundary are stored one at a time,
+    // so that the stores in between are aligned.
+    while (count > 0 && ((size_t) span & 15) != 0) {
+        *span++ = color;
+        --count;
+    }
+
+    // The bulk of the span, 16 pixels per iteration.
+    for (; count >= 16; count -= 16, span += 16) {
+        _mm_store_si128((__m128i*) span, wide);
+        _mm_store_si128((__m128i*) (span + 4), wide);
+        _mm_store_si128((__m128i*) (span + 8), wide);
+        _mm_store_si128((__m128i*) (span + 12), wide);
+    }
+    for (; count >= 4; count -= 4, span += 4) {
+        _mm_store_si128((__m128i*) span, wide);
+    }
+
+    // The leftover pixels at the end of the span.
+    while (count-- > 0) {
+        *span++ = color;
+    }
+}
+
+
+/**
+ * This function is the AVX2 span-fill kernel, which stores 8 pixels at a time.
+ *
+ * @param Uint32* span - The first pixel of the span.
+ *
+ * @param int count - The number of pixels in the span.
+ *
+ * @param Uint32 color - The pixel to fill the span with.
+ */
+__attribute__((target("avx2")))
+static void fillSpanAvx2(Uint32* span, int count, Uint32 color)
+{
+    __m256i wide = _mm256_set1_epi32((int) color);
+
+    // The pixels up to the first 32-byte boundary are stored one at a time,
+    // so that the stores in between are aligned.
+    while (count > 0 && ((size_t) span & 31) != 0) {
+        *span++ = color;
+        --count;
+    }
+
+    // The bulk of the span, 32 pixels per iteration.
+    for (; count >= 32; count -= 32, span += 32) {
+        _mm256_store_si256((__m256i*) span, wide);
+        _mm256_store_si256((__m256i*) (span + 8), wide);
+        _mm256_store_si256((__m256i*) (span + 16), wide);
+        _mm256_store_si256((__m256i*) (span + 24), wide);
+    }
+    for (; count >= 8; count -= 8, span += 8) {
+        _mm256_store_si256((__m256i*) span, wide);
+    }
+
+    // The leftover pixels at the end of the span.
+    while (count-- > 0) {
+        *span++ = color;
+    }
+}
+#endif /* RASTER_SIMD */
+
+
+int rasterKernelSupported(int kernel)
+{
+    switch (kernel) {
+    case RASTER_KERNEL_SCALAR:
+        return 1;
+#ifdef RASTER_SIMD
+    case RASTER_KERNEL_SSE2:
+        return SDL_HasSSE2();
+    case RASTER_KERNEL_AVX2:
+        return SDL_HasAVX2();
+#endif
+    default:
+        return 0;
+    }
+}
+
+
+int rasterBestKernel(void)
+{
+    if (rasterKernelSupported(RASTER_KERNEL_AVX2)) {
+        return RASTER_KERNEL_AVX2;
+    }
+    if (rasterKernelSupported(RASTER_KERNEL_SSE2)) {
+        return RASTER_KERNEL_SSE2;
+    }
+
+    return RASTER_KERNEL_SCALAR;
+}
+
+
+const char* rasterKernelName(int kernel)
+{
+    return (kernel >= 0 && kernel < RASTER_KERNEL_COUNT) ? KERNEL_NAMES[kernel] : "unknown";
+}
+
+
+int rasterWrap(Raster* raster, void* pixels, int pitch, int width, int height, int kernel)
+{
+    if (kernel == RASTER_KERNEL_AUTO) {
+        kernel = rasterBestKernel();
+    }
+    if (!rasterKernelSupported(kernel)) {
+        return -1;
+    }
+
+    raster->pixels = (Uint32*) pixels;
+    raster->pitch  = pitch / (int) sizeof(Uint32);
+    raster->width  = width;
+    raster->height = height;
+    raster->color  = 0xFF000000;
+    raster->kernel = kernel;
+    raster->owned  = 0;
+
+    switch (kernel) {
+#ifdef RASTER_SIMD
+    case RASTER_KERNEL_AVX2:
+        raster->fill_span = fillSpanAvx2;
+        break;
+    case RASTER_KERNEL_SSE2:
+        raster->fill_span = fillSpanSse2;
+        break;
+#endif
+    default:
+        raster->fill_span = fillSpanScalar;
+        break;
+    }
+
+    return 0;
+}
+
+
+int rasterInit(Raster* raster, int width, int height, int kernel)
+{
+    // The rows are padded to a multiple of 8 pixels, so every one of them starts 32-byte aligned
+    // when the first one does, and the kernels never have to fall back to single pixels at the start.
+    int     pitch  = (width + 7) & ~7;
+    Uint32* pixels = (Uint32*) SDL_SIMDAlloc((size_t) pitch * height * sizeof(Uint32));
+
+    if (!pixels) {
+        return -1;
+    }
+    if (rasterWrap(raster, pixels, pitch * (int) sizeof(Uint32), width, height, kernel) != 0) {
+        SDL_SIMDFree(pixels);
+        return -1;
+    }
+    raster->owned = 1;
+
+    return 0;
+}
+
+
+void rasterDestroy(Raster* raster)
+{
+    if (raster->owned) {
+        SDL_SIMDFree(raster->pixels);
+    }
+    raster->pixels = NULL;
+    raster->owned  = 0;
+}
+
+
+void rasterSetColor(Raster* raster, Uint8 r, Uint8 g, Uint8 b)
+{
+    raster->color = 0xFF000000 | ((Uint32) r << 16) | ((Uint32) g << 8) | (Uint32) b;
+}
+
+
+void rasterClear(Raster* raster)
+{
+    int y;
+
+    // Without padding between the rows, the whole framebuffer is a single span.
+    if (raster->pitch == raster->width) {
+        raster->fill_span(raster->pixels, raster->width * raster->height, raster->color);
+        return;
+    }
+
+    for (y = 0; y < raster->height; ++y) {
+        raster->fill_span(raster->pixels + (size_t) y * raster->pitch, raster->width, raster->color);
+    }
+}
+
+
+void rasterFillRects(Raster* raster, const SDL_Rect* rects, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        int     left   = (rects[i].x > 0) ? rects[i].x : 0;
+        int     top    = (rects[i].y > 0) ? rects[i].y : 0;
+        int     right  = rects[i].x + rects[i].w;
+        int     bottom = rects[i].y + rects[i].h;
+        Uint32* row;
+
+	// The box is clipped to the framebuffer, and then filled one row at a time.
+        if (right > raster->width) {
+            right = raster->width;
+        }
+        if (bottom > raster->height) {
+            bottom = raster->height;
+        }
+        if (left >= right || top >= bottom) {
+            continue;
+        }
+
+        row = raster->pixels + (size_t) top * raster->pitch + left;
+        for (; top < bottom; ++top, row += raster->pitch) {
+            raster->fill_span(row, right - left, raster->color);
+        }
+    }
+}
+
+
+void rasterDrawRect(Raster* raster, const SDL_Rect* rect)
+{
+    SDL_Rect edges[4];
+
+    if (rect->w <= 0 || rect->h <= 0) {
+        return;
+    }
+
+    // The top and bottom edges, and the left and right ones between them.
+    edges[0].x = rect->x;
+    edges[0].y = rect->y;
+    edges[0].w = rect->w;
+    edges[0].h = 1;
+    edges[1]   = edges[0];
+    edges[1].y = rect->y + rect->h - 1;
+    edges[2].x = rect->x;
+    edges[2].y = rect->y + 1;
+    edges[2].w = 1;
+    edges[2].h = rect->h - 2;
+    edges[3]   = edges[2];
+    edges[3].x = rect->x + rect->w - 1;
+
+    rasterFillRects(raster, edges, (rect->h > 2) ? 4 : 2);
+}
+
+
+void rasterCopy(Raster* target, const Raster* source)
+{
+    int width  = (target->width < source->width) ? target->width : source->width;
+    int height = (target->height < source->height) ? target->height : source->height;
+    int y;
+
+    for (y = 0; y < height; ++y) {
+        memcpy(target->pixels + (size_t) y * target->pitch, source->pixels + (size_t) y * source->pitch,
+               (size_t) width * sizeof(Uint32));
+    }
+}
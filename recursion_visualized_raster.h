@@ -0,0 +1,267 @@
+/**
+ * @file    recursion_visualized_raster.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the software rasterizer, a render backend next to the
+ * SDL_Renderer, which draws straight into a plain framebuffer of 32-bit ARGB8888 pixels in main memory.
+ *
+ * Everything the stack view draws is a filled box of one color, so the rasterizer only has to fill
+ * rows of pixels with one value: a span. Each box is clipped to the framebuffer, and then filled one
+ * span per row by a span-fill kernel. The kernels store 8 pixels at a time with AVX2, 4 pixels at a
+ * time with SSE2, or one at a time in plain C, and the fastest one the CPU can run is picked when
+ * the program starts, with SDL_HasAVX2() and SDL_HasSSE2(). Unlike SDL's software renderer, there is
+ * no draw call to go through, no command queue and no blending, so a frame costs little more than
+ * writing its pixels once.
+ *
+ * The SIMD kernels are only built with GCC and Clang on x86, where they can be compiled for a CPU
+ * other than the one the rest of the program is compiled for. Elsewhere only the plain C one is.
+ *
+ * The pixels are laid out like the ones of an SDL_Surface, so a raster can draw into the pixels
+ * of one, or into memory of its own.
+ */
+
+#ifndef RECURSION_VISUALIZED_RASTER_H
+#define RECURSION_VISUALIZED_RASTER_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+
+/* The span-fill kernels. RASTER_KERNEL_AUTO picks the fastest one the CPU can run. */
+#define RASTER_KERNEL_AUTO   (-1)
+#define RASTER_KERNEL_SCALAR 0
+#define RASTER_KERNEL_SSE2   1
+#define RASTER_KERNEL_AVX2   2
+#define RASTER_KERNEL_COUNT  3
+
+
+/**
+ * A span-fill kernel: it sets count pixels, starting at span, to color.
+ */
+typedef void (*RasterSpanFunction)(Uint32* span, int count, Uint32 color);
+
+
+/**
+ * A framebuffer of ARGB8888 pixels, and the state of drawing into it.
+ *
+ * @field Uint32* pixels - The top left pixel.
+ *
+ * @field int pitch - How many pixels one row takes in memory, at least width.
+ *
+ * @field int width, height - The size of the framebuffer in pixels.
+ *
+ * @field Uint32 color - The ARGB8888 pixel that boxes are filled with.
+ *
+ * @field int kernel - The RASTER_KERNEL_* constant of the span-fill kernel.
+ *
+ * @field RasterSpanFunction fill_span - The span-fill kernel.
+ *
+ * @field int owned - Nonzero if the raster allocated the pixels, and frees them.
+ */
+typedef struct Raster {
+    Uint32*            pixels;
+    int                pitch;
+    int                width;
+    int                height;
+    Uint32             color;
+    int                kernel;
+    RasterSpanFunction fill_span;
+    int                owned;
+} Raster;
+
+
+/**
+ * This function finds the fastest span-fill kernel the CPU can run.
+ *
+ * @return int - The RASTER_KERNEL_* constant of the kernel.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int rasterBestKernel(void);
+
+
+/**
+ * This function tells whether a span-fill kernel was built into the program, and the CPU can run it.
+ *
+ * @param int kernel - The RASTER_KERNEL_* constant of the kernel.
+ *
+ * @return int - Nonzero if the kernel can be used.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int rasterKernelSupported(int kernel);
+
+
+/**
+ * This function gives the name of a span-fill kernel: "scalar", "sse2" or "avx2".
+ *
+ * @param int kernel - The RASTER_KERNEL_* constant of the kernel.
+ *
+ * @return const char* - The name.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+const char* rasterKernelName(int kernel);
+
+
+/**
+ * This function sets up a raster with a framebuffer of its own, which is not cleared.
+ *
+ * @param Raster* raster - A pointer to the raster to initialize.
+ *
+ * @param int width, height - The size of the framebuffer in pixels.
+ *
+ * @param int kernel - The RASTER_KERNEL_* constant of the span-fill kernel, or RASTER_KERNEL_AUTO.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated or the kernel cannot be used.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int rasterInit(Raster* raster, int width, int height, int kernel);
+
+
+/**
+ * This function sets up a raster which draws into pixels owned by someone else,
+ * such as the pixels of an ARGB8888 SDL_Surface which does not need locking.
+ *
+ * @param Raster* raster - A pointer to the raster to initialize.
+ *
+ * @param void* pixels - The top left pixel.
+ *
+ * @param int pitch - How many bytes one row takes in memory, a multiple of 4.
+ *
+ * @param int width, height - The size of the framebuffer in pixels.
+ *
+ * @param int kernel - The RASTER_KERNEL_* constant of the span-fill kernel, or RASTER_KERNEL_AUTO.
+ *
+ * @return int - 0 on success, -1 if the kernel cannot be used.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int rasterWrap(Raster* raster, void* pixels, int pitch, int width, int height, int kernel);
+
+
+/**
+ * This function deallocates the framebuffer of a raster, if the raster allocated it.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterDestroy(Raster* raster);
+
+
+/**
+ * This function sets the opaque color that the next boxes are filled with,
+ * like SDL_SetRenderDrawColor() does for a renderer.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * @param Uint8 r, g, b - The color.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterSetColor(Raster* raster, Uint8 r, Uint8 g, Uint8 b);
+
+
+/**
+ * This function fills the whole framebuffer with the color, like SDL_RenderClear() does.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterClear(Raster* raster);
+
+
+/**
+ * This function fills boxes with the color, like SDL_RenderFillRects() does.
+ * The parts of the boxes outside of the framebuffer are left out.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * @param const SDL_Rect* rects - The boxes.
+ *
+ * @param int count - The number of boxes.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterFillRects(Raster* raster, const SDL_Rect* rects, int count);
+
+
+/**
+ * This function draws the 1 pixel wide outline of a box with the color, like SDL_RenderDrawRect() does.
+ *
+ * @param Raster* raster - A pointer to the raster.
+ *
+ * @param const SDL_Rect* rect - The box.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterDrawRect(Raster* raster, const SDL_Rect* rect);
+
+
+/**
+ * This function copies the pixels of one raster into another one, with their top left corners
+ * on top of each other, like SDL_RenderCopy() does for a backbuffer as large as the window.
+ * Only the part which both of them have is copied.
+ *
+ * @param Raster* target - A pointer to the raster to copy into.
+ *
+ * @param const Raster* source - A pointer to the raster to copy from.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void rasterCopy(Raster* target, const Raster* source);
+
+#endif /* RECURSION_VISUALIZED_RASTER_H */
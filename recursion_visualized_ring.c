@@ -0,0 +1,84 @@
+/**
+ * @file    recursion_visualized_ring.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the lock-free ring buffer functions.
+ */
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_ring.h"
+
+
+void ringInit(EventRing* ring)
+{
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    ring->cached_tail = 0;
+    ring->cached_head = 0;
+    ring->coroutine   = NULL;
+}
+
+
+void ringPush(EventRing* ring, const StackEvent* event)
+{
+    // Only the producer writes head, so it can read its own index without a barrier.
+    Uint32 head = (Uint32) SDL_AtomicGet(&ring->head);
+
+    // The ring looks full, so refresh the cached tail from the consumer.
+    // If it is really full, wait for the consumer to free up a slot.
+    while (head - ring->cached_tail == EVENT_RING_CAPACITY) {
+        ring->cached_tail = (Uint32) SDL_AtomicGet(&ring->tail);
+        if (head - ring->cached_tail == EVENT_RING_CAPACITY) {
+            SDL_Delay(1);
+        }
+    }
+
+    ring->events[head & EVENT_RING_MASK] = *event;
+
+    // The record must be fully written before the consumer is allowed to see it.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->head, (int) (head + 1));
+
+    // A coroutine hands every record over right away, so the ring never fills up.
+    if (ring->coroutine) {
+        coroutineYield(ring->coroutine);
+    }
+}
+
+
+int ringPop(EventRing* ring, StackEvent* event)
+{
+    // Only the consumer writes tail, so it can read its own index without a barrier.
+    Uint32 tail = (Uint32) SDL_AtomicGet(&ring->tail);
+
+    // The ring looks empty, so refresh the cached head from the producer.
+    // A coroutine producer is run until it has made the next record.
+    if (tail == ring->cached_head) {
+        ring->cached_head = (Uint32) SDL_AtomicGet(&ring->head);
+        if (tail == ring->cached_head && ring->coroutine) {
+            coroutineResume(ring->coroutine);
+            ring->cached_head = (Uint32) SDL_AtomicGet(&ring->head);
+        }
+        if (tail == ring->cached_head) {
+            return 0;
+        }
+    }
+
+    // The record must not be read before the producer has published it.
+    SDL_MemoryBarrierAcquire();
+    *event = ring->events[tail & EVENT_RING_MASK];
+
+    // The slot must be fully read before the producer is allowed to reuse it.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->tail, (int) (tail + 1));
+
+    return 1;
+}
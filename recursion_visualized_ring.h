@@ -0,0 +1,177 @@
+/**
+ * @file    recursion_visualized_ring.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the stack event record and the lock-free
+ * ring buffer which carries those records from the recursion thread to the render loop.
+ *
+ * The recursive function runs on its own thread and is the only producer.
+ * The render loop in main() runs on the main thread and is the only consumer.
+ * Because there is exactly one producer and one consumer, no locks are needed:
+ * each side only ever writes its own index, and reads the other side's index.
+ *
+ * The recursive function can also run as a coroutine on the main thread instead,
+ * see recursion_visualized_coroutine.h. Then the producer yields after every record,
+ * and the consumer resumes it whenever the ring buffer is empty, so the render loop
+ * steps the recursion one record at a time.
+ */
+
+#ifndef RECURSION_VISUALIZED_RING_H
+#define RECURSION_VISUALIZED_RING_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_coroutine.h"  // Coroutine
+
+
+/* These constants define the kinds of records that travel through the ring buffer. */
+#define EVENT_PUSH 0x01  // a stack frame was pushed onto the runtime stack
+#define EVENT_POP  0x02  // a stack frame is about to be popped off the runtime stack
+#define EVENT_END  0x03  // the recursion has finished, no more records will follow
+
+/* The number of records the ring buffer can hold. It must be a power of two,
+   so that the indices can be wrapped around with a cheap bitwise AND. */
+#define EVENT_RING_CAPACITY 4096
+#define EVENT_RING_MASK     (EVENT_RING_CAPACITY - 1)
+
+/* The number of arguments of the recursive function that a record can carry. */
+#define STACK_EVENT_ARGS 3
+
+/* The size of a cache line, used to keep the producer's and the consumer's
+   indices apart so the two threads do not keep invalidating each other's cache. */
+#define CACHE_LINE_SIZE 64
+
+
+/**
+ * One compact push/pop record emitted by the recursive function.
+ * The fields are ordered from the largest to the smallest, so the record has no padding.
+ *
+ * @field Uint64 ticks - When the record was made, in the ticks of traceTicks().
+ *
+ * @field Uint64 address - The address of the stack frame of the call on the runtime stack,
+ *                         as given by traceFrameAddress().
+ *
+ * @field Uint64 stack - How many bytes of the runtime stack are in use, from where the recursion
+ *                       started up to and including the stack frame of the call. The size of
+ *                       the frame itself is the difference from the frame below it.
+ *
+ * @field Sint64 args[STACK_EVENT_ARGS] - The arguments of the recursive function call.
+ *                                         Unused arguments are 0.
+ *
+ * @field SDL_Rect rect - The graphical representation of the stack frame at this moment.
+ *
+ * @field Uint32 depth - How many stack frames of the recursive function are on the
+ *                       runtime stack, counting this one. The first call has depth 1.
+ *
+ * @field Uint16 function - Which recursive function made the record, see recursion_visualized_trace.h.
+ *
+ * @field Uint8 type - EVENT_PUSH, EVENT_POP or EVENT_END.
+ *
+ * @field Uint8 color - The color code to draw the stack frame in, LIME or PINK, or GOLD for
+ *                      the first call of a task that a worker of a parallel run stole,
+ *                      or CYAN for both records of a call answered from the memoization cache.
+ */
+typedef struct StackEvent {
+    Uint64   ticks;
+    Uint64   address;
+    Uint64   stack;
+    Sint64   args[STACK_EVENT_ARGS];
+    SDL_Rect rect;
+    Uint32   depth;
+    Uint16   function;
+    Uint8    type;
+    Uint8    color;
+} StackEvent;
+
+
+/**
+ * A single-producer/single-consumer lock-free ring buffer of StackEvent records.
+ *
+ * head is the index of the next slot the producer is going to write.
+ * tail is the index of the next slot the consumer is going to read.
+ * Both indices only ever grow, and are wrapped with EVENT_RING_MASK on access.
+ * The ring is empty when head == tail, and full when head - tail == EVENT_RING_CAPACITY.
+ *
+ * Each side also keeps a private cached copy of the other side's index, so that
+ * it only has to touch the shared cache line when the ring looks full or empty.
+ *
+ * coroutine is the coroutine the producer runs in, or NULL if it runs on a thread of its own.
+ */
+typedef struct EventRing {
+    StackEvent   events[EVENT_RING_CAPACITY];
+
+    SDL_atomic_t head;         // written by the producer, read by the consumer
+    Uint32       cached_tail;  // the producer's private copy of tail
+    char         pad_producer[CACHE_LINE_SIZE];
+
+    SDL_atomic_t tail;         // written by the consumer, read by the producer
+    Uint32       cached_head;  // the consumer's private copy of head
+    char         pad_consumer[CACHE_LINE_SIZE];
+
+    Coroutine*   coroutine;    // the coroutine of the producer, or NULL
+} EventRing;
+
+
+/**
+ * This function sets the ring buffer to the empty state, with the producer on a thread of its own.
+ * It must be called before the producer thread is started.
+ *
+ * @param EventRing* ring - A pointer to the ring buffer to initialize.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void ringInit(EventRing* ring);
+
+
+/**
+ * This function appends one record to the ring buffer. It is only called by the producer.
+ *
+ * If the ring buffer is full, because the render loop is playing the animation back
+ * more slowly than the recursion runs, the producer waits until a slot is freed.
+ * A producer running as a coroutine yields back to the consumer after every record instead.
+ *
+ * @param EventRing* ring - A pointer to the ring buffer.
+ *
+ * @param const StackEvent* event - The record to copy into the ring buffer.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void ringPush(EventRing* ring, const StackEvent* event);
+
+
+/**
+ * This function removes the oldest record from the ring buffer. It is only called by the consumer.
+ * It never waits. If the producer is a coroutine and the ring buffer is empty,
+ * it resumes the coroutine until it has made the next record.
+ *
+ * @param EventRing* ring - A pointer to the ring buffer.
+ *
+ * @param StackEvent* event - Receives a copy of the oldest record.
+ *
+ * @return int - 1 if a record was removed, 0 if the ring buffer was empty
+ *               and the producer has not made another record yet.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int ringPop(EventRing* ring, StackEvent* event);
+
+#endif /* RECURSION_VISUALIZED_RING_H */
@@ -0,0 +1,153 @@
+/**
+ * @file    recursion_visualized_scheduler.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the frame-paced animation scheduler functions.
+ */
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_scheduler.h"
+
+
+/* The longest the scheduler waits in one go, in milliseconds. Events end the wait
+   right away, but even without any, the render loop comes back this often,
+   so the call tree keeps catching up after a jump along the timeline. */
+#define SCHEDULER_MAX_SLEEP_MS 16
+
+
+void schedulerInit(Scheduler* sched, double steps_per_second, int refresh_rate)
+{
+    if (refresh_rate <= 0) {
+        refresh_rate = SCHEDULER_DEFAULT_REFRESH;
+    }
+
+    sched->frequency   = SDL_GetPerformanceFrequency();
+    sched->last        = SDL_GetPerformanceCounter();
+    sched->last_frame  = 0;
+    sched->accumulator = 0.0;
+    sched->frame_ticks = (double) sched->frequency / refresh_rate;
+    sched->paused       = 0;
+    sched->single_steps = 0;
+
+    schedulerSetRate(sched, steps_per_second);
+}
+
+
+void schedulerSetRate(Scheduler* sched, double steps_per_second)
+{
+    if (steps_per_second < SCHEDULER_MIN_RATE) {
+        steps_per_second = SCHEDULER_MIN_RATE;
+    } else if (steps_per_second > SCHEDULER_MAX_RATE) {
+        steps_per_second = SCHEDULER_MAX_RATE;
+    }
+
+    sched->steps_per_second = steps_per_second;
+    sched->step_ticks       = (double) sched->frequency / steps_per_second;
+}
+
+
+void schedulerSetPaused(Scheduler* sched, int paused)
+{
+    // The time spent paused is not made up for after resuming,
+    // the next step is due one step after resuming.
+    sched->paused       = paused;
+    sched->single_steps = 0;
+    sched->accumulator  = 0.0;
+    sched->last         = SDL_GetPerformanceCounter();
+}
+
+
+void schedulerSingleStep(Scheduler* sched)
+{
+    if (!sched->paused) {
+        schedulerSetPaused(sched, 1);
+    }
+    ++sched->single_steps;
+}
+
+
+Uint32 schedulerAdvance(Scheduler* sched)
+{
+    Uint64 now     = SDL_GetPerformanceCounter();
+    double backlog = SCHEDULER_MAX_BACKLOG * sched->frequency;
+    double steps;
+
+    if (sched->paused) {
+        Uint32 single_steps = sched->single_steps;
+
+        sched->single_steps = 0;
+        sched->last         = now;
+        return single_steps;
+    }
+
+    sched->accumulator += (double) (now - sched->last);
+    sched->last = now;
+
+    // Never keep more than a short backlog of real time, but always at least one step,
+    // otherwise the slow rates below 1 / SCHEDULER_MAX_BACKLOG could never make progress.
+    if (backlog < sched->step_ticks) {
+        backlog = sched->step_ticks;
+    }
+    if (sched->accumulator > backlog) {
+        sched->accumulator = backlog;
+    }
+
+    steps = (double) (Uint64) (sched->accumulator / sched->step_ticks);
+    sched->accumulator -= steps * sched->step_ticks;
+
+    return (Uint32) steps;
+}
+
+
+void schedulerFrameDrawn(Scheduler* sched)
+{
+    sched->last_frame = SDL_GetPerformanceCounter();
+}
+
+
+void schedulerWait(Scheduler* sched)
+{
+    Uint64 now        = SDL_GetPerformanceCounter();
+    double step_wait  = sched->step_ticks - (sched->accumulator + (double) (now - sched->last));
+    double frame_wait = sched->frame_ticks - (double) (now - sched->last_frame);
+
+    // Wake up for whichever comes later: the next step, or the next display refresh.
+    // If the steps come faster than the display, they pile up in the accumulator
+    // and are played back together, so the frames in between are skipped.
+    // While paused, no step is due until one is asked for.
+    double wait = (step_wait > frame_wait) ? step_wait : frame_wait;
+    double ms   = wait * 1000.0 / sched->frequency;
+
+    if (sched->paused) {
+        ms = (sched->single_steps > 0) ? 0.0 : SCHEDULER_MAX_SLEEP_MS;
+    }
+    if (ms < 1.0) {
+        return;
+    }
+    if (ms > SCHEDULER_MAX_SLEEP_MS) {
+        ms = SCHEDULER_MAX_SLEEP_MS;
+    }
+
+    // Passing no SDL_Event leaves the event that ends the wait in the queue.
+    SDL_WaitEventTimeout(NULL, (int) ms);
+}
+
+
+Uint32 schedulerHoldTime(const Scheduler* sched)
+{
+    double ms = 1000.0 / sched->steps_per_second;
+
+    if (ms > 1000.0) {
+        ms = 1000.0;
+    }
+
+    return (Uint32) ms;
+}
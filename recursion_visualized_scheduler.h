@@ -0,0 +1,221 @@
+/**
+ * @file    recursion_visualized_scheduler.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the frame-paced animation scheduler.
+ *
+ * The scheduler decides how many animation steps (push/pop records) the render loop
+ * should play back each time around, based on a configurable steps-per-second rate.
+ * It is a fixed-timestep accumulator built on SDL_GetPerformanceCounter():
+ * the real time that has passed is added to the accumulator, and every whole
+ * step's worth of time in it becomes one step.
+ *
+ * When the requested rate is higher than the refresh rate of the display, several steps
+ * fall into one display refresh. The render loop then plays all of them back, but only
+ * draws the last one, skipping the frames that nobody would ever see.
+ *
+ * The time between two steps is not slept away, it is spent waiting for events with
+ * SDL_WaitEventTimeout(), so the render loop handles any input as soon as it arrives,
+ * however slow the animation is. The scheduler can also be paused, and then made to
+ * play single steps, and its rate can be changed at any time.
+ */
+
+#ifndef RECURSION_VISUALIZED_SCHEDULER_H
+#define RECURSION_VISUALIZED_SCHEDULER_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+
+/* The range of animation rates that can be requested, in steps per second. */
+#define SCHEDULER_MIN_RATE 0.1
+#define SCHEDULER_MAX_RATE 1000000000.0
+
+/* The factor by which the animation rate is sped up or slowed down at a time. */
+#define SCHEDULER_RATE_FACTOR 2.0
+
+/* The refresh rate assumed when the display does not report one, in frames per second. */
+#define SCHEDULER_DEFAULT_REFRESH 60
+
+/* The most real time the accumulator may hold, in seconds. After a stall, such as the
+   window being dragged, the animation continues from where it was instead of racing ahead. */
+#define SCHEDULER_MAX_BACKLOG 0.25
+
+
+/**
+ * The state of the animation scheduler. All times are in performance counter ticks.
+ *
+ * @field Uint64 frequency - The number of performance counter ticks per second.
+ *
+ * @field Uint64 last - The counter value when schedulerAdvance() was last called.
+ *
+ * @field Uint64 last_frame - The counter value when the last frame was drawn.
+ *
+ * @field double accumulator - Real time that has passed but was not turned into steps yet.
+ *
+ * @field double step_ticks - The length of one animation step.
+ *
+ * @field double frame_ticks - The length of one display refresh.
+ *
+ * @field double steps_per_second - The requested animation rate.
+ *
+ * @field int paused - Nonzero while the animation is paused. Then no time is accumulated.
+ *
+ * @field Uint32 single_steps - The number of steps asked for one by one while paused,
+ *                              which are due the next time schedulerAdvance() is called.
+ */
+typedef struct Scheduler {
+    Uint64 frequency;
+    Uint64 last;
+    Uint64 last_frame;
+    double accumulator;
+    double step_ticks;
+    double frame_ticks;
+    double steps_per_second;
+    int    paused;
+    Uint32 single_steps;
+} Scheduler;
+
+
+/**
+ * This function sets up the scheduler and starts its clock.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler to initialize.
+ *
+ * @param double steps_per_second - The animation rate, clamped into
+ *                                  [SCHEDULER_MIN_RATE, SCHEDULER_MAX_RATE].
+ *
+ * @param int refresh_rate - The refresh rate of the display in frames per second,
+ *                           or 0 if it is unknown.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerInit(Scheduler* sched, double steps_per_second, int refresh_rate);
+
+
+/**
+ * This function changes the animation rate without restarting the clock.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * @param double steps_per_second - The new animation rate, clamped into
+ *                                  [SCHEDULER_MIN_RATE, SCHEDULER_MAX_RATE].
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerSetRate(Scheduler* sched, double steps_per_second);
+
+
+/**
+ * This function pauses the animation, or resumes it where it was.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * @param int paused - Nonzero to pause, 0 to resume.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerSetPaused(Scheduler* sched, int paused);
+
+
+/**
+ * This function pauses the animation if it is not paused yet,
+ * and makes one more step due right away.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerSingleStep(Scheduler* sched);
+
+
+/**
+ * This function adds the real time that has passed since the last call to the
+ * accumulator, and takes out as many whole steps as fit in it.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * @return Uint32 - The number of animation steps that are due now. It may be 0,
+ *                  and it may be more than 1 when the rate is above the refresh rate.
+ *                  While paused, it is the number of single steps asked for.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint32 schedulerAdvance(Scheduler* sched);
+
+
+/**
+ * This function tells the scheduler that a frame was just drawn,
+ * so that the next one is not drawn before the next display refresh.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerFrameDrawn(Scheduler* sched);
+
+
+/**
+ * This function waits until there is something to do: until the next step is due,
+ * or, when the steps come faster than the display can show them, until the next refresh,
+ * but returns as soon as an event arrives. The event is left in the queue for handleEvents().
+ * It never waits if there already is work to do.
+ *
+ * @param Scheduler* sched - A pointer to the scheduler.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void schedulerWait(Scheduler* sched);
+
+
+/**
+ * This function tells how long the frames before and after the recursion are held on the screen:
+ * the length of one animation step, but at most 1 second.
+ *
+ * @param const Scheduler* sched - A pointer to the scheduler.
+ *
+ * @return Uint32 - The time to hold a frame, in milliseconds.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint32 schedulerHoldTime(const Scheduler* sched);
+
+#endif /* RECURSION_VISUALIZED_SCHEDULER_H */
@@ -0,0 +1,1034 @@
+/**
+ * @file    recursion_visualized_stackview.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the stack view functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+#include <string.h>  // C strings - for memcpy(), strlen()
+
+#include "recursion_visualized_header.h"
+#include "recursion_visualized_stackview.h"
+#include "recursion_visualized_examples.h"
+
+
+/* Frames at least this tall are drawn with a 1 pixel gap above them, so they can be told apart. */
+#define FRAME_GAP_MIN_HEIGHT 4.0
+
+
+/* The color codes in the order of their batches, and the RGB colors they are drawn in. */
+static const Uint8 FRAME_COLOR_CODES[FRAME_COLOR_COUNT] = { LIME, PINK, GOLD, CYAN };
+static const Uint8 FRAME_COLOR_RGB[FRAME_COLOR_COUNT][3] = {
+    {   0, 255, 100 },  // LIME
+    { 255,   0, 100 },  // PINK
+    { 255, 200,   0 },  // GOLD
+    {   0, 220, 255 }   // CYAN
+};
+
+/* The RGB color of the background, which the popped frames are erased with. */
+static const Uint8 BACKGROUND_RGB[3] = { 0, 0, 255 };
+
+/* The RGB color of the gauge of the stack use, and its width in pixels. */
+static const Uint8 GAUGE_RGB[3] = { 255, 255, 255 };
+#define GAUGE_WIDTH 8
+
+/* The space between a stack frame and its label, in pixels, and the longest label, in bytes. */
+#define LABEL_MARGIN     4
+#define LABEL_MAX_LENGTH 64
+
+
+/**
+ * This function finds the batch that the boxes of a color code are gathered into.
+ *
+ * @param Uint8 color - LIME, PINK, GOLD or CYAN.
+ *
+ * @return int - The index of the batch.
+ */
+static int colorBatch(Uint8 color)
+{
+    int batch;
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (FRAME_COLOR_CODES[batch] == color) {
+            return batch;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function appends one box to the batch of its color.
+ * The batches have room for one box per row of pixels plus one, which is the most
+ * that stackViewDraw() can ever produce, so there is no need to check for room.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param Uint8 color - The color code of the box.
+ *
+ * @param const SDL_Rect* rect - The box.
+ */
+static void addToBatch(StackView* view, Uint8 color, const SDL_Rect* rect)
+{
+    int batch = colorBatch(color);
+
+    view->batches[batch][view->batch_sizes[batch]++] = *rect;
+}
+
+
+/**
+ * This function finds the stack frame shown at the bottom of the viewport.
+ *
+ * @param const StackView* view - A pointer to the view.
+ *
+ * @return Uint32 - The index into view->colors of the lowest visible frame.
+ */
+static Uint32 firstVisibleFrame(const StackView* view)
+{
+    double visible = view->height / view->frame_height;
+    double hidden  = (double) view->depth - visible - view->scroll;
+
+    // The whole stack, or all of it below the scrolled away frames, fits into the viewport.
+    if (hidden <= 0.0) {
+        return 0;
+    }
+
+    return (Uint32) hidden;
+}
+
+
+/**
+ * This function computes where a stack frame is drawn in the current layout.
+ * The frame at index i spans the rows from (i - first) * fh to (i - first + 1) * fh,
+ * counting from the bottom of the viewport.
+ *
+ * @param const StackView* view - A pointer to the view.
+ *
+ * @param Uint32 i - The index of the frame. It must not be below view->layout_first.
+ *
+ * @param SDL_Rect* rect - Receives the box of the frame.
+ */
+static void layoutFrame(const StackView* view, Uint32 i, SDL_Rect* rect)
+{
+    double fh     = view->layout_height;
+    int    gap    = (fh >= FRAME_GAP_MIN_HEIGHT) ? 1 : 0;
+    int    bottom = view->height - (int) ((i - view->layout_first) * fh + 0.5);
+    int    top    = view->height - (int) ((i - view->layout_first + 1) * fh + 0.5);
+
+    rect->x = (view->width - FRAME_SIZE) / 2;
+    rect->w = FRAME_SIZE;
+    rect->y = top + gap;
+    rect->h = bottom - top - gap;
+}
+
+
+/**
+ * This function picks the frame height in fitting mode: the frames are shrunk just enough
+ * that the whole stack fits, but never grown past normal.
+ *
+ * @param StackView* view - A pointer to the view.
+ */
+static void updateFrameHeight(StackView* view)
+{
+    double fh;
+
+    if (!view->fit) {
+        return;
+    }
+
+    fh = (view->depth > 0) ? (double) view->height / view->depth : FRAME_SIZE;
+    if (fh > FRAME_SIZE) {
+        fh = FRAME_SIZE;
+    } else if (fh < FRAME_HEIGHT_MIN) {
+        fh = FRAME_HEIGHT_MIN;
+    }
+    view->frame_height = fh;
+}
+
+
+/**
+ * This function tells how tall a stack frame is on average in the current layout,
+ * which is the same for all of them unless they are drawn in proportion to their real size.
+ *
+ * @param const StackView* view - A pointer to the view.
+ *
+ * @return double - The height in pixels.
+ */
+static double averageFrameHeight(const StackView* view)
+{
+    double height;
+
+    if (!view->bytes) {
+        return view->frame_height;
+    }
+    if (view->depth == 0 || view->stack[view->depth - 1] == 0) {
+        return FRAME_SIZE;
+    }
+
+    height = (double) view->stack[view->depth - 1] * view->byte_scale / view->depth;
+
+    return (height > 0.0) ? height : FRAME_SIZE;
+}
+
+
+/**
+ * This function picks the scale in fitting mode, when the frames are drawn in proportion to
+ * their real size: the bytes in use are shrunk just enough that they fit, but never grown
+ * past BYTE_SCALE_MAX.
+ *
+ * @param StackView* view - A pointer to the view.
+ */
+static void updateByteScale(StackView* view)
+{
+    double scale = BYTE_SCALE_MAX;
+
+    if (!view->fit) {
+        return;
+    }
+
+    if (view->depth > 0 && view->stack[view->depth - 1] > 0) {
+        scale = (double) view->height / (double) view->stack[view->depth - 1];
+    }
+    if (scale > BYTE_SCALE_MAX) {
+        scale = BYTE_SCALE_MAX;
+    } else if (scale < BYTE_SCALE_MIN) {
+        scale = BYTE_SCALE_MIN;
+    }
+    view->byte_scale = scale;
+}
+
+
+/**
+ * This function finds the lowest stack frame which reaches up to at least the given stack use,
+ * which is the one the byte at that height of the runtime stack belongs to.
+ *
+ * @param const StackView* view - A pointer to the view.
+ *
+ * @param Uint32 low, high - The frames with indices in [low, high] to look through.
+ *
+ * @param double bytes - The stack use to look for.
+ *
+ * @return Uint32 - The index of the frame, or high if none of the frames reaches that far.
+ */
+static Uint32 findFrame(const StackView* view, Uint32 low, Uint32 high, double bytes)
+{
+    while (low < high) {
+        Uint32 middle = low + (high - low) / 2;
+
+        if ((double) view->stack[middle] >= bytes) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return low;
+}
+
+
+/**
+ * This function gathers the boxes of the stack frames inside of the viewport into the batches,
+ * drawn in proportion to their real size. Like in the normal layout, every frame that is at
+ * least 1 pixel tall gets a box of its own, and the smaller ones are collapsed into bands of
+ * one row of pixels, which take the color of the topmost frame inside of them. So there is
+ * never more than one box per row of pixels, however many frames there are.
+ *
+ * @param StackView* view - A pointer to the view.
+ */
+static void layoutBytes(StackView* view)
+{
+    double   scale     = view->byte_scale;
+    double   origin    = 0.0;
+    Uint8    run_color = 0;
+    int      run_start = 0;
+    int      row       = 0;
+    Uint32   top;
+    Uint32   i;
+    SDL_Rect rect;
+
+    if (view->depth == 0) {
+        return;
+    }
+
+    // The viewport ends at the top of the topmost frame which is not scrolled away.
+    // If everything up to there fits, the bottom of the stack stays at the bottom of the window.
+    top = (view->scroll < view->depth) ? view->depth - 1 - view->scroll : 0;
+    if ((double) view->stack[top] * scale > view->height) {
+        origin = (double) view->stack[top] - view->height / scale;
+    }
+
+    rect.x = (view->width - FRAME_SIZE) / 2;
+    rect.w = FRAME_SIZE;
+
+    i = findFrame(view, 0, top, origin);
+    while (i <= top && row < view->height) {
+        double low  = ((i > 0 ? (double) view->stack[i - 1] : 0.0) - origin) * scale;
+        double high = ((double) view->stack[i] - origin) * scale;
+        double full = high - low;
+
+        if (low < row) {
+            low = row;
+        }
+
+        if (high - low >= 1.0) {
+	    // The frame is at least a pixel tall, so it gets a box of its own.
+            int bottom = (int) (low + 0.5);
+            int gap    = (full >= FRAME_GAP_MIN_HEIGHT) ? 1 : 0;
+
+            row = (int) (high + 0.5);
+            if (row > view->height) {
+                row = view->height;
+            }
+
+            if (run_color != 0) {
+                rect.y = view->height - bottom;
+                rect.h = bottom - run_start;
+                addToBatch(view, run_color, &rect);
+                run_color = 0;
+            }
+
+            rect.y = view->height - row + gap;
+            rect.h = row - bottom - gap;
+            if (rect.h > 0) {
+                addToBatch(view, view->colors[i], &rect);
+            }
+            ++i;
+        } else {
+	    // The row is a band of frames, which takes the color of the topmost one.
+	    // Neighbouring bands of the same color are merged into one box.
+            double upper = origin + (row + 1) / scale;
+            Uint32 j     = findFrame(view, i, top, upper);
+
+            if (view->colors[j] != run_color) {
+                if (run_color != 0) {
+                    rect.y = view->height - row;
+                    rect.h = row - run_start;
+                    addToBatch(view, run_color, &rect);
+                }
+                run_color = view->colors[j];
+                run_start = row;
+            }
+
+            ++row;
+            i = ((double) view->stack[j] <= upper) ? j + 1 : j;
+        }
+    }
+
+    if (run_color != 0) {
+        rect.y = view->height - row;
+        rect.h = row - run_start;
+        addToBatch(view, run_color, &rect);
+    }
+}
+
+
+/**
+ * This function lays out the gauge of how much of the runtime stack of the recursion is in use:
+ * the outline stands for the whole stack, and it is filled up as far as the stack is in use.
+ *
+ * @param const StackView* view - A pointer to the view, whose stack_limit is known.
+ *
+ * @param SDL_Rect* outline - Receives the outline of the gauge.
+ *
+ * @param SDL_Rect* fill - Receives the filled part of the gauge, which may be 0 pixels tall.
+ */
+static void layoutGauge(const StackView* view, SDL_Rect* outline, SDL_Rect* fill)
+{
+    Uint64 used = (view->depth > 0) ? view->stack[view->depth - 1] : 0;
+
+    if (used > view->stack_limit) {
+        used = view->stack_limit;
+    }
+
+    outline->x = view->width - 2 * GAUGE_WIDTH;
+    outline->y = GAUGE_WIDTH;
+    outline->w = GAUGE_WIDTH;
+    outline->h = view->height - 2 * GAUGE_WIDTH;
+
+    *fill   = *outline;
+    fill->h = (int) ((double) outline->h * used / view->stack_limit + 0.5);
+    fill->y = outline->y + outline->h - fill->h;
+}
+
+
+/**
+ * This function draws the gauge of how much of the runtime stack of the recursion is in use.
+ *
+ * @param const StackView* view - A pointer to the view, whose stack_limit is known.
+ *
+ * @param SDL_Renderer* renderer - The renderer to draw into.
+ */
+static void drawGauge(const StackView* view, SDL_Renderer* renderer)
+{
+    SDL_Rect outline;
+    SDL_Rect fill;
+
+    layoutGauge(view, &outline, &fill);
+
+    SDL_SetRenderDrawColor(renderer, GAUGE_RGB[0], GAUGE_RGB[1], GAUGE_RGB[2], 255);
+    SDL_RenderDrawRect(renderer, &outline);
+    if (fill.h > 0) {
+        SDL_RenderFillRect(renderer, &fill);
+    }
+}
+
+
+/**
+ * This function draws the gauge of how much of the runtime stack of the recursion is in use
+ * into a software raster.
+ *
+ * @param const StackView* view - A pointer to the view, whose stack_limit is known.
+ *
+ * @param Raster* raster - The raster to draw into.
+ */
+static void rasterGauge(const StackView* view, Raster* raster)
+{
+    SDL_Rect outline;
+    SDL_Rect fill;
+
+    layoutGauge(view, &outline, &fill);
+
+    rasterSetColor(raster, GAUGE_RGB[0], GAUGE_RGB[1], GAUGE_RGB[2]);
+    rasterDrawRect(raster, &outline);
+    if (fill.h > 0) {
+        rasterFillRects(raster, &fill, 1);
+    }
+}
+
+
+/**
+ * This function remembers that the frames with indices in [low, high) changed.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param Uint32 low, high - The range of frames that changed.
+ */
+static void markDirty(StackView* view, Uint32 low, Uint32 high)
+{
+    if (view->dirty_low >= view->dirty_high) {
+        view->dirty_low  = low;
+        view->dirty_high = high;
+        return;
+    }
+
+    if (low < view->dirty_low) {
+        view->dirty_low = low;
+    }
+    if (high > view->dirty_high) {
+        view->dirty_high = high;
+    }
+}
+
+
+/**
+ * This function makes room for a stack of the given depth.
+ * If the stack became deeper than there is room for, the room is at least doubled.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param Uint32 depth - The depth of the stack.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int growStack(StackView* view, Uint32 depth)
+{
+    Uint32    capacity = view->capacity * 2;
+    Uint8*    colors;
+    SDL_Rect* rects;
+    Uint64*   stack;
+    Uint16*   functions;
+    Sint64*   args;
+
+    if (depth <= view->capacity) {
+        return 0;
+    }
+
+    if (capacity < depth) {
+        capacity = depth;
+    }
+    colors = (Uint8*) realloc(view->colors, capacity);
+    if (!colors) {
+        return -1;
+    }
+    view->colors = colors;
+    rects = (SDL_Rect*) realloc(view->rects, capacity * sizeof(SDL_Rect));
+    if (!rects) {
+        return -1;
+    }
+    view->rects = rects;
+    stack = (Uint64*) realloc(view->stack, capacity * sizeof(Uint64));
+    if (!stack) {
+        return -1;
+    }
+    view->stack = stack;
+    functions = (Uint16*) realloc(view->functions, capacity * sizeof(Uint16));
+    if (!functions) {
+        return -1;
+    }
+    view->functions = functions;
+    args = (Sint64*) realloc(view->args, capacity * STACK_EVENT_ARGS * sizeof(Sint64));
+    if (!args) {
+        return -1;
+    }
+    view->args     = args;
+    view->capacity = capacity;
+
+    return 0;
+}
+
+
+int stackViewInit(StackView* view, int width, int height, Uint32 capacity)
+{
+    int batch;
+
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    view->colors    = (Uint8*) malloc(capacity);
+    view->rects     = (SDL_Rect*) malloc(capacity * sizeof(SDL_Rect));
+    view->stack     = (Uint64*) malloc(capacity * sizeof(Uint64));
+    view->functions = (Uint16*) malloc(capacity * sizeof(Uint16));
+    view->args      = (Sint64*) malloc(capacity * STACK_EVENT_ARGS * sizeof(Sint64));
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        view->batches[batch]     = (SDL_Rect*) malloc((height + 1) * sizeof(SDL_Rect));
+        view->batch_sizes[batch] = 0;
+    }
+    view->erased      = (SDL_Rect*) malloc((height + 1) * sizeof(SDL_Rect));
+    view->erased_size = 0;
+
+    view->capacity      = capacity;
+    view->depth         = 0;
+    view->width         = width;
+    view->height        = height;
+    view->frame_height  = FRAME_SIZE;
+    view->scroll        = 0;
+    view->fit           = 0;
+    view->layout_first  = 0;
+    view->layout_height = 0.0;
+    view->dirty_low     = 0;
+    view->dirty_high    = 0;
+    view->invalid       = 1;
+    view->bytes         = 0;
+    view->byte_scale    = 1.0;
+    view->address       = 0;
+    view->peak          = 0;
+    view->stack_limit   = 0;
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (!view->batches[batch]) {
+            stackViewDestroy(view);
+            return -1;
+        }
+    }
+    if (!view->colors || !view->rects || !view->stack || !view->functions || !view->args || !view->erased) {
+        stackViewDestroy(view);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void stackViewDestroy(StackView* view)
+{
+    int batch;
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        free(view->batches[batch]);
+        view->batches[batch] = NULL;
+    }
+    free(view->erased);
+    free(view->colors);
+    free(view->rects);
+    free(view->stack);
+    free(view->functions);
+    free(view->args);
+    view->erased    = NULL;
+    view->colors    = NULL;
+    view->rects     = NULL;
+    view->stack     = NULL;
+    view->functions = NULL;
+    view->args      = NULL;
+    view->capacity  = 0;
+    view->depth    = 0;
+}
+
+
+int stackViewApply(StackView* view, const StackEvent* event)
+{
+    Uint32 i;
+
+    if (event->type == EVENT_END) {
+        markDirty(view, 0, view->depth);
+        view->depth = 0;
+        return 0;
+    }
+
+    if (growStack(view, event->depth) != 0) {
+        return -1;
+    }
+
+    i = event->depth - 1;
+
+    // The frame itself changed, and so did every frame that was popped off above it.
+    markDirty(view, i, (view->depth > event->depth) ? view->depth : event->depth);
+
+    view->depth        = event->depth;
+    view->colors[i]    = event->color;
+    view->stack[i]     = event->stack;
+    view->address      = event->address;
+    view->functions[i] = event->function;
+    memcpy(&view->args[i * STACK_EVENT_ARGS], event->args, sizeof(event->args));
+    if (view->peak < event->stack) {
+        view->peak = event->stack;
+    }
+
+    // Keep the retained box of a newly pushed frame up to date with the current layout.
+    if (view->layout_height >= 1.0 && i >= view->layout_first) {
+        layoutFrame(view, i, &view->rects[i]);
+    }
+
+    return 0;
+}
+
+
+int stackViewResize(StackView* view, Uint32 depth)
+{
+    Uint32 i;
+
+    if (growStack(view, depth) != 0) {
+        return -1;
+    }
+
+    view->depth = depth;
+
+    // The calls of the frames are not known any more, until they are pushed again.
+    for (i = 0; i < depth; ++i) {
+        view->functions[i] = FRAME_FUNCTION_UNKNOWN;
+    }
+
+    // None of the retained boxes can be trusted any more, so lay out and draw everything again.
+    view->layout_height = 0.0;
+    view->invalid       = 1;
+
+    return 0;
+}
+
+
+void stackViewScroll(StackView* view, int rows)
+{
+    double frames = rows / averageFrameHeight(view);
+    double scroll;
+
+    // Always move by at least one frame, even when the frames are taller than the scroll step.
+    if (rows > 0 && frames < 1.0) {
+        frames = 1.0;
+    } else if (rows < 0 && frames > -1.0) {
+        frames = -1.0;
+    }
+
+    scroll = view->scroll + frames;
+    if (scroll < 0.0) {
+        scroll = 0.0;
+    } else if (scroll > view->depth) {
+        scroll = view->depth;
+    }
+
+    view->scroll = (Uint32) scroll;
+    view->fit    = 0;
+}
+
+
+void stackViewZoom(StackView* view, int steps)
+{
+    if (view->bytes) {
+        for (; steps > 0 && view->byte_scale * 2.0 <= BYTE_SCALE_MAX; --steps) {
+            view->byte_scale *= 2.0;
+        }
+        for (; steps < 0 && view->byte_scale / 2.0 >= BYTE_SCALE_MIN; ++steps) {
+            view->byte_scale /= 2.0;
+        }
+        view->fit = 0;
+        return;
+    }
+
+    for (; steps > 0 && view->frame_height * 2.0 <= FRAME_HEIGHT_MAX; --steps) {
+        view->frame_height *= 2.0;
+    }
+    for (; steps < 0 && view->frame_height / 2.0 >= FRAME_HEIGHT_MIN; ++steps) {
+        view->frame_height /= 2.0;
+    }
+
+    view->fit = 0;
+}
+
+
+void stackViewFit(StackView* view)
+{
+    view->fit    = 1;
+    view->scroll = 0;
+}
+
+
+void stackViewShowBytes(StackView* view, int bytes)
+{
+    view->bytes         = bytes;
+    view->fit           = bytes;
+    view->scroll        = 0;
+    view->layout_height = 0.0;
+    view->invalid       = 1;
+}
+
+
+/**
+ * This function gathers the boxes of the stack frames inside of the viewport into the batches,
+ * laying them out again if the viewport moved. Afterwards nothing is dirty any more.
+ *
+ * @param StackView* view - A pointer to the view. In fitting mode its frame height is updated.
+ */
+static void gatherFrames(StackView* view)
+{
+    Uint32 first;
+    double fh;
+    int    batch;
+
+    updateFrameHeight(view);
+
+    fh    = view->frame_height;
+    first = firstVisibleFrame(view);
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        view->batch_sizes[batch] = 0;
+    }
+
+    // Everything is drawn from scratch, so nothing is dirty any more.
+    view->dirty_low  = 0;
+    view->dirty_high = 0;
+    view->invalid    = 0;
+
+    if (view->bytes) {
+	// The frames are laid out by their real size, and the retained boxes are not used.
+        view->layout_height = 0.0;
+        updateByteScale(view);
+        layoutBytes(view);
+    } else if (fh >= 1.0) {
+	// Every stack frame in the viewport is drawn as its own box.
+	// If the viewport has moved since the boxes were laid out, lay out the visible ones again.
+        Uint32 i;
+
+        if (first != view->layout_first || fh != view->layout_height) {
+            view->layout_first  = first;
+            view->layout_height = fh;
+            for (i = first; i < view->depth; ++i) {
+                layoutFrame(view, i, &view->rects[i]);
+                if (view->rects[i].y + view->rects[i].h <= 0) {
+                    break;
+                }
+            }
+        }
+
+        for (i = first; i < view->depth; ++i) {
+            if (view->rects[i].y + view->rects[i].h <= 0) {
+                break;
+            }
+            addToBatch(view, view->colors[i], &view->rects[i]);
+        }
+    } else {
+	// The frames are smaller than a pixel, so each row of pixels is a band of frames.
+	// The band takes the color of the topmost frame inside of it, and neighbouring
+	// bands of the same color are merged into one box.
+        double   frames_per_row = 1.0 / fh;
+        Uint8    run_color      = 0;
+        int      run_start      = 0;
+        int      row;
+        SDL_Rect rect;
+
+        // The retained boxes are not kept up to date in this mode.
+        view->layout_height = 0.0;
+
+        rect.x = (view->width - FRAME_SIZE) / 2;
+        rect.w = FRAME_SIZE;
+
+        for (row = 0; row < view->height; ++row) {
+            double low  = first + row * frames_per_row;
+            double high = low + frames_per_row;
+            Uint32 top;
+
+            if (low >= view->depth) {
+                break;
+            }
+            top = (high >= view->depth) ? view->depth - 1 : (Uint32) high - 1;
+            if (top < (Uint32) low) {
+                top = (Uint32) low;
+            }
+
+            if (view->colors[top] != run_color) {
+                if (run_color != 0) {
+                    rect.y = view->height - row;
+                    rect.h = row - run_start;
+                    addToBatch(view, run_color, &rect);
+                }
+                run_color = view->colors[top];
+                run_start = row;
+            }
+        }
+
+        if (run_color != 0) {
+            rect.y = view->height - row;
+            rect.h = row - run_start;
+            addToBatch(view, run_color, &rect);
+        }
+    }
+}
+
+
+void stackViewDraw(StackView* view, SDL_Renderer* renderer)
+{
+    int batch;
+
+    gatherFrames(view);
+
+    // One draw call per color, however many stack frames are visible.
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (view->batch_sizes[batch] > 0) {
+            SDL_SetRenderDrawColor(renderer, FRAME_COLOR_RGB[batch][0], FRAME_COLOR_RGB[batch][1],
+                                   FRAME_COLOR_RGB[batch][2], 255);
+            SDL_RenderFillRects(renderer, view->batches[batch], view->batch_sizes[batch]);
+        }
+    }
+
+    if (view->bytes && view->stack_limit > 0) {
+        drawGauge(view, renderer);
+    }
+}
+
+
+void stackViewRaster(StackView* view, Raster* raster)
+{
+    int batch;
+
+    gatherFrames(view);
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (view->batch_sizes[batch] > 0) {
+            rasterSetColor(raster, FRAME_COLOR_RGB[batch][0], FRAME_COLOR_RGB[batch][1],
+                           FRAME_COLOR_RGB[batch][2]);
+            rasterFillRects(raster, view->batches[batch], view->batch_sizes[batch]);
+        }
+    }
+
+    if (view->bytes && view->stack_limit > 0) {
+        rasterGauge(view, raster);
+    }
+}
+
+
+/**
+ * This function gathers the boxes of the stack frames that changed since the view was last drawn
+ * into the batches, and the boxes of the popped ones into erased. Afterwards nothing is dirty any more.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @return int - 1 if the boxes were gathered, 0 if the last drawing cannot be brought up to date,
+ *               because the layout changed since then. Then nothing was gathered.
+ */
+static int gatherDirty(StackView* view)
+{
+    Uint32   first;
+    Uint32   end;
+    Uint32   i;
+    double   fh;
+    int      batch;
+    SDL_Rect rect;
+
+    updateFrameHeight(view);
+
+    fh    = view->frame_height;
+    first = firstVisibleFrame(view);
+
+    // The old drawing is only good if it was made with exactly the same layout.
+    if (view->invalid || view->bytes || fh < 1.0 || first != view->layout_first ||
+        fh != view->layout_height) {
+        return 0;
+    }
+
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        view->batch_sizes[batch] = 0;
+    }
+    view->erased_size = 0;
+
+    // Only the dirty frames inside of the viewport need to be touched.
+    // Their boxes are laid out again rather than taken from rects, because a frame that was
+    // pushed above the viewport in an earlier layout may still hold a box from that layout.
+    end = first + (Uint32) (view->height / fh) + 1;
+    if (end > view->dirty_high) {
+        end = view->dirty_high;
+    }
+    for (i = (view->dirty_low > first) ? view->dirty_low : first; i < end; ++i) {
+        layoutFrame(view, i, &rect);
+        if (i < view->depth) {
+            addToBatch(view, view->colors[i], &rect);
+        } else {
+            view->erased[view->erased_size++] = rect;
+        }
+    }
+
+    view->dirty_low  = 0;
+    view->dirty_high = 0;
+
+    return 1;
+}
+
+
+int stackViewDrawDirty(StackView* view, SDL_Renderer* renderer)
+{
+    int batch;
+
+    if (!gatherDirty(view)) {
+        return 0;
+    }
+
+    if (view->erased_size > 0) {
+        SDL_SetRenderDrawColor(renderer, BACKGROUND_RGB[0], BACKGROUND_RGB[1], BACKGROUND_RGB[2], 255);
+        SDL_RenderFillRects(renderer, view->erased, view->erased_size);
+    }
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (view->batch_sizes[batch] > 0) {
+            SDL_SetRenderDrawColor(renderer, FRAME_COLOR_RGB[batch][0], FRAME_COLOR_RGB[batch][1],
+                                   FRAME_COLOR_RGB[batch][2], 255);
+            SDL_RenderFillRects(renderer, view->batches[batch], view->batch_sizes[batch]);
+        }
+    }
+
+    return 1;
+}
+
+
+int stackViewRasterDirty(StackView* view, Raster* raster)
+{
+    int batch;
+
+    if (!gatherDirty(view)) {
+        return 0;
+    }
+
+    if (view->erased_size > 0) {
+        rasterSetColor(raster, BACKGROUND_RGB[0], BACKGROUND_RGB[1], BACKGROUND_RGB[2]);
+        rasterFillRects(raster, view->erased, view->erased_size);
+    }
+    for (batch = 0; batch < FRAME_COLOR_COUNT; ++batch) {
+        if (view->batch_sizes[batch] > 0) {
+            rasterSetColor(raster, FRAME_COLOR_RGB[batch][0], FRAME_COLOR_RGB[batch][1],
+                           FRAME_COLOR_RGB[batch][2]);
+            rasterFillRects(raster, view->batches[batch], view->batch_sizes[batch]);
+        }
+    }
+
+    return 1;
+}
+
+
+/**
+ * This function finds the range of stack frames which are labeled.
+ *
+ * @param const StackView* view - A pointer to the view, which has just been drawn.
+ *
+ * @return Uint32 - One past the index of the topmost frame to label, from layout_first on,
+ *                  or 0 if no frame is labeled.
+ */
+static Uint32 labelEnd(const StackView* view)
+{
+    Uint32 end;
+
+    // Labels only fit while every stack frame is its own box, at least a line of text tall.
+    if (view->bytes || view->layout_height < GLYPH_HEIGHT) {
+        return 0;
+    }
+
+    end = view->layout_first + (Uint32) (view->height / view->layout_height) + 1;
+
+    return (end > view->depth) ? view->depth : end;
+}
+
+
+/**
+ * This function writes the label of a stack frame, and finds where it goes.
+ * Every label is right-aligned to the left side of its frame, and centered on it.
+ *
+ * @param const StackView* view - A pointer to the view.
+ *
+ * @param Uint32 i - The index of the stack frame, whose call is known.
+ *
+ * @param char* text - Receives the label, LABEL_MAX_LENGTH bytes.
+ *
+ * @param int* x, int* y - Receive the top left corner of the label.
+ */
+static void layoutLabel(const StackView* view, Uint32 i, char* text, int* x, int* y)
+{
+    SDL_Rect rect;
+
+    layoutFrame(view, i, &rect);
+    describeCall(text, LABEL_MAX_LENGTH, view->functions[i], &view->args[i * STACK_EVENT_ARGS]);
+    *x = rect.x - LABEL_MARGIN - (int) strlen(text) * GLYPH_WIDTH;
+    if (*x < 0) {
+        *x = 0;
+    }
+    *y = rect.y + (rect.h - GLYPH_HEIGHT + 1) / 2;
+}
+
+
+void stackViewDrawLabels(StackView* view, SDL_Renderer* renderer, GlyphAtlas* atlas)
+{
+    Uint32 end = labelEnd(view);
+    Uint32 i;
+    char   text[LABEL_MAX_LENGTH];
+    int    x;
+    int    y;
+
+    for (i = view->layout_first; i < end; ++i) {
+        if (view->functions[i] == FRAME_FUNCTION_UNKNOWN) {
+            continue;
+        }
+        layoutLabel(view, i, text, &x, &y);
+        glyphAtlasText(atlas, x, y, text);
+    }
+
+    // One draw call for all of the labels.
+    glyphAtlasFlush(atlas, renderer);
+}
+
+
+void stackViewRasterLabels(StackView* view, Raster* raster)
+{
+    Uint32 end = labelEnd(view);
+    Uint32 i;
+    char   text[LABEL_MAX_LENGTH];
+    int    x;
+    int    y;
+
+    rasterSetColor(raster, 255, 255, 255);
+    for (i = view->layout_first; i < end; ++i) {
+        if (view->functions[i] == FRAME_FUNCTION_UNKNOWN) {
+            continue;
+        }
+        layoutLabel(view, i, text, &x, &y);
+        glyphRasterText(raster, x, y, text);
+    }
+}
+
+
+void stackViewInvalidate(StackView* view)
+{
+    view->invalid = 1;
+}
@@ -0,0 +1,436 @@
+/**
+ * @file    recursion_visualized_stackview.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the stack view, the model of the runtime stack
+ * which the render loop keeps up to date from the push/pop records, and draws.
+ *
+ * The view can show stacks of any depth, up to millions of frames.
+ * The viewport is a window of frames around the top of the stack, which can be
+ * scrolled and zoomed. While the frames are at least 1 pixel tall, every frame in the
+ * viewport is drawn as its own box. When they become smaller than a pixel, the frames
+ * are collapsed into bands, one per row of pixels, and each band takes the color of
+ * the topmost frame inside of it. Either way, no more than one box per row of pixels
+ * is drawn, so the cost of a frame depends on the height of the window, not on the depth of the stack.
+ *
+ * The view retains the whole stack in contiguous arrays, one color and one SDL_Rect per
+ * stack frame, which mirror the runtime stack. The rectangles are only recomputed when the
+ * viewport moves. Drawing gathers the visible boxes into one batch per color, and hands each
+ * batch to the renderer with a single SDL_RenderFillRects() call, so the number of draw calls
+ * stays the same however deep the stack is.
+ *
+ * The view also remembers which stack frames changed since it was last drawn: the one that was
+ * pushed or recolored, and the ones that were popped off. When the renderer draws into a
+ * persistent backbuffer, stackViewDrawDirty() redraws only those boxes and erases the popped
+ * ones, instead of clearing and repainting the whole window on every step.
+ *
+ * The view can also draw every stack frame as tall as it really is on the runtime stack, in
+ * proportion to its size in bytes, instead of all of them alike. Each record says how many bytes
+ * of the stack are in use up to its frame, which is where the frame ends, so the frames are laid
+ * out straight from those numbers. A gauge at the right edge of the window shows how much of the
+ * runtime stack of the recursion thread is in use. In this mode the whole view is always redrawn.
+ *
+ * Next to every stack frame tall enough to hold a line of text, a label shows the call it belongs
+ * to, with its arguments, such as "fibonacci(5)". The view keeps the function and the arguments
+ * of every frame on the stack for that. The labels are drawn on top of the stack frames, after
+ * them, out of the glyph atlas, in one batch.
+ *
+ * Every drawing function has a twin which draws the same pixels into a software raster instead of
+ * onto a renderer, see recursion_visualized_raster.h. Both of them gather the same batches of boxes,
+ * and only differ in what the batches are handed to.
+ */
+
+#ifndef RECURSION_VISUALIZED_STACKVIEW_H
+#define RECURSION_VISUALIZED_STACKVIEW_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_ring.h"    // StackEvent
+#include "recursion_visualized_font.h"    // GlyphAtlas
+#include "recursion_visualized_raster.h"  // Raster
+
+
+/* The size of one stack frame at the default zoom, in pixels. */
+#define FRAME_SIZE 50
+
+/* The range of frame heights the viewport can be zoomed to, in pixels.
+   At the smallest one, 2^20 frames share one row of pixels. */
+#define FRAME_HEIGHT_MAX (FRAME_SIZE * 4.0)
+#define FRAME_HEIGHT_MIN (1.0 / 1048576.0)
+
+/* The range of scales the viewport can be zoomed to when the frames are drawn in proportion
+   to their real size, in pixels per byte. At the smallest one, 4 GB share one row of pixels. */
+#define BYTE_SCALE_MAX 4.0
+#define BYTE_SCALE_MIN (1.0 / 4294967296.0)
+
+/* The number of different colors a stack frame can be drawn in: LIME, PINK, GOLD and CYAN.
+   Each of them gets its own batch of boxes. */
+#define FRAME_COLOR_COUNT 4
+
+/* The function of a stack frame whose call is not known, so it gets no label.
+   The frames restored from a checkpoint of the timeline are such frames. */
+#define FRAME_FUNCTION_UNKNOWN 0xFFFE
+
+
+/**
+ * The model of the runtime stack, and the viewport through which it is drawn.
+ *
+ * @field Uint8* colors - colors[i] is the color code of the stack frame at depth i + 1,
+ *                        so colors[0] is the bottom of the stack.
+ *
+ * @field SDL_Rect* rects - rects[i] is where the stack frame at depth i + 1 is drawn in the
+ *                          current layout. Only the frames inside of the viewport are kept
+ *                          up to date, and only while the frames are at least 1 pixel tall.
+ *
+ * @field Uint64* stack - stack[i] is how many bytes of the runtime stack are in use up to and
+ *                        including the stack frame at depth i + 1, so the frame itself takes
+ *                        stack[i] - stack[i - 1] bytes.
+ *
+ * @field Uint16* functions - functions[i] is the FUNCTION_* constant of the call which made the stack
+ *                            frame at depth i + 1, or FRAME_FUNCTION_UNKNOWN.
+ *
+ * @field Sint64* args - args[i * STACK_EVENT_ARGS] is where the arguments of that call begin.
+ *
+ * @field Uint32 capacity - The number of frames allocated for colors, rects, stack, functions and args.
+ *
+ * @field Uint32 depth - The number of stack frames currently on the stack.
+ *
+ * @field int width, height - The size of the viewport in pixels.
+ *
+ * @field double frame_height - The height of one stack frame in pixels. It can be below 1.
+ *
+ * @field Uint32 scroll - How many frames at the top of the stack are scrolled out of the
+ *                        viewport. 0 means that the top of the stack is in the viewport.
+ *
+ * @field int fit - Nonzero if frame_height is picked automatically every time the view is
+ *                  drawn, so that the whole stack fits into the viewport.
+ *
+ * @field Uint32 layout_first, double layout_height - The lowest visible frame and the frame
+ *                  height that rects was computed for. A layout_height of 0 means none.
+ *
+ * @field SDL_Rect* batches[FRAME_COLOR_COUNT] - The boxes of each color gathered for drawing.
+ *                  Each one has room for one box per row of pixels, plus one.
+ *
+ * @field int batch_sizes[FRAME_COLOR_COUNT] - How many boxes are in each batch.
+ *
+ * @field SDL_Rect* erased - The boxes of popped frames gathered for erasing, with the same room.
+ *
+ * @field int erased_size - How many boxes are in erased.
+ *
+ * @field Uint32 dirty_low, dirty_high - The frames with indices in [dirty_low, dirty_high)
+ *                  changed since the view was last drawn. Empty when dirty_low >= dirty_high.
+ *
+ * @field int invalid - Nonzero if whatever was drawn before cannot be trusted any more,
+ *                      so the next draw has to be a full one.
+ *
+ * @field int bytes - Nonzero if the stack frames are drawn in proportion to their real size.
+ *
+ * @field double byte_scale - The height of one byte of the runtime stack in pixels, in that mode.
+ *
+ * @field Uint64 address - The address of the stack frame of the last record played back.
+ *
+ * @field Uint64 peak - The most bytes of the runtime stack that were ever in use.
+ *
+ * @field Uint64 stack_limit - The size of the runtime stack of the recursion, or 0 if unknown.
+ */
+typedef struct StackView {
+    Uint8*    colors;
+    SDL_Rect* rects;
+    Uint32    capacity;
+    Uint32    depth;
+    int       width;
+    int       height;
+    double    frame_height;
+    Uint32    scroll;
+    int       fit;
+    Uint32    layout_first;
+    double    layout_height;
+    SDL_Rect* batches[FRAME_COLOR_COUNT];
+    int       batch_sizes[FRAME_COLOR_COUNT];
+    SDL_Rect* erased;
+    int       erased_size;
+    Uint32    dirty_low;
+    Uint32    dirty_high;
+    int       invalid;
+    Uint64*   stack;
+    int       bytes;
+    double    byte_scale;
+    Uint64    address;
+    Uint64    peak;
+    Uint64    stack_limit;
+    Uint16*   functions;
+    Sint64*   args;
+} StackView;
+
+
+/**
+ * This function sets up an empty stack view.
+ *
+ * @param StackView* view - A pointer to the view to initialize.
+ *
+ * @param int width, height - The size of the viewport in pixels.
+ *
+ * @param Uint32 capacity - How many stack frames to make room for in advance.
+ *                          The view grows by itself if the stack becomes deeper.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int stackViewInit(StackView* view, int width, int height, Uint32 capacity);
+
+
+/**
+ * This function deallocates the memory owned by the stack view.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewDestroy(StackView* view);
+
+
+/**
+ * This function plays one push/pop record back into the model of the stack.
+ *
+ * A push adds the stack frame at event->depth. A pop recolors the stack frame at
+ * event->depth, which is about to leave the stack, and everything above it is gone.
+ * An EVENT_END record empties the stack.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param const StackEvent* event - The record to play back.
+ *
+ * @return int - 0 on success, -1 if the memory for a deeper stack could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int stackViewApply(StackView* view, const StackEvent* event);
+
+
+/**
+ * This function sets the depth of the stack directly, instead of by playing records back,
+ * which is how the timeline jumps to another step of a recording. The caller then fills in
+ * view->colors and view->stack from 0 up to depth - 1. The next drawing of the view is a full one.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param Uint32 depth - The new depth of the stack.
+ *
+ * @return int - 0 on success, -1 if the memory for a deeper stack could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int stackViewResize(StackView* view, Uint32 depth);
+
+
+/**
+ * These functions move the viewport.
+ *
+ * stackViewScroll() scrolls by the given number of rows of pixels,
+ * positive towards the bottom of the stack. It turns off fitting.
+ *
+ * stackViewZoom() doubles the frame height for every positive step,
+ * and halves it for every negative step. It turns off fitting.
+ * When the frames are drawn in proportion to their real size, it scales the bytes instead.
+ *
+ * stackViewFit() turns on fitting, so the whole stack is visible,
+ * and scrolls back to the top of the stack.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param int rows / int steps - How far to scroll or zoom.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewScroll(StackView* view, int rows);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewZoom(StackView* view, int steps);
+
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewFit(StackView* view);
+
+
+/**
+ * This function switches between drawing every stack frame alike, and drawing each of them
+ * in proportion to its real size in bytes. Switching to real sizes fits the stack into the window.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param int bytes - Nonzero to draw the frames in proportion to their real size.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewShowBytes(StackView* view, int bytes);
+
+
+/**
+ * This function draws the stack frames inside of the viewport onto the renderer.
+ * It does not clear the background and does not present.
+ * Afterwards nothing is dirty any more.
+ *
+ * @param StackView* view - A pointer to the view. In fitting mode its frame height is updated.
+ *
+ * @param SDL_Renderer* renderer - The renderer to draw into.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewDraw(StackView* view, SDL_Renderer* renderer);
+
+
+/**
+ * This function draws the stack frames inside of the viewport into a software raster,
+ * exactly like stackViewDraw() draws them onto a renderer.
+ * It does not clear the background. Afterwards nothing is dirty any more.
+ *
+ * @param StackView* view - A pointer to the view. In fitting mode its frame height is updated.
+ *
+ * @param Raster* raster - The raster to draw into.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewRaster(StackView* view, Raster* raster);
+
+
+/**
+ * This function brings a previous drawing of the view up to date, by redrawing only the
+ * stack frames that changed since then, and erasing the ones that were popped off.
+ * The renderer must still hold exactly what the view drew last time, like a target texture does.
+ *
+ * It refuses, and draws nothing, if the viewport has moved since the last drawing,
+ * if the frames are smaller than a pixel or drawn in proportion to their real size,
+ * or if the view was invalidated.
+ * Then the caller has to clear the background and call stackViewDraw() instead.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param SDL_Renderer* renderer - The renderer to draw into.
+ *
+ * @return int - 1 if the drawing was brought up to date, 0 if a full redraw is needed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int stackViewDrawDirty(StackView* view, SDL_Renderer* renderer);
+
+
+/**
+ * This function brings a previous drawing of the view in a software raster up to date,
+ * exactly like stackViewDrawDirty() does for a renderer. The raster must still hold exactly
+ * what the view drew into it last time.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * @param Raster* raster - The raster to draw into.
+ *
+ * @return int - 1 if the drawing was brought up to date, 0 if a full redraw is needed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int stackViewRasterDirty(StackView* view, Raster* raster);
+
+
+/**
+ * This function draws the labels of the stack frames inside of the viewport, next to them,
+ * with the layout they were last drawn with. Labels are only drawn while every frame is its own box,
+ * at least GLYPH_HEIGHT pixels tall, and not while the frames are drawn in proportion to their size.
+ *
+ * @param StackView* view - A pointer to the view, which has just been drawn.
+ *
+ * @param SDL_Renderer* renderer - The renderer to draw with.
+ *
+ * @param GlyphAtlas* atlas - The glyph atlas of the renderer.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewDrawLabels(StackView* view, SDL_Renderer* renderer, GlyphAtlas* atlas);
+
+
+/**
+ * This function draws the labels of the stack frames inside of the viewport into a software raster,
+ * exactly like stackViewDrawLabels() draws them onto a renderer, without a glyph atlas.
+ *
+ * @param StackView* view - A pointer to the view, which has just been drawn.
+ *
+ * @param Raster* raster - The raster to draw into. Its color is left white.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewRasterLabels(StackView* view, Raster* raster);
+
+
+/**
+ * This function makes the next drawing of the view a full one.
+ * It is called when the contents of the window were lost, for example when the window
+ * was resized or exposed, or the renderer lost its target textures.
+ *
+ * @param StackView* view - A pointer to the view.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void stackViewInvalidate(StackView* view);
+
+#endif /* RECURSION_VISUALIZED_STACKVIEW_H */
@@ -0,0 +1,462 @@
+/**
+ * @file    recursion_visualized_timeline.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the timeline functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), realloc(), free()
+#include <string.h>  // C strings - for memcpy(), memset()
+
+#include "recursion_visualized_timeline.h"
+
+
+/* The smallest a record can be in a trace file: the tag, the depth and the timestamp. */
+#define RECORD_MIN_BYTES 3
+
+
+/**
+ * The stack as the indexing thread keeps track of it: the colors of its frames and the stack use
+ * up to them, and the colors and sizes of the frames run-length encoded, which are kept up to date
+ * as the records are read, so that saving a checkpoint does not have to look at every frame of
+ * a deep stack again.
+ *
+ * @field Uint8* colors, Uint64* stack, Uint32 capacity - The colors of the frames, the stack use
+ *                  up to and including each of them, and the room for them.
+ *
+ * @field Uint32 depth - The depth of the stack.
+ *
+ * @field ColorRun* runs, Uint32 run_count, Uint32 run_capacity - The runs of colors and sizes,
+ *                  from the bottom of the stack up, and the room for them.
+ */
+typedef struct IndexStack {
+    Uint8*    colors;
+    Uint64*   stack;
+    Uint32    capacity;
+    Uint32    depth;
+    ColorRun* runs;
+    Uint32    run_count;
+    Uint32    run_capacity;
+} IndexStack;
+
+
+/**
+ * This function tells the size of a stack frame from the stack use up to it and up to the one below.
+ * The stack use only ever goes up with the depth, unless the runtime stack grows upwards, but the
+ * size is a difference either way, so the runs add back up to exactly the same stack use.
+ *
+ * @param const Uint64* stack - The stack use up to and including each frame.
+ *
+ * @param Uint32 i - The index of the frame.
+ *
+ * @return Uint64 - The size of the frame in bytes.
+ */
+static Uint64 frameBytes(const Uint64* stack, Uint32 i)
+{
+    return (i > 0) ? stack[i] - stack[i - 1] : stack[0];
+}
+
+
+/**
+ * This function appends one frame to the runs of colors and sizes of the stack.
+ *
+ * @param IndexStack* stack - A pointer to the stack.
+ *
+ * @param Uint8 color - The color of the frame.
+ *
+ * @param Uint64 bytes - The size of the frame.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int appendRun(IndexStack* stack, Uint8 color, Uint64 bytes)
+{
+    if (stack->run_count > 0 && stack->runs[stack->run_count - 1].color == color &&
+        stack->runs[stack->run_count - 1].bytes == bytes) {
+        ++stack->runs[stack->run_count - 1].length;
+        return 0;
+    }
+
+    if (stack->run_count == stack->run_capacity) {
+        Uint32    capacity = (stack->run_capacity > 0) ? stack->run_capacity * 2 : 16;
+        ColorRun* runs     = (ColorRun*) realloc(stack->runs, capacity * sizeof(ColorRun));
+        if (!runs) {
+            return -1;
+        }
+        stack->runs         = runs;
+        stack->run_capacity = capacity;
+    }
+
+    stack->runs[stack->run_count].bytes  = bytes;
+    stack->runs[stack->run_count].length = 1;
+    stack->runs[stack->run_count].color  = color;
+    ++stack->run_count;
+
+    return 0;
+}
+
+
+/**
+ * This function plays one push/pop record back into the stack, the same way the stack view does.
+ * Only the frames from the top down to the one the record is about ever change, so updating
+ * the runs takes constant time on average.
+ *
+ * @param IndexStack* stack - A pointer to the stack.
+ *
+ * @param const StackEvent* event - The record.
+ *
+ * @return int - 0 on success, -1 if the memory could not be allocated.
+ */
+static int applyRecord(IndexStack* stack, const StackEvent* event)
+{
+    Uint32 i = event->depth - 1;
+    Uint32 length;
+
+    if (event->depth > stack->capacity) {
+        Uint32  capacity = (stack->capacity * 2 > event->depth) ? stack->capacity * 2 : event->depth;
+        Uint8*  colors   = (Uint8*) realloc(stack->colors, capacity);
+        Uint64* used;
+        if (!colors) {
+            return -1;
+        }
+        stack->colors = colors;
+        used = (Uint64*) realloc(stack->stack, capacity * sizeof(Uint64));
+        if (!used) {
+            return -1;
+        }
+        stack->stack    = used;
+        stack->capacity = capacity;
+    }
+
+    // Cut the runs back to the frames below the one the record is about.
+    length = stack->depth;
+    while (stack->run_count > 0 && length - stack->runs[stack->run_count - 1].length >= i) {
+        length -= stack->runs[stack->run_count - 1].length;
+        --stack->run_count;
+    }
+    if (stack->run_count > 0 && length > i) {
+        stack->runs[stack->run_count - 1].length -= length - i;
+        length = i;
+    }
+
+    // Frames which the stack skipped over keep whatever color and size they had before.
+    for (; length < i; ++length) {
+        if (appendRun(stack, stack->colors[length], frameBytes(stack->stack, length)) != 0) {
+            return -1;
+        }
+    }
+
+    stack->colors[i] = event->color;
+    stack->stack[i]  = event->stack;
+    stack->depth     = event->depth;
+
+    return appendRun(stack, event->color, frameBytes(stack->stack, i));
+}
+
+
+/**
+ * This function saves a checkpoint of the stack. It is only called by the indexing thread.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * @param Uint32 index - The index of the new checkpoint.
+ *
+ * @param Uint64 step, Uint64 calls - The number of records and pushes so far.
+ *
+ * @param const IndexStack* stack - The stack.
+ *
+ * @return int - 0 on success, -1 if there is no room for the checkpoint.
+ */
+static int saveCheckpoint(Timeline* timeline, Uint32 index, Uint64 step, Uint64 calls,
+                          const IndexStack* stack)
+{
+    Checkpoint* checkpoint;
+
+    if (index >= timeline->capacity) {
+        return -1;
+    }
+
+    checkpoint = &timeline->checkpoints[index];
+    checkpoint->runs = NULL;
+    if (stack->run_count > 0) {
+        checkpoint->runs = (ColorRun*) malloc(stack->run_count * sizeof(ColorRun));
+        if (!checkpoint->runs) {
+            return -1;
+        }
+        memcpy(checkpoint->runs, stack->runs, stack->run_count * sizeof(ColorRun));
+    }
+
+    checkpoint->step      = step;
+    checkpoint->offset    = timeline->index_reader.offset;
+    checkpoint->last      = timeline->index_reader.last;
+    checkpoint->calls     = calls;
+    checkpoint->depth     = stack->depth;
+    checkpoint->run_count = stack->run_count;
+
+    // The checkpoint is complete before the main thread can see it.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&timeline->ready, (int) index + 1);
+
+    return 0;
+}
+
+
+/**
+ * This is the entry point of the indexing thread, as required by SDL_CreateThread().
+ *
+ * It reads through the whole trace file with its own reader, keeping track of the stack
+ * the same way the stack view does, and saves a checkpoint every TIMELINE_INTERVAL records.
+ *
+ * @param void* data - A pointer to the Timeline.
+ *
+ * @return int - 0 if the whole trace file was indexed, -1 otherwise.
+ */
+static int indexThread(void* data)
+{
+    Timeline*  timeline = (Timeline*) data;
+    IndexStack stack;
+    Uint32     saved    = 0;
+    Uint64     step     = 0;
+    Uint64     calls    = 0;
+    int        failed   = 0;
+    StackEvent event;
+
+    memset(&stack, 0, sizeof(stack));
+
+    failed = saveCheckpoint(timeline, saved++, step, calls, &stack);
+
+    while (!failed && !SDL_AtomicGet(&timeline->stop) && traceReaderNext(&timeline->index_reader, &event)) {
+        ++step;
+
+	// Like in the render loop, an EVENT_END record does not change the stack view.
+        if (event.type != EVENT_END) {
+            if (applyRecord(&stack, &event) != 0) {
+                failed = 1;
+                break;
+            }
+            if (event.type == EVENT_PUSH) {
+                ++calls;
+            }
+        }
+
+        if (step % TIMELINE_INTERVAL == 0 && saveCheckpoint(timeline, saved++, step, calls, &stack) != 0) {
+            failed = 1;
+        }
+    }
+
+    free(stack.colors);
+    free(stack.stack);
+    free(stack.runs);
+
+    // If the indexing had to stop early, the timeline ends at the last checkpoint.
+    if (failed || SDL_AtomicGet(&timeline->stop)) {
+        int ready = SDL_AtomicGet(&timeline->ready);
+        step = (ready > 0) ? timeline->checkpoints[ready - 1].step : 0;
+    }
+    timeline->length = step;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&timeline->done, 1);
+
+    return failed ? -1 : 0;
+}
+
+
+int timelineInit(Timeline* timeline, TraceReader* reader)
+{
+    Uint64 records = reader->count;
+
+    memset(timeline, 0, sizeof(*timeline));
+    timeline->reader       = reader;
+    timeline->tree_reader  = *reader;
+    timeline->index_reader = *reader;
+
+    // The header of a trace file which was cut short does not say how many records there are,
+    // so make room for as many as could possibly fit into it.
+    if (records == 0) {
+        records = (reader->size - reader->offset) / RECORD_MIN_BYTES;
+    }
+    timeline->capacity    = (Uint32) (records / TIMELINE_INTERVAL + 2);
+    timeline->checkpoints = (Checkpoint*) malloc(timeline->capacity * sizeof(Checkpoint));
+    if (!timeline->checkpoints) {
+        return -1;
+    }
+
+    SDL_AtomicSet(&timeline->ready, 0);
+    SDL_AtomicSet(&timeline->done, 0);
+    SDL_AtomicSet(&timeline->stop, 0);
+
+    timeline->thread = SDL_CreateThread(indexThread, "timeline", timeline);
+    if (!timeline->thread) {
+        free(timeline->checkpoints);
+        timeline->checkpoints = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void timelineDestroy(Timeline* timeline)
+{
+    int ready;
+    int i;
+
+    if (timeline->thread) {
+        SDL_AtomicSet(&timeline->stop, 1);
+        SDL_WaitThread(timeline->thread, NULL);
+        timeline->thread = NULL;
+    }
+
+    ready = SDL_AtomicGet(&timeline->ready);
+    for (i = 0; i < ready; ++i) {
+        free(timeline->checkpoints[i].runs);
+    }
+    free(timeline->checkpoints);
+    timeline->checkpoints = NULL;
+    SDL_AtomicSet(&timeline->ready, 0);
+}
+
+
+int timelineStep(Timeline* timeline, StackView* view, CallTree* tree, StackEvent* event)
+{
+    if (!traceReaderNext(timeline->reader, event)) {
+        return 0;
+    }
+
+    if (event->type != EVENT_END && stackViewApply(view, event) != 0) {
+        return -1;
+    }
+    if (tree && timeline->tree_step == timeline->step) {
+        if (callTreeApply(tree, event) != 0) {
+            return -1;
+        }
+        ++timeline->tree_step;
+    }
+    ++timeline->step;
+
+    return 1;
+}
+
+
+int timelineCatchUp(Timeline* timeline, CallTree* tree)
+{
+    StackEvent event;
+    Uint32     played = 0;
+
+    while (timeline->tree_step < timeline->step && played < TIMELINE_CATCH_UP &&
+           traceReaderNext(&timeline->tree_reader, &event)) {
+        if (callTreeApply(tree, &event) != 0) {
+            break;
+        }
+        ++timeline->tree_step;
+        ++played;
+    }
+
+    return played > 0;
+}
+
+
+Uint64 timelineEnd(Timeline* timeline)
+{
+    Uint64 end = 0;
+    int    ready;
+
+    if (SDL_AtomicGet(&timeline->done)) {
+        SDL_MemoryBarrierAcquire();
+        end = timeline->length;
+    } else {
+        ready = SDL_AtomicGet(&timeline->ready);
+        SDL_MemoryBarrierAcquire();
+        if (ready > 0) {
+            end = timeline->checkpoints[ready - 1].step;
+        }
+    }
+
+    // Wherever the playback already got to can be jumped back to as well.
+    return (end > timeline->step) ? end : timeline->step;
+}
+
+
+int timelineSeek(Timeline* timeline, StackView* view, CallTree* tree, Uint64 step)
+{
+    const Checkpoint* checkpoint;
+    StackEvent        event;
+    Uint64            end   = timelineEnd(timeline);
+    int               ready = SDL_AtomicGet(&timeline->ready);
+    int               low   = 0;
+    int               high;
+    Uint32            frame = 0;
+    Uint64            used  = 0;
+    Uint32            run;
+
+    SDL_MemoryBarrierAcquire();
+    if (ready == 0) {
+        return 0;
+    }
+    if (step > end) {
+        step = end;
+    }
+
+    // Binary search for the last checkpoint at or before the step.
+    high = ready - 1;
+    while (low < high) {
+        int middle = low + (high - low + 1) / 2;
+        if (timeline->checkpoints[middle].step <= step) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    checkpoint = &timeline->checkpoints[low];
+
+    // The call tree has already seen the checkpoint, so it is wound back to it.
+    // If it merged the calls from before the checkpoint, it starts over and catches up from the start.
+    // Otherwise it keeps catching up from wherever it was.
+    if (timeline->tree_step >= checkpoint->step) {
+        if (callTreeRewind(tree, checkpoint->calls, &checkpoint->last) == 0) {
+            timeline->tree_step = checkpoint->step;
+        } else {
+            callTreeClear(tree);
+            timeline->tree_reader = *timeline->reader;
+            traceReaderSeek(&timeline->tree_reader, timeline->checkpoints[0].offset, &timeline->checkpoints[0].last);
+            timeline->tree_step = 0;
+        }
+    } else if (timeline->tree_step == timeline->step) {
+        timeline->tree_reader = *timeline->reader;
+    }
+
+    // Restore the stack from the checkpoint.
+    if (stackViewResize(view, checkpoint->depth) != 0) {
+        return -1;
+    }
+    for (run = 0; run < checkpoint->run_count; ++run) {
+        const ColorRun* current = &checkpoint->runs[run];
+        Uint32          end     = frame + current->length;
+
+        memset(view->colors + frame, current->color, current->length);
+        for (; frame < end; ++frame) {
+            used += current->bytes;
+            view->stack[frame] = used;
+        }
+    }
+    view->address = checkpoint->last.address;
+    traceReaderSeek(timeline->reader, checkpoint->offset, &checkpoint->last);
+    timeline->step = checkpoint->step;
+
+    // And play back the few records between the checkpoint and the step.
+    while (timeline->step < step) {
+        int played = timelineStep(timeline, view, tree, &event);
+        if (played <= 0) {
+            return played;
+        }
+    }
+
+    return 0;
+}
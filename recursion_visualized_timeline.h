@@ -0,0 +1,247 @@
+/**
+ * @file    recursion_visualized_timeline.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the timeline, which lets a replayed trace file
+ * jump to any step, backwards as well as forwards, instead of only playing it from the start.
+ *
+ * While the trace file is being replayed, a background thread reads through the whole of it
+ * once, and every TIMELINE_INTERVAL records it saves a checkpoint: where in the file it is,
+ * and the whole runtime stack at that step. The colors and the sizes of the stack frames come
+ * in long runs, so they are saved run-length encoded, which takes a few bytes even for a stack
+ * millions of frames deep. The checkpoints are ordered by step, so a jump binary searches them for the last
+ * one before the step, restores the stack from it, and plays back at most TIMELINE_INTERVAL
+ * records from there. A jump therefore takes the same short time however long the trace is.
+ *
+ * The call tree is wound back in place when jumping backwards. When jumping forwards,
+ * past calls it has not seen yet, it catches up over the next frames instead.
+ * While the call tree is not shown, it is not played back into at all, and falls behind
+ * the same way, so a replay that never shows it never spends memory on it.
+ */
+
+#ifndef RECURSION_VISUALIZED_TIMELINE_H
+#define RECURSION_VISUALIZED_TIMELINE_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_ring.h"       // StackEvent
+#include "recursion_visualized_stackview.h"  // StackView
+#include "recursion_visualized_calltree.h"   // CallTree
+#include "recursion_visualized_tracefile.h"  // TraceReader
+
+
+/* The number of records between two checkpoints, which is the most a jump plays back. */
+#define TIMELINE_INTERVAL 4096
+
+/* The most records the call tree catches up by in one frame, after a jump forwards. */
+#define TIMELINE_CATCH_UP 262144
+
+
+/**
+ * A run of stack frames of the same color and size.
+ *
+ * @field Uint64 bytes - The size of each of the stack frames on the runtime stack, in bytes.
+ *
+ * @field Uint32 length - The number of stack frames.
+ *
+ * @field Uint8 color - Their color code.
+ */
+typedef struct ColorRun {
+    Uint64 bytes;
+    Uint32 length;
+    Uint8  color;
+} ColorRun;
+
+
+/**
+ * A checkpoint of the timeline.
+ *
+ * @field Uint64 step - The number of records played back before the checkpoint.
+ *
+ * @field size_t offset - Where the next record starts in the trace file.
+ *
+ * @field StackEvent last - The record just before the checkpoint.
+ *
+ * @field Uint64 calls - The number of pushes before the checkpoint.
+ *
+ * @field Uint32 depth - The depth of the stack at the checkpoint.
+ *
+ * @field ColorRun* runs, Uint32 run_count - The colors and sizes of the stack frames, from the bottom up.
+ */
+typedef struct Checkpoint {
+    Uint64     step;
+    size_t     offset;
+    StackEvent last;
+    Uint64     calls;
+    Uint32     depth;
+    Uint32     run_count;
+    ColorRun*  runs;
+} Checkpoint;
+
+
+/**
+ * The timeline of a trace file.
+ *
+ * @field TraceReader* reader - The reader the records are played back from.
+ *
+ * @field Uint64 step - The number of records played back into the stack view so far.
+ *
+ * @field TraceReader tree_reader, Uint64 tree_step - Where the call tree is, while it is
+ *                    catching up after a jump forwards. It is caught up when tree_step == step.
+ *
+ * @field TraceReader index_reader - Where the indexing thread is in the trace file.
+ *
+ * @field Checkpoint* checkpoints, Uint32 capacity - The checkpoints, and the room for them.
+ *                    The room is allocated up front, so the indexing thread never moves them.
+ *
+ * @field SDL_atomic_t ready - How many checkpoints the indexing thread has finished.
+ *
+ * @field SDL_atomic_t done - Nonzero once the indexing thread has read the whole trace file.
+ *
+ * @field SDL_atomic_t stop - Tells the indexing thread to stop early.
+ *
+ * @field Uint64 length - The number of records in the trace file, once done is set.
+ *
+ * @field SDL_Thread* thread - The indexing thread.
+ */
+typedef struct Timeline {
+    TraceReader* reader;
+    Uint64       step;
+    TraceReader  tree_reader;
+    Uint64       tree_step;
+    TraceReader  index_reader;
+    Checkpoint*  checkpoints;
+    Uint32       capacity;
+    SDL_atomic_t ready;
+    SDL_atomic_t done;
+    SDL_atomic_t stop;
+    Uint64       length;
+    SDL_Thread*  thread;
+} Timeline;
+
+
+/**
+ * This function sets up the timeline of a trace file which was just opened,
+ * and starts the thread which indexes it in the background.
+ *
+ * @param Timeline* timeline - A pointer to the timeline to initialize.
+ *
+ * @param TraceReader* reader - The reader the trace file is played back from.
+ *                              It must still be at the first record.
+ *
+ * @return int - 0 on success, -1 if the memory or the thread could not be had.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int timelineInit(Timeline* timeline, TraceReader* reader);
+
+
+/**
+ * This function stops the indexing thread and deallocates the checkpoints.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void timelineDestroy(Timeline* timeline);
+
+
+/**
+ * This function plays the next record of the trace file back into the stack view,
+ * and into the call tree unless it is still catching up.
+ * Like in the live render loop, an EVENT_END record is played back into the call tree only.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree, or NULL while it is not shown, which leaves it behind.
+ *
+ * @param StackEvent* event - Receives the record.
+ *
+ * @return int - 1 if a record was played back, 0 at the end of the trace file,
+ *               -1 if the memory for a deeper stack or more calls could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int timelineStep(Timeline* timeline, StackView* view, CallTree* tree, StackEvent* event);
+
+
+/**
+ * This function lets the call tree catch up on at most TIMELINE_CATCH_UP of the records
+ * it skipped over when the timeline jumped forwards.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * @param CallTree* tree - The call tree.
+ *
+ * @return int - Nonzero if the call tree changed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int timelineCatchUp(Timeline* timeline, CallTree* tree);
+
+
+/**
+ * This function tells how far the timeline can jump right now: to the end of the trace file
+ * once it has been indexed, and otherwise as far as it has been indexed so far.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * @return Uint64 - The last step that can be jumped to.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+Uint64 timelineEnd(Timeline* timeline);
+
+
+/**
+ * This function jumps to the given step of the trace file: the stack view shows the stack
+ * as it was after that many records. The stack view is redrawn in full the next time.
+ *
+ * @param Timeline* timeline - A pointer to the timeline.
+ *
+ * @param StackView* view - The stack view.
+ *
+ * @param CallTree* tree - The call tree.
+ *
+ * @param Uint64 step - The step to jump to. It is clamped to timelineEnd().
+ *
+ * @return int - 0 on success, -1 if the memory for a deeper stack could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int timelineSeek(Timeline* timeline, StackView* view, CallTree* tree, Uint64 step);
+
+#endif /* RECURSION_VISUALIZED_TIMELINE_H */
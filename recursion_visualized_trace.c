@@ -0,0 +1,111 @@
+/**
+ * @file    recursion_visualized_trace.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the recursion tracing functions,
+ * and the hooks called by code compiled with -finstrument-functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdlib.h>  // C standard library - for malloc(), free()
+#include <stddef.h>  // C standard definitions - for NULL
+
+#include "recursion_visualized_trace.h"
+
+
+/* The trace that the -finstrument-functions hooks record into, or NULL. */
+static Tracer* active_tracer = NULL;
+
+
+int tracerInit(Tracer* tracer, Uint64 capacity, EventRing* ring)
+{
+    tracer->events = NULL;
+    if (capacity > 0) {
+        tracer->events = (StackEvent*) malloc(capacity * sizeof(StackEvent));
+        if (!tracer->events) {
+            return -1;
+        }
+    }
+
+    tracer->capacity      = capacity;
+    tracer->count         = 0;
+    tracer->dropped       = 0;
+    tracer->depth         = 0;
+    tracer->ring          = ring;
+    tracer->start_ticks   = traceTicks();
+    tracer->start_counter = SDL_GetPerformanceCounter();
+    tracer->stack_base    = 0;
+    tracer->peak          = 0;
+    tracer->memo          = NULL;
+
+    return 0;
+}
+
+
+void tracerDestroy(Tracer* tracer)
+{
+    if (active_tracer == tracer) {
+        active_tracer = NULL;
+    }
+
+    free(tracer->events);
+    tracer->events   = NULL;
+    tracer->capacity = 0;
+    tracer->count    = 0;
+}
+
+
+void traceForward(Tracer* tracer, const StackEvent* event)
+{
+    ringPush(tracer->ring, event);
+}
+
+
+double traceTicksPerSecond(const Tracer* tracer)
+{
+    Uint64 ticks   = traceTicks() - tracer->start_ticks;
+    Uint64 counter = SDL_GetPerformanceCounter() - tracer->start_counter;
+
+    // Too little time has passed to measure anything.
+    if (counter == 0 || ticks == 0) {
+        return (double) SDL_GetPerformanceFrequency();
+    }
+
+    return (double) ticks * SDL_GetPerformanceFrequency() / counter;
+}
+
+
+void traceSetActive(Tracer* tracer)
+{
+    active_tracer = tracer;
+}
+
+
+/* The hooks must not be instrumented themselves, or they would call themselves forever. */
+void __cyg_profile_func_enter(void* function, void* call_site) __attribute__((no_instrument_function));
+void __cyg_profile_func_exit(void* function, void* call_site) __attribute__((no_instrument_function));
+
+
+void __cyg_profile_func_enter(void* function, void* call_site)
+{
+    if (active_tracer) {
+        traceRecord(active_tracer, EVENT_PUSH, FUNCTION_INSTRUMENTED,
+                    (Sint64) (size_t) function, (Sint64) (size_t) call_site, 0);
+    }
+}
+
+
+void __cyg_profile_func_exit(void* function, void* call_site)
+{
+    if (active_tracer) {
+        traceRecord(active_tracer, EVENT_POP, FUNCTION_INSTRUMENTED,
+                    (Sint64) (size_t) function, (Sint64) (size_t) call_site, 0);
+    }
+}
@@ -0,0 +1,452 @@
+/**
+ * @file    recursion_visualized_trace.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the recursion tracing API, which lets any recursive
+ * function be visualized, not only bunny().
+ *
+ * A traced function calls TRACE_ENTER() as its first statement and TRACE_EXIT() just before
+ * every return. Each of them records one StackEvent, with the arguments of the call and a
+ * timestamp, into a preallocated buffer of the Tracer. Recording is inlined and costs a few
+ * nanoseconds, so tracing can be left on for benchmarks. If the Tracer is given a ring buffer,
+ * every record is also forwarded into it, and the render loop animates the trace with drawStack().
+ *
+ * Every record also carries the address of the stack frame of the traced call, and how many
+ * bytes of the runtime stack are in use up to it, so the real sizes of the frames can be drawn.
+ * A function which keeps its frames on a stack of its own instead, like the iterative versions
+ * of the examples, records them with traceRecordFrame(), with their addresses and sizes there.
+ *
+ *     Sint64 factorial(Tracer* tracer, Sint64 n)
+ *     {
+ *         Sint64 result;
+ *
+ *         TRACE_ENTER(tracer, FUNCTION_FACTORIAL, n, 0, 0);
+ *         result = (n <= 1) ? 1 : n * factorial(tracer, n - 1);
+ *         TRACE_EXIT(tracer, FUNCTION_FACTORIAL, n, 0, 0);
+ *
+ *         return result;
+ *     }
+ *
+ * A traced function whose result only depends on its arguments can also look its calls up in
+ * a memoization cache, see recursion_visualized_memo.h, if the Tracer is given one. It calls
+ * TRACE_MEMO_HIT() before TRACE_ENTER(), and returns right away if the result was found,
+ * and TRACE_MEMO_STORE() before TRACE_EXIT(). Without a cache, both of them do nothing.
+ *
+ *     Sint64 fibonacci(Tracer* tracer, Sint64 n)
+ *     {
+ *         Sint64 result;
+ *
+ *         if (TRACE_MEMO_HIT(tracer, FUNCTION_FIBONACCI, n, 0, 0, &result)) {
+ *             return result;
+ *         }
+ *         TRACE_ENTER(tracer, FUNCTION_FIBONACCI, n, 0, 0);
+ *         result = (n < 2) ? n : fibonacci(tracer, n - 1) + fibonacci(tracer, n - 2);
+ *         TRACE_MEMO_STORE(tracer, FUNCTION_FIBONACCI, n, 0, 0, result);
+ *         TRACE_EXIT(tracer, FUNCTION_FIBONACCI, n, 0, 0);
+ *
+ *         return result;
+ *     }
+ *
+ * Code which cannot be edited can be traced by compiling it with -finstrument-functions.
+ * GCC and Clang then call the hooks defined in recursion_visualized_trace.c on entrance into
+ * and exit out of every function, which record FUNCTION_INSTRUMENTED events into the Tracer
+ * given to traceSetActive(). Their first argument is the address of the function,
+ * and the second one the address it was called from. Their stack frame addresses are the ones
+ * of the hooks, which sit right below the frames of the instrumented functions, so the
+ * differences between them are still the sizes of those frames.
+ * runExample() traces triangular() from recursion_visualized_instrumented.c this way,
+ * which the Makefile compiles with -finstrument-functions.
+ */
+
+#ifndef RECURSION_VISUALIZED_TRACE_H
+#define RECURSION_VISUALIZED_TRACE_H
+
+#include "SDL.h"  // Simple DirectMedia Layer API structures and functions
+
+#include "recursion_visualized_header.h"  // LIME, PINK, CYAN
+#include "recursion_visualized_ring.h"    // StackEvent, EventRing
+#include "recursion_visualized_memo.h"    // Memo, memoFind(), memoStore()
+
+
+/* These constants identify the recursive functions that records come from. */
+#define FUNCTION_BUNNY        0
+#define FUNCTION_FACTORIAL    1
+#define FUNCTION_FIBONACCI    2
+#define FUNCTION_HANOI        3
+#define FUNCTION_QUICKSORT    4
+#define FUNCTION_ACKERMANN    5
+#define FUNCTION_MERGESORT    6
+#define FUNCTION_COUNT        7
+#define FUNCTION_INSTRUMENTED 0xFFFF  // recorded by the -finstrument-functions hooks
+
+
+/**
+ * Records the entrance into a traced recursive function.
+ * Unused arguments should be passed as 0.
+ */
+#define TRACE_ENTER(tracer, function, a0, a1, a2) \
+    traceRecord((tracer), EVENT_PUSH, (function), (Sint64) (a0), (Sint64) (a1), (Sint64) (a2))
+
+/**
+ * Records the exit out of a traced recursive function.
+ * It must be given the same arguments as the matching TRACE_ENTER().
+ */
+#define TRACE_EXIT(tracer, function, a0, a1, a2) \
+    traceRecord((tracer), EVENT_POP, (function), (Sint64) (a0), (Sint64) (a1), (Sint64) (a2))
+
+/**
+ * Looks the call up in the memoization cache of the tracer, if it has one, and stores
+ * the result into *result if it was found. A call which was found is recorded as a push
+ * and a pop in CYAN, and the traced function should return right away, without TRACE_ENTER().
+ * It evaluates to nonzero if the call was found.
+ */
+#define TRACE_MEMO_HIT(tracer, function, a0, a1, a2, result)                                  \
+    ((tracer)->memo &&                                                                        \
+     memoFind((tracer)->memo, (function), (Sint64) (a0), (Sint64) (a1), (Sint64) (a2), (result)) && \
+     (traceRecordHit((tracer), (function), (Sint64) (a0), (Sint64) (a1), (Sint64) (a2)), 1))
+
+/**
+ * Stores the result of the call into the memoization cache of the tracer, if it has one.
+ * It must be given the same arguments as the matching TRACE_MEMO_HIT().
+ */
+#define TRACE_MEMO_STORE(tracer, function, a0, a1, a2, result)                                 \
+    do {                                                                                       \
+        if ((tracer)->memo) {                                                                  \
+            memoStore((tracer)->memo, (function), (Sint64) (a0), (Sint64) (a1), (Sint64) (a2), \
+                      (Sint64) (result));                                                      \
+        }                                                                                      \
+    } while (0)
+
+
+/**
+ * The state of one trace.
+ *
+ * @field StackEvent* events - The preallocated buffer the records are stored in, or NULL.
+ *
+ * @field Uint64 capacity - How many records fit into events.
+ *
+ * @field Uint64 count - How many records have been stored in events.
+ *
+ * @field Uint64 dropped - How many records did not fit into events and were not forwarded either.
+ *
+ * @field Uint32 depth - How many traced stack frames are on the runtime stack right now.
+ *
+ * @field EventRing* ring - If not NULL, every record is also forwarded into this ring buffer.
+ *
+ * @field Uint64 start_ticks, start_counter - traceTicks() and SDL_GetPerformanceCounter()
+ *                  when the trace began, used to convert ticks into seconds.
+ *
+ * @field Uint64 stack_base - Where the runtime stack of the trace starts, which the stack use of
+ *                  every record counts from. It is the frame address of the first traced call,
+ *                  so only the return address and the saved frame pointer of that call are left out.
+ *                  0 until the first call.
+ *
+ * @field Uint64 peak - The most bytes of the stack any record had in use.
+ *
+ * @field Memo* memo - The memoization cache that TRACE_MEMO_HIT() looks the calls up in, or NULL.
+ */
+typedef struct Tracer {
+    StackEvent* events;
+    Uint64      capacity;
+    Uint64      count;
+    Uint64      dropped;
+    Uint32      depth;
+    EventRing*  ring;
+    Uint64      start_ticks;
+    Uint64      start_counter;
+    Uint64      stack_base;
+    Uint64      peak;
+    Memo*       memo;
+} Tracer;
+
+
+/**
+ * This function reads the cheapest clock available.
+ * On x86 that is the time stamp counter of the CPU, which takes a handful of cycles to read.
+ * Elsewhere it is SDL_GetPerformanceCounter().
+ *
+ * @return Uint64 - The current time in ticks. traceTicksPerSecond() converts them to seconds.
+ */
+SDL_FORCE_INLINE Uint64 traceTicks(void)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_ia32_rdtsc();
+#else
+    return SDL_GetPerformanceCounter();
+#endif
+}
+
+
+/**
+ * This function reads the address of the stack frame of the function it is inlined into.
+ * With GCC and Clang that is the frame pointer, which points at the top of the frame,
+ * just below the return address. Elsewhere it is the address of a local variable,
+ * which is inside of the same stack frame.
+ *
+ * @return Uint64 - The address of the stack frame.
+ */
+SDL_FORCE_INLINE Uint64 traceFrameAddress(void)
+{
+#if defined(__GNUC__)
+    return (Uint64) (size_t) __builtin_frame_address(0);
+#else
+    volatile char marker = 0;
+    return (Uint64) (size_t) &marker;
+#endif
+}
+
+
+/**
+ * This function reads the stack pointer of the function it is inlined into,
+ * which points at the bottom of its stack frame, where the frames of its callees start.
+ * Where it cannot be read directly, the frame address has to do.
+ *
+ * @return Uint64 - The stack pointer.
+ */
+SDL_FORCE_INLINE Uint64 traceStackPointer(void)
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+    Uint64 pointer;
+    __asm__ __volatile__ ("movq %%rsp, %0" : "=r" (pointer));
+    return pointer;
+#elif defined(__GNUC__) && defined(__i386__)
+    Uint32 pointer;
+    __asm__ __volatile__ ("movl %%esp, %0" : "=r" (pointer));
+    return pointer;
+#elif defined(__GNUC__) && defined(__aarch64__)
+    Uint64 pointer;
+    __asm__ __volatile__ ("mov %0, sp" : "=r" (pointer));
+    return pointer;
+#else
+    return traceFrameAddress();
+#endif
+}
+
+
+/**
+ * This function computes how many bytes of the runtime stack are in use between two addresses.
+ * The stack grows downwards on nearly every machine, but it is allowed to grow upwards as well.
+ *
+ * @param Uint64 base - Where the stack starts.
+ *
+ * @param Uint64 pointer - The stack pointer of a function, as given by traceStackPointer().
+ *
+ * @return Uint64 - The number of bytes between them.
+ */
+SDL_FORCE_INLINE Uint64 traceStackUsed(Uint64 base, Uint64 pointer)
+{
+    return (base >= pointer) ? base - pointer : pointer - base;
+}
+
+
+/**
+ * This function forwards one record into the ring buffer of the Tracer.
+ * It is kept out of line, so that the inlined traceRecord() stays small.
+ *
+ * @param Tracer* tracer - The trace whose ring buffer receives the record.
+ *
+ * @param const StackEvent* event - The record to forward.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void traceForward(Tracer* tracer, const StackEvent* event);
+
+
+/**
+ * This function records one push or pop of a stack frame at a given address into the Tracer.
+ *
+ * @param Tracer* tracer - The trace to record into.
+ *
+ * @param Uint8 type - EVENT_PUSH or EVENT_POP.
+ *
+ * @param Uint16 function - Which function is recording.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ *
+ * @param Uint64 address - The address of the stack frame.
+ *
+ * @param Uint64 stack - How many bytes of the stack are in use up to and including the frame.
+ *
+ * @param Uint8 color - The color code to draw the stack frame in, usually LIME for a push and PINK for a pop.
+ */
+SDL_FORCE_INLINE void traceRecordFrame(Tracer* tracer, Uint8 type, Uint16 function,
+                                       Sint64 a0, Sint64 a1, Sint64 a2, Uint64 address, Uint64 stack,
+                                       Uint8 color)
+{
+    StackEvent  scratch;
+    StackEvent* event;
+
+    if (type == EVENT_PUSH) {
+        ++tracer->depth;
+    }
+    if (stack > tracer->peak) {
+        tracer->peak = stack;
+    }
+
+    // Store the record in the buffer if there is room, otherwise only forward it.
+    if (tracer->count < tracer->capacity) {
+        event = &tracer->events[tracer->count++];
+    } else {
+        event = &scratch;
+        if (!tracer->ring) {
+            ++tracer->dropped;
+        }
+    }
+
+    event->ticks    = traceTicks();
+    event->address  = address;
+    event->stack    = stack;
+    event->args[0]  = a0;
+    event->args[1]  = a1;
+    event->args[2]  = a2;
+    event->depth    = tracer->depth;
+    event->function = function;
+    event->type     = type;
+    event->color    = color;
+
+    // The same layout as bunny() uses: 50 by 50 boxes stacked up from the bottom of the window.
+    event->rect.x = 125;
+    event->rect.y = 590 - 50 * ((int) tracer->depth - 1);
+    event->rect.w = 50;
+    event->rect.h = 50;
+
+    if (tracer->ring) {
+        traceForward(tracer, event);
+    }
+
+    if (type == EVENT_POP) {
+        --tracer->depth;
+    }
+}
+
+
+/**
+ * This function records one push or pop into the Tracer. It is what TRACE_ENTER() and
+ * TRACE_EXIT() expand to, and it is inlined into the traced function, whose stack frame
+ * on the runtime stack is recorded.
+ *
+ * @param Tracer* tracer - The trace to record into.
+ *
+ * @param Uint8 type - EVENT_PUSH or EVENT_POP.
+ *
+ * @param Uint16 function - Which recursive function is recording.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ */
+SDL_FORCE_INLINE void traceRecord(Tracer* tracer, Uint8 type, Uint16 function,
+                                  Sint64 a0, Sint64 a1, Sint64 a2)
+{
+    if (type == EVENT_PUSH && tracer->stack_base == 0) {
+        tracer->stack_base = traceFrameAddress();
+    }
+
+    traceRecordFrame(tracer, type, function, a0, a1, a2, traceFrameAddress(),
+                     traceStackUsed(tracer->stack_base, traceStackPointer()), (type == EVENT_PUSH) ? LIME : PINK);
+}
+
+
+/**
+ * This function records a call which was answered from the memoization cache, as a push
+ * and a pop in CYAN right after each other. It is what TRACE_MEMO_HIT() expands to on a hit,
+ * and it is inlined into the traced function, whose stack frame on the runtime stack is recorded.
+ *
+ * @param Tracer* tracer - The trace to record into.
+ *
+ * @param Uint16 function - Which recursive function is recording.
+ *
+ * @param Sint64 a0, a1, a2 - The arguments of the call.
+ */
+SDL_FORCE_INLINE void traceRecordHit(Tracer* tracer, Uint16 function, Sint64 a0, Sint64 a1, Sint64 a2)
+{
+    Uint64 address;
+    Uint64 stack;
+
+    if (tracer->stack_base == 0) {
+        tracer->stack_base = traceFrameAddress();
+    }
+    address = traceFrameAddress();
+    stack   = traceStackUsed(tracer->stack_base, traceStackPointer());
+
+    traceRecordFrame(tracer, EVENT_PUSH, function, a0, a1, a2, address, stack, CYAN);
+    traceRecordFrame(tracer, EVENT_POP, function, a0, a1, a2, address, stack, CYAN);
+}
+
+
+/**
+ * This function sets up a trace and starts its clock.
+ *
+ * @param Tracer* tracer - A pointer to the trace to initialize.
+ *
+ * @param Uint64 capacity - How many records to preallocate room for. It may be 0
+ *                          if the records only need to be forwarded into the ring buffer.
+ *
+ * @param EventRing* ring - The ring buffer to forward every record into, or NULL.
+ *
+ * @return int - 0 on success, -1 if the buffer could not be allocated.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int tracerInit(Tracer* tracer, Uint64 capacity, EventRing* ring);
+
+
+/**
+ * This function deallocates the buffer of a trace.
+ *
+ * @param Tracer* tracer - A pointer to the trace.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void tracerDestroy(Tracer* tracer);
+
+
+/**
+ * This function measures how many traceTicks() there are in a second, by comparing them
+ * against SDL_GetPerformanceCounter() over the time since the trace began.
+ * The longer the trace has been running, the more precise the answer.
+ *
+ * @param const Tracer* tracer - A pointer to the trace.
+ *
+ * @return double - The number of ticks per second.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+double traceTicksPerSecond(const Tracer* tracer);
+
+
+/**
+ * This function picks the trace that the -finstrument-functions hooks record into.
+ *
+ * @param Tracer* tracer - The trace, or NULL to stop recording.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void traceSetActive(Tracer* tracer);
+
+#endif /* RECURSION_VISUALIZED_TRACE_H */
@@ -0,0 +1,516 @@
+/**
+ * @file    recursion_visualized_tracefile.c
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the definitions of the trace file functions.
+ */
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for fopen(), fwrite(), fseek(), fclose()
+#include <string.h>  // C strings - for memcmp(), memcpy(), memset()
+
+#include <fcntl.h>     // POSIX - for open()
+#include <unistd.h>    // POSIX - for close()
+#include <sys/mman.h>  // POSIX - for mmap(), munmap(), madvise()
+#include <sys/stat.h>  // POSIX - for fstat()
+
+#include "recursion_visualized_tracefile.h"
+#include "recursion_visualized_header.h"  // LIME, PINK, GOLD, CYAN
+
+
+/* The magic bytes at the start of every trace file. */
+static const char TRACE_FILE_MAGIC[8] = { 'R', 'V', 'T', 'R', 'A', 'C', 'E', '\0' };
+
+/* The bits of the tag byte of a record. */
+#define TAG_TYPE_MASK      0x03
+#define TAG_COLOR_SHIFT    2
+#define TAG_COLOR_MASK     0x03
+#define TAG_FUNCTION       0x10
+#define TAG_ARGS_SHIFT     5
+#define TAG_ARGS_MASK      0x03
+#define TAG_MASK           0x80
+
+/* The bits of the mask byte of a record, after the four rectangle fields. */
+#define MASK_ADDRESS       0x10
+#define MASK_STACK         0x20
+#define MASK_COLOR_HIGH    0x40
+
+/* The colors of the records, by their color index. The first four fit into the tag alone,
+   which is all there is room for in versions 1 and 2. */
+static const Uint8 TAG_COLORS[] = { 0, LIME, PINK, CYAN, GOLD };
+#define TAG_COLOR_COUNT    ((int) (sizeof(TAG_COLORS) / sizeof(TAG_COLORS[0])))
+
+/* The oldest version of the trace file format that can still be read. Version 1 has no stack
+   frame addresses, which is the same as a later file in which they never change, and version 2
+   has no GOLD, which is the same as a version 3 file without it. */
+#define TRACE_FILE_VERSION_MIN 1
+
+/* The records already played back are dropped from memory in chunks of this many bytes. */
+#define RELEASE_CHUNK_BYTES (16 * 1024 * 1024)
+
+
+/**
+ * These functions convert between signed numbers and their zigzag encoding.
+ */
+static Uint64 zigzagEncode(Sint64 value)
+{
+    return ((Uint64) value << 1) ^ (Uint64) (value >> 63);
+}
+
+static Sint64 zigzagDecode(Uint64 value)
+{
+    return (Sint64) (value >> 1) ^ -(Sint64) (value & 1);
+}
+
+
+/**
+ * This function stores a varint into a buffer.
+ *
+ * @param Uint8* buffer - Where to store it. There must be room for 10 bytes.
+ *
+ * @param Uint64 value - The number to store.
+ *
+ * @return size_t - How many bytes were stored.
+ */
+static size_t putVarint(Uint8* buffer, Uint64 value)
+{
+    size_t size = 0;
+
+    while (value >= 0x80) {
+        buffer[size++] = (Uint8) (value | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = (Uint8) value;
+
+    return size;
+}
+
+
+/**
+ * This function loads a varint out of a buffer of records.
+ *
+ * @param const Uint8* data, size_t size - The buffer, and its size in bytes.
+ *
+ * @param size_t* offset - Where the varint starts. It is moved past the varint.
+ *
+ * @param Uint64* value - Receives the number.
+ *
+ * @return int - 1 on success, 0 if the varint runs past the end of the buffer or is too long.
+ */
+static int getVarint(const Uint8* data, size_t size, size_t* offset, Uint64* value)
+{
+    Uint64 result = 0;
+    int    shift;
+
+    for (shift = 0; shift < 64 && *offset < size; shift += 7) {
+        Uint8 byte = data[(*offset)++];
+
+        result |= (Uint64) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * These functions store and load little-endian numbers of the header.
+ */
+static void putLittleEndian(Uint8* buffer, Uint64 value, int bytes)
+{
+    int i;
+
+    for (i = 0; i < bytes; ++i) {
+        buffer[i] = (Uint8) (value >> (8 * i));
+    }
+}
+
+static Uint64 getLittleEndian(const Uint8* buffer, int bytes)
+{
+    Uint64 value = 0;
+    int    i;
+
+    for (i = 0; i < bytes; ++i) {
+        value |= (Uint64) buffer[i] << (8 * i);
+    }
+
+    return value;
+}
+
+
+/**
+ * This function puts together the header of a trace file.
+ *
+ * @param Uint8* header - Receives the TRACE_FILE_HEADER_SIZE bytes of the header.
+ *
+ * @param Uint32 max_depth, Uint64 count - What the header says about the records.
+ */
+static void makeHeader(Uint8* header, Uint32 max_depth, Uint64 count)
+{
+    memcpy(header, TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+    putLittleEndian(header + 8, TRACE_FILE_VERSION, 4);
+    putLittleEndian(header + 12, max_depth, 4);
+    putLittleEndian(header + 16, count, 8);
+}
+
+
+int traceWriterOpen(TraceWriter* writer, const char* path)
+{
+    Uint8 header[TRACE_FILE_HEADER_SIZE];
+
+    memset(writer, 0, sizeof(*writer));
+
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        return -1;
+    }
+
+    // The header says 0 records until the recording is finished, so a trace file
+    // which was cut short can be told apart from a complete one.
+    makeHeader(header, 0, 0);
+    if (fwrite(header, sizeof(header), 1, writer->file) != 1) {
+        writer->failed = 1;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * This function finds the color index of a color.
+ *
+ * @param Uint8 color - LIME, PINK, GOLD, CYAN or 0.
+ *
+ * @return int - The index of the color in TAG_COLORS, or 0 for a color which is not there.
+ */
+static int colorIndex(Uint8 color)
+{
+    int index;
+
+    for (index = 1; index < TAG_COLOR_COUNT; ++index) {
+        if (TAG_COLORS[index] == color) {
+            return index;
+        }
+    }
+
+    return 0;
+}
+
+
+size_t traceEncode(Uint8* record, const StackEvent* event, const StackEvent* last)
+{
+    size_t size = 0;
+    Uint8  tag;
+    int    color;
+    Uint8  mask = 0;
+    int    args = STACK_EVENT_ARGS;
+    int    i;
+    Sint64 rect_delta[4];
+
+    // Only the leading arguments that changed are stored.
+    while (args > 0 && event->args[args - 1] == last->args[args - 1]) {
+        --args;
+    }
+
+    rect_delta[0] = (Sint64) event->rect.x - last->rect.x;
+    rect_delta[1] = (Sint64) event->rect.y - last->rect.y;
+    rect_delta[2] = (Sint64) event->rect.w - last->rect.w;
+    rect_delta[3] = (Sint64) event->rect.h - last->rect.h;
+    for (i = 0; i < 4; ++i) {
+        if (rect_delta[i] != 0) {
+            mask |= (Uint8) (1 << i);
+        }
+    }
+    if (event->address != last->address) {
+        mask |= MASK_ADDRESS;
+    }
+    if (event->stack != last->stack) {
+        mask |= MASK_STACK;
+    }
+
+    // The colors past the ones which fit into the tag also set the high bit of the index in the mask.
+    color = colorIndex(event->color);
+    if (color > TAG_COLOR_MASK) {
+        mask |= MASK_COLOR_HIGH;
+    }
+    tag = (Uint8) ((event->type & TAG_TYPE_MASK) | ((color & TAG_COLOR_MASK) << TAG_COLOR_SHIFT) |
+                   (args << TAG_ARGS_SHIFT));
+    if (event->function != last->function) {
+        tag |= TAG_FUNCTION;
+    }
+    if (mask) {
+        tag |= TAG_MASK;
+    }
+
+    record[size++] = tag;
+    if (mask) {
+        record[size++] = mask;
+    }
+    size += putVarint(record + size, zigzagEncode((Sint64) event->depth - (Sint64) last->depth));
+    size += putVarint(record + size, zigzagEncode((Sint64) (event->ticks - last->ticks)));
+    if (tag & TAG_FUNCTION) {
+        size += putVarint(record + size, event->function);
+    }
+    for (i = 0; i < args; ++i) {
+        size += putVarint(record + size, zigzagEncode(event->args[i] - last->args[i]));
+    }
+    for (i = 0; i < 4; ++i) {
+        if (mask & (1 << i)) {
+            size += putVarint(record + size, zigzagEncode(rect_delta[i]));
+        }
+    }
+    if (mask & MASK_ADDRESS) {
+        size += putVarint(record + size, zigzagEncode((Sint64) (event->address - last->address)));
+    }
+    if (mask & MASK_STACK) {
+        size += putVarint(record + size, zigzagEncode((Sint64) (event->stack - last->stack)));
+    }
+
+    return size;
+}
+
+
+int traceWriterWrite(TraceWriter* writer, const StackEvent* event)
+{
+    Uint8  record[TRACE_RECORD_MAX_BYTES];
+    size_t size = traceEncode(record, event, &writer->last);
+
+    if (fwrite(record, size, 1, writer->file) != 1) {
+        writer->failed = 1;
+        return -1;
+    }
+
+    writer->last = *event;
+    ++writer->count;
+    if (writer->max_depth < event->depth) {
+        writer->max_depth = event->depth;
+    }
+
+    return 0;
+}
+
+
+int traceWriterClose(TraceWriter* writer)
+{
+    Uint8 header[TRACE_FILE_HEADER_SIZE];
+
+    if (!writer->file) {
+        return -1;
+    }
+
+    // Now that the recording is complete, the real header can be written.
+    makeHeader(header, writer->max_depth, writer->count);
+    if (fseek(writer->file, 0, SEEK_SET) != 0 || fwrite(header, sizeof(header), 1, writer->file) != 1) {
+        writer->failed = 1;
+    }
+    if (fclose(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    writer->file = NULL;
+
+    return writer->failed ? -1 : 0;
+}
+
+
+int traceReaderOpen(TraceReader* reader, const char* path)
+{
+    struct stat info;
+    void*       data;
+    int         fd;
+
+    memset(reader, 0, sizeof(*reader));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &info) != 0 || info.st_size < TRACE_FILE_HEADER_SIZE) {
+        close(fd);
+        return -1;
+    }
+
+    // The mapping keeps the file open by itself.
+    data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+
+    reader->data = (const Uint8*) data;
+    reader->size = (size_t) info.st_size;
+
+    if (memcmp(reader->data, TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC)) != 0 ||
+        getLittleEndian(reader->data + 8, 4) < TRACE_FILE_VERSION_MIN ||
+        getLittleEndian(reader->data + 8, 4) > TRACE_FILE_VERSION) {
+        traceReaderClose(reader);
+        return -1;
+    }
+
+    reader->max_depth = (Uint32) getLittleEndian(reader->data + 12, 4);
+    reader->count     = getLittleEndian(reader->data + 16, 8);
+    reader->offset    = TRACE_FILE_HEADER_SIZE;
+    reader->released  = 0;
+
+    // The records are read from the front to the back, so the kernel can read ahead.
+    madvise((void*) reader->data, reader->size, MADV_SEQUENTIAL);
+
+    return 0;
+}
+
+
+int traceDecode(const Uint8* data, size_t size, size_t* offset, StackEvent* last)
+{
+    Uint8  tag;
+    Uint8  mask = 0;
+    Uint64 value;
+    int    color;
+    int    args;
+    int    i;
+
+    if (*offset >= size) {
+        return 0;
+    }
+
+    tag  = data[(*offset)++];
+    args = (tag >> TAG_ARGS_SHIFT) & TAG_ARGS_MASK;
+    if (tag & TAG_MASK) {
+        if (*offset >= size) {
+            return 0;
+        }
+        mask = data[(*offset)++];
+    }
+
+    color = ((tag >> TAG_COLOR_SHIFT) & TAG_COLOR_MASK) | ((mask & MASK_COLOR_HIGH) ? TAG_COLOR_MASK + 1 : 0);
+    if (color >= TAG_COLOR_COUNT) {
+        return 0;
+    }
+    last->type  = tag & TAG_TYPE_MASK;
+    last->color = TAG_COLORS[color];
+
+    if (!getVarint(data, size, offset, &value)) {
+        return 0;
+    }
+    last->depth = (Uint32) ((Sint64) last->depth + zigzagDecode(value));
+
+    if (!getVarint(data, size, offset, &value)) {
+        return 0;
+    }
+    last->ticks += (Uint64) zigzagDecode(value);
+
+    if (tag & TAG_FUNCTION) {
+        if (!getVarint(data, size, offset, &value)) {
+            return 0;
+        }
+        last->function = (Uint16) value;
+    }
+
+    for (i = 0; i < args; ++i) {
+        if (!getVarint(data, size, offset, &value)) {
+            return 0;
+        }
+        last->args[i] += zigzagDecode(value);
+    }
+
+    for (i = 0; i < 4; ++i) {
+        if (mask & (1 << i)) {
+            if (!getVarint(data, size, offset, &value)) {
+                return 0;
+            }
+            switch (i) {
+            case 0:
+                last->rect.x += (int) zigzagDecode(value);
+                break;
+            case 1:
+                last->rect.y += (int) zigzagDecode(value);
+                break;
+            case 2:
+                last->rect.w += (int) zigzagDecode(value);
+                break;
+            default:
+                last->rect.h += (int) zigzagDecode(value);
+                break;
+            }
+        }
+    }
+
+    if (mask & MASK_ADDRESS) {
+        if (!getVarint(data, size, offset, &value)) {
+            return 0;
+        }
+        last->address += (Uint64) zigzagDecode(value);
+    }
+    if (mask & MASK_STACK) {
+        if (!getVarint(data, size, offset, &value)) {
+            return 0;
+        }
+        last->stack += (Uint64) zigzagDecode(value);
+    }
+
+    return 1;
+}
+
+
+int traceReaderNext(TraceReader* reader, StackEvent* event)
+{
+    if (!traceDecode(reader->data, reader->size, &reader->offset, &reader->last)) {
+        return 0;
+    }
+
+    *event = reader->last;
+
+    // Drop the pages that were already played back, so that the memory used stays
+    // bounded however long the trace is. The pages are clean, so nothing is lost.
+    if (reader->offset - reader->released >= 2 * RELEASE_CHUNK_BYTES) {
+        size_t page  = (size_t) sysconf(_SC_PAGESIZE);
+        size_t until = (reader->offset - RELEASE_CHUNK_BYTES) / page * page;
+
+        if (until > reader->released) {
+            madvise((void*) (reader->data + reader->released), until - reader->released, MADV_DONTNEED);
+            reader->released = until;
+        }
+    }
+
+    return 1;
+}
+
+
+void traceReaderSeek(TraceReader* reader, size_t offset, const StackEvent* last)
+{
+    size_t page  = (size_t) sysconf(_SC_PAGESIZE);
+    size_t start = offset / page * page;
+
+    // The pages read since the last release are not needed any more either.
+    if (reader->offset > reader->released) {
+        size_t until = (reader->offset + page - 1) / page * page;
+
+        if (until > reader->size) {
+            until = reader->size;
+        }
+        madvise((void*) (reader->data + reader->released), until - reader->released, MADV_DONTNEED);
+    }
+
+    reader->offset   = offset;
+    reader->released = start;
+    reader->last     = *last;
+}
+
+
+void traceReaderClose(TraceReader* reader)
+{
+    if (reader->data) {
+        munmap((void*) reader->data, reader->size);
+    }
+    reader->data = NULL;
+    reader->size = 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file    recursion_visualized_tracefile.h
+ * @author  Konstantin Rebrov
+ * @version 10/16/2026
+ *
+ * Recursion Visualized Project
+ *
+ * @section DESCRIPTION
+ *
+ * This project is a program to demonstrate recursion in a graphical way for education purposes.
+ *
+ * This file contains the declarations of the trace file, which records the push/pop records
+ * of a run to disk, so that the animation can be replayed later without running the recursion again.
+ *
+ * A trace file starts with a 24 byte header, in little-endian byte order:
+ *   char   magic[8]   "RVTRACE" followed by a NUL byte
+ *   Uint32 version    TRACE_FILE_VERSION
+ *   Uint32 max_depth  the deepest the runtime stack got, or 0 if the recording was cut short
+ *   Uint64 count      the number of records, or 0 if the recording was cut short
+ *
+ * After the header come the records. Each record is stored as the difference from the one
+ * before it, so most of its fields take no room at all, and the rest take a byte or two:
+ *   Uint8  tag        bits 0-1: the type, bits 2-3: the low bits of the color index,
+ *                     bit 4: the function changed, bits 5-6: how many argument deltas follow,
+ *                     bit 7: a mask of the other changed fields follows
+ *   Uint8  mask       only if bit 7 of the tag is set: bits 0-3 set if field i of x, y, w, h changed,
+ *                     bit 4 if the stack frame address changed, bit 5 if the stack use changed,
+ *                     bit 6 the high bit of the color index
+ *   varint depth      the change in depth, zigzag encoded
+ *   varint ticks      the change in the timestamp, zigzag encoded
+ *   varint function   only if bit 4 of the tag is set
+ *   varint args[]     the changes in the leading arguments, zigzag encoded; the rest did not change
+ *   varint rect[]     the changes in the rectangle fields listed in the mask, zigzag encoded
+ *   varint address    only if bit 4 of the mask is set: the change in the address, zigzag encoded
+ *   varint stack      only if bit 5 of the mask is set: the change in the stack use, zigzag encoded
+ *
+ * The color index is 0 for no color, then LIME 1, PINK 2, CYAN 3 and GOLD 4, so only the rare GOLD
+ * of a stolen task needs the mask byte.
+ *
+ * A varint stores 7 bits per byte, least significant first, with the high bit set on every byte
+ * but the last. Zigzag encoding maps small negative numbers to small positive ones:
+ * 0, -1, 1, -2, 2 become 0, 1, 2, 3, 4. A push or pop of bunny() takes about 11 bytes instead of 72.
+ *
+ * Version 1 trace files, which have no stack frame addresses, and version 2 ones, whose colors
+ * only go up to CYAN, can still be replayed. Newer versions are rejected.
+ *
+ * The reader memory-maps the file and decodes it as it goes, so opening even a trace
+ * of a hundred million records takes no time, and the records that were already played
+ * back are dropped from memory again. Memory mapping needs a POSIX system.
+ */
+
+#ifndef RECURSION_VISUALIZED_TRACEFILE_H
+#define RECURSION_VISUALIZED_TRACEFILE_H
+
+#include "SDL.h"     // Simple DirectMedia Layer API structures and functions
+#include <stdio.h>   // C standard input/output - for FILE
+#include <stddef.h>  // C standard definitions - for size_t
+
+#include "recursion_visualized_ring.h"  // StackEvent
+
+
+/* The version of the trace file format written by this program. */
+#define TRACE_FILE_VERSION 3
+
+/* The size of the header of a trace file, in bytes. */
+#define TRACE_FILE_HEADER_SIZE 24
+
+/* The longest a record can get: the tag, the mask, and 12 varints of at most 10 bytes each. */
+#define TRACE_RECORD_MAX_BYTES (2 + 12 * 10)
+
+
+/**
+ * A trace file being recorded.
+ *
+ * @field FILE* file - The open file.
+ *
+ * @field StackEvent last - The record written before, which the next one is stored relative to.
+ *
+ * @field Uint64 count - How many records have been written.
+ *
+ * @field Uint32 max_depth - The deepest record written.
+ *
+ * @field int failed - Nonzero if writing to the file failed.
+ */
+typedef struct TraceWriter {
+    FILE*      file;
+    StackEvent last;
+    Uint64     count;
+    Uint32     max_depth;
+    int        failed;
+} TraceWriter;
+
+
+/**
+ * A trace file being replayed.
+ *
+ * @field const Uint8* data - The memory-mapped contents of the file.
+ *
+ * @field size_t size - The size of the file in bytes.
+ *
+ * @field size_t offset - Where the next record starts.
+ *
+ * @field size_t released - Everything before this offset was dropped from memory again.
+ *
+ * @field StackEvent last - The record read before, which the next one is stored relative to.
+ *
+ * @field Uint32 max_depth - The deepest record, according to the header.
+ *
+ * @field Uint64 count - The number of records, according to the header.
+ */
+typedef struct TraceReader {
+    const Uint8* data;
+    size_t       size;
+    size_t       offset;
+    size_t       released;
+    StackEvent   last;
+    Uint32       max_depth;
+    Uint64       count;
+} TraceReader;
+
+
+/**
+ * This function creates a trace file and writes a placeholder header into it.
+ *
+ * @param TraceWriter* writer - A pointer to the writer to initialize.
+ *
+ * @param const char* path - The path of the file to create. An existing file is overwritten.
+ *
+ * @return int - 0 on success, -1 if the file could not be created.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceWriterOpen(TraceWriter* writer, const char* path);
+
+
+/**
+ * This function appends one record to a trace file.
+ *
+ * @param TraceWriter* writer - A pointer to the writer.
+ *
+ * @param const StackEvent* event - The record to append.
+ *
+ * @return int - 0 on success, -1 if writing failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceWriterWrite(TraceWriter* writer, const StackEvent* event);
+
+
+/**
+ * This function fills in the real header of a trace file and closes it.
+ *
+ * @param TraceWriter* writer - A pointer to the writer.
+ *
+ * @return int - 0 on success, -1 if anything written to the file failed.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceWriterClose(TraceWriter* writer);
+
+
+/**
+ * This function encodes one record the way it is stored in a trace file,
+ * as the difference from the record before it.
+ *
+ * @param Uint8* record - Receives the encoded record. There must be room for TRACE_RECORD_MAX_BYTES.
+ *
+ * @param const StackEvent* event - The record to encode.
+ *
+ * @param const StackEvent* last - The record before it, or a zeroed one if there is none.
+ *
+ * @return size_t - The size of the encoded record in bytes.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+size_t traceEncode(Uint8* record, const StackEvent* event, const StackEvent* last);
+
+
+/**
+ * This function decodes one record which was encoded by traceEncode().
+ *
+ * @param const Uint8* data, size_t size - The buffer of records, and its size in bytes.
+ *
+ * @param size_t* offset - Where the record starts. It is moved past the record.
+ *
+ * @param StackEvent* last - The record before it, which receives the decoded record.
+ *
+ * @return int - 1 if a record was decoded, 0 at the end of the buffer, or if the record is damaged.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceDecode(const Uint8* data, size_t size, size_t* offset, StackEvent* last);
+
+
+/**
+ * This function memory-maps a trace file and checks its header.
+ * Nothing but the header is read, so it returns immediately however large the file is.
+ *
+ * @param TraceReader* reader - A pointer to the reader to initialize.
+ *
+ * @param const char* path - The path of the file to open.
+ *
+ * @return int - 0 on success, -1 if the file could not be mapped or is not a trace file.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceReaderOpen(TraceReader* reader, const char* path);
+
+
+/**
+ * This function decodes the next record of a trace file.
+ *
+ * @param TraceReader* reader - A pointer to the reader.
+ *
+ * @param StackEvent* event - Receives the record.
+ *
+ * @return int - 1 if a record was read, 0 at the end of the file, or if the rest of it is damaged.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+int traceReaderNext(TraceReader* reader, StackEvent* event);
+
+
+/**
+ * This function moves a reader to another record of the same trace file.
+ * Since every record is stored relative to the one before it, the record
+ * before the new position has to be given as well.
+ *
+ * @param TraceReader* reader - A pointer to the reader.
+ *
+ * @param size_t offset - Where the next record to read starts.
+ *
+ * @param const StackEvent* last - The record just before offset, or a zeroed one if there is none.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void traceReaderSeek(TraceReader* reader, size_t offset, const StackEvent* last);
+
+
+/**
+ * This function unmaps a trace file.
+ *
+ * @param TraceReader* reader - A pointer to the reader.
+ *
+ * The preprocessor directive is used if we would want to mix C and C++ code together.
+ * extern "C" tells the C++ compiler to not mangle the names of functions.
+ */
+#ifdef __cplusplus
+  extern "C"
+#endif
+void traceReaderClose(TraceReader* reader);
+
+#endif /* RECURSION_VISUALIZED_TRACEFILE_H */